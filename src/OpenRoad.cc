@@ -235,6 +235,7 @@ void OpenRoad::readLef(const char* filename,
                        bool make_library)
 {
   odb::lefin lef_reader(db_, logger_, false);
+  lef_reader.setThreads(threads_);
   if (make_tech && make_library) {
     lef_reader.createTechAndLib(tech_name, lib_name, filename);
   } else if (make_tech) {
@@ -279,6 +280,7 @@ void OpenRoad::readDef(const char* filename,
   if (continue_on_errors) {
     def_reader.continueOnErrors();
   }
+  def_reader.setThreads(threads_);
   if (child) {
     auto parent = db_->getChip()->getBlock();
     def_reader.createBlock(parent, search_libs, filename, tech);
@@ -324,6 +326,7 @@ void OpenRoad::writeDef(const char* filename, const string& version)
       }
       odb::defout def_writer(logger_);
       def_writer.setVersion(stringToDefVersion(version));
+      def_writer.setThreads(threads_);
       def_writer.writeBlock(block, filename);
       if (hierarchy_set) {
         sta->getDbNetwork()->setHierarchy();
@@ -467,8 +470,8 @@ void OpenRoad::readVerilog(const char* filename)
 void OpenRoad::linkDesign(const char* design_name, bool hierarchy)
 
 {
-  bool success
-      = dbLinkDesign(design_name, verilog_network_, db_, logger_, hierarchy);
+  bool success = dbLinkDesign(
+      design_name, verilog_network_, db_, logger_, hierarchy, threads_);
 
   if (success) {
     delete verilog_reader_;
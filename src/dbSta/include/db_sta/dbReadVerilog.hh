@@ -58,11 +58,13 @@ void deleteDbVerilogNetwork(dbVerilogNetwork* verilog_network);
 // Read a hierarchical Verilog netlist into a OpenSTA concrete network
 // objects. The hierarchical network is elaborated/flattened by the
 // link_design command and OpenDB objects are created from the flattened
-// network.
+// network. num_threads is used to prepare the nets in parallel; the
+// result does not depend on it.
 bool dbLinkDesign(const char* top_cell_name,
                   dbVerilogNetwork* verilog_network,
                   dbDatabase* db,
                   utl::Logger* logger,
-                  bool hierarchy);
+                  bool hierarchy,
+                  int num_threads = 1);
 
 }  // namespace ord
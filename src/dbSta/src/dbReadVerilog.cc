@@ -5,6 +5,7 @@
 
 #include <odb/dbSet.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <fstream>
 #include <map>
@@ -66,7 +67,6 @@ using sta::NetTermIterator;
 using sta::Network;
 using sta::Pin;
 using sta::PinPathNameLess;
-using sta::PinSeq;
 using sta::Port;
 using sta::PortDirection;
 using sta::Term;
@@ -147,7 +147,8 @@ class Verilog2db
   Verilog2db(Network* verilog_network,
              dbDatabase* db,
              Logger* logger,
-             bool hierarchy);
+             bool hierarchy,
+             int num_threads);
   void makeBlock();
   void makeUnusedBlock(const char* name);
   void makeDbNetlist();
@@ -163,6 +164,15 @@ class Verilog2db
     std::string file_name;
     int line_number;
   };
+  // A net of the sta network with what is needed to create it in odb.
+  struct NetRecord
+  {
+    const Net* net;
+    std::string name;
+    // Connected pins, sorted by path name before the net is created, each
+    // with the path name of its instance for leaf pins.
+    std::vector<std::pair<const Pin*, std::string>> pins;
+  };
   using InstPair = std::pair<const Instance*, dbModInst*>;
   using InstPairs = std::vector<InstPair>;
   void makeDbModule(Instance* inst, dbModule* parent, InstPairs& inst_pairs);
@@ -178,6 +188,9 @@ class Verilog2db
                dbModITerm*& mod_iterm);
   void recordBusPortsOrder();
   void makeDbNets(const Instance* inst);
+  void collectNets(const Instance* inst, std::vector<const Net*>& nets);
+  void makeNetRecord(const Net* net, NetRecord& record);
+  void makeDbNet(const NetRecord& record);
 
   void makeVModNets(const Instance* inst, dbModInst* mod_inst);
   void makeVModNets(InstPairs& inst_pairs);
@@ -201,6 +214,7 @@ class Verilog2db
   // creating iterms; as iterms can't be added to a dont_touch inst
   std::vector<dbInst*> dont_touch_insts;
   bool hierarchy_ = false;
+  int num_threads_ = 1;
   static const std::regex line_info_re;
   std::vector<ConcreteCell*> unused_cells_;
 };
@@ -212,7 +226,8 @@ bool dbLinkDesign(const char* top_cell_name,
                   dbVerilogNetwork* verilog_network,
                   dbDatabase* db,
                   Logger* logger,
-                  bool hierarchy)
+                  bool hierarchy,
+                  int num_threads)
 {
   debugPrint(
       logger, utl::ODB, "dbReadVerilog", 1, "dbLinkDesign {}", top_cell_name);
@@ -220,7 +235,7 @@ bool dbLinkDesign(const char* top_cell_name,
   bool success = verilog_network->linkNetwork(
       top_cell_name, link_make_black_boxes, verilog_network->report());
   if (success) {
-    Verilog2db v2db(verilog_network, db, logger, hierarchy);
+    Verilog2db v2db(verilog_network, db, logger, hierarchy, num_threads);
     v2db.makeBlock();
     v2db.makeDbNetlist();
     // Link unused modules in case if we want to swap to such modules later
@@ -234,8 +249,13 @@ bool dbLinkDesign(const char* top_cell_name,
 Verilog2db::Verilog2db(Network* network,
                        dbDatabase* db,
                        Logger* logger,
-                       bool hierarchy)
-    : network_(network), db_(db), logger_(logger), hierarchy_(hierarchy)
+                       bool hierarchy,
+                       int num_threads)
+    : network_(network),
+      db_(db),
+      logger_(logger),
+      hierarchy_(hierarchy),
+      num_threads_(std::max(num_threads, 1))
 {
 }
 
@@ -646,6 +666,43 @@ dbIoType Verilog2db::staToDb(PortDirection* dir)
 }
 
 void Verilog2db::makeDbNets(const Instance* inst)
+{
+  std::vector<const Net*> nets;
+  collectNets(inst, nets);
+
+  // The nets are created in order to keep the result independent of the
+  // thread count. Working in chunks bounds the memory held by the records.
+  const int count = nets.size();
+  const int chunk_size = 1 << 16;
+  std::vector<NetRecord> records(std::min(count, chunk_size));
+  const PinPathNameLess pin_less(network_);
+  for (int chunk_start = 0; chunk_start < count; chunk_start += chunk_size) {
+    const int chunk_end = std::min(chunk_start + chunk_size, count);
+    // pathName() formats into the sta temporary string buffers and the
+    // connected pin iterator walks the hierarchy with its own allocations,
+    // so the names and pins are collected on this thread.
+    for (int i = chunk_start; i < chunk_end; i++) {
+      makeNetRecord(nets[i], records[i - chunk_start]);
+    }
+    // Sort connected pins for regression stability. PinPathNameLess only
+    // follows the instance parent and port pointers and compares the names
+    // stored in the network (Network::pathNameCmp), which is safe from
+    // several threads while nothing edits the network.
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic, 256)
+    for (int i = chunk_start; i < chunk_end; i++) {
+      auto& pins = records[i - chunk_start].pins;
+      std::sort(pins.begin(), pins.end(), [&](const auto& a, const auto& b) {
+        return pin_less(a.first, b.first);
+      });
+    }
+    for (int i = chunk_start; i < chunk_end; i++) {
+      makeDbNet(records[i - chunk_start]);
+    }
+  }
+}
+
+void Verilog2db::collectNets(const Instance* inst,
+                             std::vector<const Net*>& nets)
 {
   bool is_top = (inst == network_->topInstance());
   std::unique_ptr<NetIterator> net_iter{network_->netIterator(inst)};
@@ -656,75 +713,86 @@ void Verilog2db::makeDbNets(const Instance* inst)
     if (!is_top && hasTerminals(net)) {
       continue;
     }
+    nets.push_back(net);
+  }
 
-    const char* net_name = network_->pathName(net);
-    dbNet* db_net = dbNet::create(block_, net_name);
-    debugPrint(logger_,
-               utl::ODB,
-               "dbReadVerilog",
-               2,
-               "makeDbNets created net {}",
-               db_net->getName());
-    if (network_->isPower(net)) {
-      db_net->setSigType(odb::dbSigType::POWER);
-    }
-    if (network_->isGround(net)) {
-      db_net->setSigType(odb::dbSigType::GROUND);
-    }
+  std::unique_ptr<InstanceChildIterator> child_iter{
+      network_->childIterator(inst)};
+  while (child_iter->hasNext()) {
+    const Instance* child = child_iter->next();
+    collectNets(child, nets);
+  }
+}
 
-    // Sort connected pins for regression stability.
-    PinSeq net_pins;
-    std::unique_ptr<NetConnectedPinIterator> pin_iter{
-        network_->connectedPinIterator(net)};
-    while (pin_iter->hasNext()) {
-      const Pin* pin = pin_iter->next();
-      net_pins.push_back(pin);
+void Verilog2db::makeNetRecord(const Net* net, NetRecord& record)
+{
+  record.net = net;
+  record.name = network_->pathName(net);
+
+  record.pins.clear();
+  std::unique_ptr<NetConnectedPinIterator> pin_iter{
+      network_->connectedPinIterator(net)};
+  while (pin_iter->hasNext()) {
+    const Pin* pin = pin_iter->next();
+    if (!network_->isTopLevelPort(pin) && network_->isLeaf(pin)) {
+      record.pins.emplace_back(pin,
+                               network_->pathName(network_->instance(pin)));
+    } else {
+      record.pins.emplace_back(pin, std::string());
     }
-    sort(net_pins, PinPathNameLess(network_));
+  }
+}
+
+void Verilog2db::makeDbNet(const NetRecord& record)
+{
+  const Net* net = record.net;
+  dbNet* db_net = dbNet::create(block_, record.name.c_str());
+  debugPrint(logger_,
+             utl::ODB,
+             "dbReadVerilog",
+             2,
+             "makeDbNets created net {}",
+             db_net->getName());
+  if (network_->isPower(net)) {
+    db_net->setSigType(odb::dbSigType::POWER);
+  }
+  if (network_->isGround(net)) {
+    db_net->setSigType(odb::dbSigType::GROUND);
+  }
 
-    for (const Pin* pin : net_pins) {
-      if (network_->isTopLevelPort(pin)) {
-        const char* port_name = network_->portName(pin);
-        if (block_->findBTerm(port_name) == nullptr) {
-          dbBTerm* bterm = dbBTerm::create(db_net, port_name);
+  for (const auto& [pin, inst_name] : record.pins) {
+    if (network_->isTopLevelPort(pin)) {
+      const char* port_name = network_->portName(pin);
+      if (block_->findBTerm(port_name) == nullptr) {
+        dbBTerm* bterm = dbBTerm::create(db_net, port_name);
+        debugPrint(logger_,
+                   utl::ODB,
+                   "dbReadVerilog",
+                   2,
+                   "makeDbNets created bterm {}",
+                   bterm->getName());
+        dbIoType io_type = staToDb(network_->direction(pin));
+        bterm->setIoType(io_type);
+      }
+    } else if (network_->isLeaf(pin)) {
+      const char* port_name = network_->portName(pin);
+      dbInst* db_inst = block_->findInst(inst_name.c_str());
+      if (db_inst) {
+        dbMaster* master = db_inst->getMaster();
+        dbMTerm* mterm = master->findMTerm(block_, port_name);
+        if (mterm) {
+          db_inst->getITerm(mterm)->connect(db_net);
           debugPrint(logger_,
                      utl::ODB,
                      "dbReadVerilog",
                      2,
-                     "makeDbNets created bterm {}",
-                     bterm->getName());
-          dbIoType io_type = staToDb(network_->direction(pin));
-          bterm->setIoType(io_type);
-        }
-      } else if (network_->isLeaf(pin)) {
-        const char* port_name = network_->portName(pin);
-        Instance* inst = network_->instance(pin);
-        const char* inst_name = network_->pathName(inst);
-        dbInst* db_inst = block_->findInst(inst_name);
-        if (db_inst) {
-          dbMaster* master = db_inst->getMaster();
-          dbMTerm* mterm = master->findMTerm(block_, port_name);
-          if (mterm) {
-            db_inst->getITerm(mterm)->connect(db_net);
-            debugPrint(logger_,
-                       utl::ODB,
-                       "dbReadVerilog",
-                       2,
-                       "makeDbNets connected mterm {} to net {}",
-                       mterm->getName(),
-                       db_net->getName());
-          }
+                     "makeDbNets connected mterm {} to net {}",
+                     mterm->getName(),
+                     db_net->getName());
         }
       }
     }
   }
-
-  std::unique_ptr<InstanceChildIterator> child_iter{
-      network_->childIterator(inst)};
-  while (child_iter->hasNext()) {
-    const Instance* child = child_iter->next();
-    makeDbNets(child);
-  }
 }
 
 void Verilog2db::makeVModNets(InstPairs& inst_pairs)
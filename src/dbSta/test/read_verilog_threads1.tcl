@@ -0,0 +1,56 @@
+# link_design with set_thread_count 1 connects every pin of a buffer tree
+source "helpers.tcl"
+
+# u<i> drives net n<i> loading u<3i+1>..u<3i+3>.
+set inst_count 9000
+set verilog_file [make_result_file "read_verilog_threads1.v"]
+set stream [open $verilog_file w]
+puts $stream "module top (in, out);"
+puts $stream "  input in;"
+puts $stream "  output out;"
+for { set i 0 } { 3 * $i + 1 < $inst_count } { incr i } {
+  puts $stream "  wire n$i;"
+}
+for { set i 0 } { $i < $inst_count } { incr i } {
+  if { $i == 0 } {
+    set in "in"
+  } else {
+    set in "n[expr { ($i - 1) / 3 }]"
+  }
+  if { $i == $inst_count - 1 } {
+    puts $stream "  snl_bufx1 u$i (.A($in), .Z(out));"
+  } elseif { 3 * $i + 1 < $inst_count } {
+    puts $stream "  snl_bufx1 u$i (.A($in), .Z(n$i));"
+  } else {
+    puts $stream "  snl_bufx1 u$i (.A($in));"
+  }
+}
+puts $stream "endmodule"
+close $stream
+
+set_thread_count 1
+read_lef liberty1.lef
+read_liberty liberty1.lib
+read_verilog $verilog_file
+link_design top
+
+set block [ord::get_db_block]
+puts "insts: [llength [$block getInsts]] nets: [llength [$block getNets]]"
+
+set lines {}
+foreach net [$block getNets] {
+  set pins {}
+  foreach bterm [$net getBTerms] {
+    lappend pins "PIN/[$bterm getName]"
+  }
+  foreach iterm [$net getITerms] {
+    lappend pins "[[$iterm getInst] getName]/[[$iterm getMTerm] getName]"
+  }
+  lappend lines "[$net getName] [lsort $pins]"
+}
+set dump_file [make_result_file "read_verilog_threads1.dump"]
+set stream [open $dump_file w]
+puts $stream [join [lsort $lines] "\n"]
+close $stream
+
+diff_files $dump_file "read_verilog_threads.dumpok"
@@ -67,6 +67,7 @@ class dbTrackGrid;
 class dbObstruction;
 class dbBlockage;
 class dbWire;
+struct dbWireGeometry;
 class dbSWire;
 class dbSBox;
 class dbCapNode;
@@ -443,6 +444,32 @@ class dbDatabase : public dbObject
   ///
   static void undoEco(dbBlock* block);
 
+  ///
+  /// CHECKPOINTS - Incremental saves of the top block built on the eco
+  /// journal. beginCheckpoints writes the whole database to base_file and
+  /// starts journaling changes. writeCheckpoint appends the changes since
+  /// the previous checkpoint to base_file.journal, which is far cheaper
+  /// than rewriting the database. compactCheckpoints rewrites base_file
+  /// and empties the journal file.
+  ///
+  /// NOTE: Only the changes undoEco supports are journaled; any other
+  /// edit (wires, rows, blockages, ...) makes the next checkpoint rewrite
+  /// base_file. Ecos may be nested within checkpoints and are replayed,
+  /// undone or committed in the same order as they were in the session.
+  /// An eco undone right after it ends is left out of the journal.
+  ///
+  static void beginCheckpoints(dbBlock* block, const char* base_file);
+  static void writeCheckpoint(dbBlock* block);
+  static void compactCheckpoints(dbBlock* block);
+  static void endCheckpoints(dbBlock* block);
+
+  ///
+  /// Read base_file into db, replay the journal segments of base_file.journal
+  /// and resume checkpointing the top block, which is returned.
+  /// WARNING: This function destroys the data currently in the database.
+  ///
+  static dbBlock* readCheckpoint(dbDatabase* db, const char* base_file);
+
   ///
   /// links to utl::Logger
   ///
@@ -456,6 +483,8 @@ class dbDatabase : public dbObject
   ///
   /// Generates a report of memory usage.
   ///   Not perfectly byte accurate.  Intended for developers.
+  ///   Object tables also report the bytes held by their pages and
+  ///   their free slots.
   ///
   void report();
 
@@ -1083,6 +1112,14 @@ class dbBlock : public dbObject
   ///
   dbInst* findInst(const char* name);
 
+  ///
+  /// Enable or disable the name index used by the find methods of this
+  /// block (findInst, findNet, findITerm, findBTerm, findModule, ...) on
+  /// large tables. The index is disabled by default; once enabled it is
+  /// built on the first lookup. Disabling it frees its memory.
+  ///
+  void setNameIndexEnabled(bool enabled);
+
   ///
   /// Find a specific module in this block.
   /// Returns nullptr if the object was not found.
@@ -1516,6 +1553,14 @@ class dbBlock : public dbObject
   ///
   dbBlockSearch* getSearchDb();
 
+  ///
+  /// Get the routed wires of all nets decoded into per-layer arrays of
+  /// segments and vias tagged with net ids (see odb/dbWireGeometry.h).
+  /// The wires are decoded by num_threads threads and the result is
+  /// cached until a dbWire of this block changes.
+  ///
+  const dbWireGeometry& getWireGeometry(int num_threads = 1);
+
   ///
   /// destroy coupling caps of nets
   ///
@@ -1558,6 +1603,15 @@ class dbBlock : public dbObject
   ///
   void clear();
 
+  ///
+  /// Releases the empty pages of the object tables, including those
+  /// between live objects, and relinks their free lists so new objects
+  /// reuse the lowest ids.
+  /// Object ids are unchanged. Not allowed during an eco.
+  /// Returns the number of bytes released.
+  ///
+  uint64_t compactTables();
+
   ///
   /// get wire_updated nets
   ///
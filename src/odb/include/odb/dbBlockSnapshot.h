@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#pragma once
+
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace odb {
+
+class dbBlock;
+class dbBTerm;
+class dbInst;
+class dbITerm;
+class dbNet;
+
+///
+/// Concurrency contract of a dbBlock:
+///
+///   - Any number of threads may read a block concurrently as long as no
+///     thread modifies it. Reading includes dbSet iteration, getters and
+///     the find* lookups.
+///   - Modifications (create, destroy, setters, reading DEF, ...) require
+///     exclusive access to the block.
+///
+/// dbBlockSnapshot and dbBlockWriteLock make that contract explicit.
+/// Analysis tools take a snapshot and query it from their worker
+/// threads; code that modifies the block while snapshots may exist
+/// takes a dbBlockWriteLock, which waits until all snapshots are
+/// released and blocks new ones until it is released. The locks are
+/// advisory: odb does not check them on every modification.
+///
+
+///
+/// Read-only view of a block that can be shared by threads.
+///
+/// The object lists are captured once, on first use, and do not change
+/// while the snapshot exists. Lookups go to the block's name tables and
+/// do not lock once their index is built.
+///
+class dbBlockSnapshot
+{
+ public:
+  explicit dbBlockSnapshot(dbBlock* block);
+
+  dbBlockSnapshot(const dbBlockSnapshot&) = delete;
+  dbBlockSnapshot& operator=(const dbBlockSnapshot&) = delete;
+
+  dbBlock* getBlock() const { return block_; }
+
+  const std::vector<dbInst*>& getInsts() const;
+  const std::vector<dbNet*>& getNets() const;
+  const std::vector<dbBTerm*>& getBTerms() const;
+
+  dbInst* findInst(const char* name) const;
+  dbNet* findNet(const char* name) const;
+  dbITerm* findITerm(const char* name) const;
+  dbBTerm* findBTerm(const char* name) const;
+
+ private:
+  dbBlock* block_;
+  std::shared_lock<std::shared_mutex> lock_;
+
+  mutable std::once_flag insts_once_;
+  mutable std::once_flag nets_once_;
+  mutable std::once_flag bterms_once_;
+  mutable std::vector<dbInst*> insts_;
+  mutable std::vector<dbNet*> nets_;
+  mutable std::vector<dbBTerm*> bterms_;
+};
+
+///
+/// Exclusive access to a block for a single writer. Waits for the
+/// snapshots of the block to be released.
+///
+class dbBlockWriteLock
+{
+ public:
+  explicit dbBlockWriteLock(dbBlock* block);
+
+ private:
+  std::unique_lock<std::shared_mutex> lock_;
+};
+
+}  // namespace odb
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "odb/odb.h"
+
+namespace odb {
+
+class dbObject;
+class dbTechLayer;
+
+///
+/// Rectangles in structure-of-arrays form. Element i is the rectangle
+/// (xlo[i], ylo[i]) - (xhi[i], yhi[i]) of the net with id net_ids[i].
+///
+struct dbWireRects
+{
+  std::vector<int> xlo;
+  std::vector<int> ylo;
+  std::vector<int> xhi;
+  std::vector<int> yhi;
+  std::vector<uint> net_ids;
+
+  size_t size() const { return net_ids.size(); }
+};
+
+///
+/// Vias in structure-of-arrays form. The rectangles are the via bounding
+/// boxes and vias[i] is the dbTechVia or dbVia placed.
+///
+struct dbWireVias : public dbWireRects
+{
+  std::vector<dbObject*> vias;
+};
+
+///
+/// The wire shapes of one layer. Vias are stored with their bottom
+/// layer.
+///
+struct dbWireLayerGeometry
+{
+  dbTechLayer* layer = nullptr;
+  dbWireRects segments;
+  dbWireVias vias;
+};
+
+///
+/// The decoded dbWires of a block, indexed by dbTechLayer::getNumber().
+/// Shapes are ordered by net id and then by their order in the wire.
+/// See dbBlock::getWireGeometry.
+///
+struct dbWireGeometry
+{
+  std::vector<dbWireLayerGeometry> layers;
+};
+
+}  // namespace odb
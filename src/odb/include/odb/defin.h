@@ -45,6 +45,8 @@ class defin
   void skipBlockWires();
   void skipFillWires();
   void continueOnErrors();
+  // Create the COMPONENTS on a separate thread while parsing.
+  void setThreads(int num_threads);
   void namesAreDBIDs();
   void setAssemblyMode();
   void useBlockName(const char* name);
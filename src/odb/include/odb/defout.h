@@ -36,7 +36,10 @@ class defout
   void setUseMasterIds(bool value);
   void selectNet(dbNet* net);
   void setVersion(Version v);  // default is 5.8
+  // Format COMPONENTS, SPECIALNETS and NETS on num_threads threads.
+  void setThreads(int num_threads);
 
+  // def_file ending in .gz is written gzip compressed.
   bool writeBlock(dbBlock* block, const char* def_file);
 };
 
@@ -57,27 +57,19 @@ class GDSReader
   void checkRData(DataType eType, size_t eSize);
 
   /**
-   * Reads a real8 from _file
+   * Makes sure the next size bytes of _file are in _buffer
    *
-   * NOTE: real8 is not the same as double. This conversion is not lossless.
-   * @return The real8 read from _file, converted to a double
+   * @return false if the file ends first
    */
-  double readReal8();
-
-  /** Reads an int32 from _file */
-  int32_t readInt32();
-
-  /** Reads an int16 from _file */
-  int16_t readInt16();
-
-  /** Reads an int8 from _file */
-  int8_t readInt8();
+  bool fillBuffer(size_t size);
 
   /**
    * Reads a record from _file and stores it in _r
    *
    * Reads the record type, data type, and length from _file.
    * The data is then read into the appropriate data vector.
+   * The file is read in large blocks, so each record is decoded from
+   * memory.
    *
    * @return true if a record was read, false if the end of the file was reached
    * @throws std::runtime_error if the record is corrupted
@@ -135,6 +127,10 @@ class GDSReader
 
   /** Current filestream */
   std::ifstream _file;
+  /** Block of _file being decoded, valid in [_buffer_begin, _buffer_end) */
+  std::vector<char> _buffer;
+  size_t _buffer_begin = 0;
+  size_t _buffer_end = 0;
   /** Most recently read record */
   record_t _r;
   /** Current ODB Database */
@@ -148,6 +144,9 @@ class GDSReader
   std::set<dbGDSStructure*> _defined;
 
   utl::Logger* _logger{nullptr};
+
+  /** Read block size, larger than the largest record */
+  static constexpr size_t _buffer_size = 1 << 20;
 };
 
 }  // namespace odb::gds
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <fstream>
 #include <string>
@@ -28,6 +29,9 @@ class GDSWriter
    */
   void write_gds(dbGDSLib* lib, const std::string& filename);
 
+  /** Sets the number of threads used to encode structures */
+  void setThreads(int num_threads);
+
  private:
   /**
    * Calculates and sets the size of a record
@@ -36,27 +40,33 @@ class GDSWriter
    */
   void calcRecSize(record_t& r);
 
+  /** Writes the output buffer to _file */
+  void flushBuffer();
+
+  /** Appends raw bytes to the output buffer */
+  void writeBytes(const void* data, size_t size);
+
   /**
-   * Writes a record to the output file stream
+   * Writes a record to the output buffer
    *
    * @param r The record to write
    */
   void writeRecord(record_t& r);
 
   /**
-   * Writes a real8 to _file
+   * Writes a real8 to the output buffer
    *
    * NOTE: real8 is not the same as double. This conversion is not lossless.
    */
   void writeReal8(double real);
 
-  /** Writes an int32 to _file */
+  /** Writes an int32 to the output buffer */
   void writeInt32(int32_t i);
 
-  /** Writes an int16 to _file */
+  /** Writes an int16 to the output buffer */
   void writeInt16(int16_t i);
 
-  /** Writes an int8 to _file */
+  /** Writes an int8 to the output buffer */
   void writeInt8(int8_t i);
 
   /** Helper function to write layer record of a dbGDSElement to _file */
@@ -75,6 +85,14 @@ class GDSWriter
   /** Writes _lib to the _file */
   void writeLib();
 
+  /**
+   * Writes all structures of _lib to _file
+   *
+   * With more than one thread the structures are encoded in parallel into
+   * separate buffers, which are written in library order.
+   */
+  void writeStructs();
+
   /** Writes a dbGDSStructure to _file */
   void writeStruct(dbGDSStructure* str);
 
@@ -94,10 +112,18 @@ class GDSWriter
 
   /** Output filestream */
   std::ofstream _file;
+  /** Encoded records not yet written to _file */
+  std::vector<char> _buffer;
+  /** BGNLIB time, shared by all structures */
+  std::vector<int16_t> _timestamp;
+  int _num_threads{1};
   /** Current dbGDSLib object */
   dbGDSLib* _lib{nullptr};
 
   utl::Logger* _logger{nullptr};
+
+  /** Size at which the output buffer is written to _file */
+  static constexpr size_t _flush_size = 1 << 20;
 };
 
 }  // namespace odb::gds
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <utility>
@@ -48,6 +49,7 @@ class dbMaster;
 class dbDatabase;
 class dbTechLayer;
 class dbSite;
+class lefinGeometry;
 
 class lefinReader
 {
@@ -74,7 +76,11 @@ class lefinReader
   bool _override_lef_dbu;
   bool _master_modified;
   bool _ignore_non_routing_layers;
+  int _num_threads;
   std::vector<std::pair<odb::dbObject*, std::string>> _incomplete_props;
+  // Macro geometries read but not yet created, in LEF order.
+  std::vector<std::unique_ptr<lefinGeometry>> _pending_geoms;
+  static constexpr size_t _max_pending_geoms = 1024;
 
   void init();
   void setDBUPerMicron(int dbu);
@@ -87,14 +93,8 @@ class lefinReader
   bool addGeoms(dbObject* object,
                 bool is_pin,
                 LefParser::lefiGeometries* geometry);
+  void createGeoms();
   void createLibrary();
-  void createPolygon(dbObject* object,
-                     bool is_pin,
-                     dbTechLayer* layer,
-                     LefParser::lefiGeomPolygon* p,
-                     int design_rule_width,
-                     double offset_x = 0.0,
-                     double offset_y = 0.0);
   dbSite* findSite(const char* name);
 
  public:
@@ -171,11 +171,14 @@ class lefinReader
   lefinReader(dbDatabase* db,
               utl::Logger* logger,
               bool ignore_non_routing_layers);
-  ~lefinReader() = default;
+  ~lefinReader();
 
   // Skip macro-obstructions in the lef file.
   void skipObstructions() { _skip_obstructions = true; }
 
+  // Expand macro geometries on this many threads.
+  void setThreads(int num_threads) { _num_threads = num_threads; }
+
   //
   // Override the LEF DBU-PER-MICRON unit.
   // This function only is only effective when creating a technolgy, because the
@@ -224,6 +227,9 @@ class lefin
   // convert distance value to db-units
   int dbdist(double value);
 
+  // Expand macro geometries on this many threads.
+  void setThreads(int num_threads);
+
   // Create a technology from the tech-data of this LEF file.
   dbTech* createTech(const char* name, const char* lef_file);
 
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <cerrno>
 #include <cmath>
+#include <cstring>
 #include <fstream>
 #include <map>
 #include <memory>
@@ -32,6 +33,7 @@
 #include "dbCCSegItr.h"
 #include "dbCapNode.h"
 #include "dbCapNodeItr.h"
+#include "dbCheckpointLog.h"
 #include "dbChip.h"
 #include "dbDatabase.h"
 #include "dbDft.h"
@@ -100,6 +102,7 @@
 #include "dbTrackGrid.h"
 #include "dbVia.h"
 #include "dbWire.h"
+#include "dbWireGeometryCache.h"
 #include "odb/db.h"
 #include "odb/dbBlockCallBackObj.h"
 #include "odb/dbExtControl.h"
@@ -401,9 +404,11 @@ _dbBlock::_dbBlock(_dbDatabase* db)
 
   _num_ext_dbs = 1;
   _searchDb = nullptr;
+  _wire_geometry_cache = nullptr;
   _extmi = nullptr;
   _journal = nullptr;
   _journal_pending = nullptr;
+  _checkpoint_log = nullptr;
 }
 
 _dbBlock::~_dbBlock()
@@ -489,6 +494,7 @@ _dbBlock::~_dbBlock()
   delete _prop_itr;
   delete _dft_tbl;
   delete _marker_categories_tbl;
+  delete _wire_geometry_cache;
 
   while (!_callbacks.empty()) {
     auto _cbitr = _callbacks.begin();
@@ -496,6 +502,7 @@ _dbBlock::~_dbBlock()
   }
   delete _journal;
   delete _journal_pending;
+  delete _checkpoint_log;
 }
 
 void dbBlock::clear()
@@ -1763,6 +1770,23 @@ dbInst* dbBlock::findInst(const char* name)
   return (dbInst*) block->_inst_hash.find(name);
 }
 
+void dbBlock::setNameIndexEnabled(bool enabled)
+{
+  _dbBlock* block = (_dbBlock*) this;
+  block->_net_hash.setIndexEnabled(enabled);
+  block->_inst_hash.setIndexEnabled(enabled);
+  block->_module_hash.setIndexEnabled(enabled);
+  block->_modinst_hash.setIndexEnabled(enabled);
+  block->_powerdomain_hash.setIndexEnabled(enabled);
+  block->_logicport_hash.setIndexEnabled(enabled);
+  block->_powerswitch_hash.setIndexEnabled(enabled);
+  block->_isolation_hash.setIndexEnabled(enabled);
+  block->_marker_category_hash.setIndexEnabled(enabled);
+  block->_levelshifter_hash.setIndexEnabled(enabled);
+  block->_group_hash.setIndexEnabled(enabled);
+  block->_bterm_hash.setIndexEnabled(enabled);
+}
+
 dbModule* dbBlock::findModule(const char* name)
 {
   _dbBlock* block = (_dbBlock*) this;
@@ -1827,16 +1851,13 @@ dbITerm* dbBlock::findITerm(const char* name)
 {
   _dbBlock* block = (_dbBlock*) this;
 
-  std::string s(name);
-
-  std::string::size_type idx = s.rfind(block->_hier_delimiter);
+  const char* delimiter = strrchr(name, block->_hier_delimiter);
 
-  if (idx == std::string::npos) {  // no delimiter
+  if (delimiter == nullptr) {  // no delimiter
     return nullptr;
   }
 
-  std::string instName = s.substr(0, idx);
-  std::string termName = s.substr(idx + 1, s.size());
+  const std::string instName(name, delimiter - name);
 
   dbInst* inst = findInst(instName.c_str());
 
@@ -1844,7 +1865,7 @@ dbITerm* dbBlock::findITerm(const char* name)
     return nullptr;
   }
 
-  return inst->findITerm(termName.c_str());
+  return inst->findITerm(delimiter + 1);
 }
 
 dbSet<dbObstruction> dbBlock::getObstructions()
@@ -2787,6 +2808,15 @@ dbBlockSearch* dbBlock::getSearchDb()
   return block->_searchDb;
 }
 
+const dbWireGeometry& dbBlock::getWireGeometry(int num_threads)
+{
+  _dbBlock* block = (_dbBlock*) this;
+  if (block->_wire_geometry_cache == nullptr) {
+    block->_wire_geometry_cache = new _dbWireGeometryCache(this);
+  }
+  return block->_wire_geometry_cache->get(num_threads);
+}
+
 void dbBlock::getWireUpdatedNets(std::vector<dbNet*>& result)
 {
   int tot = 0;
@@ -3038,6 +3068,37 @@ bool dbBlock::designIsRouted(bool verbose)
   return design_is_routed;
 }
 
+uint64_t dbBlock::compactTables()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  // Journals replay creates by id, which depends on the free lists.
+  const bool in_eco = block->_checkpoint_log
+                          ? block->_checkpoint_log->inEco()
+                          : block->_journal != nullptr;
+  if (in_eco || block->_journal_pending) {
+    block->getLogger()->warn(utl::ODB,
+                             1123,
+                             "Cannot compact the tables of {} during an eco.",
+                             getName());
+    return 0;
+  }
+
+  const uint64_t released = block->compactTables();
+  if (block->_checkpoint_log) {
+    // The journal since the last checkpoint was recorded with the old
+    // free lists; fold it into a new base.
+    block->_checkpoint_log->compact();
+  }
+  debugPrint(block->getLogger(),
+             utl::ODB,
+             "compact",
+             1,
+             "Released {} bytes from the tables of {}.",
+             released,
+             getName());
+  return released;
+}
+
 int dbBlock::globalConnect()
 {
   dbSet<dbGlobalConnect> gcs = getGlobalConnects();
@@ -3463,4 +3524,66 @@ void _dbBlock::collectMemInfo(MemInfo& info)
   info.children_["module_name_id_map"].add(_module_name_id_map);
 }
 
+uint64_t _dbBlock::compactTables()
+{
+  uint64_t released = 0;
+  released += _bterm_tbl->compact();
+  released += _iterm_tbl->compact();
+  released += _net_tbl->compact();
+  released += _inst_hdr_tbl->compact();
+  released += _inst_tbl->compact();
+  released += _box_tbl->compact();
+  released += _via_tbl->compact();
+  released += _gcell_grid_tbl->compact();
+  released += _track_grid_tbl->compact();
+  released += _obstruction_tbl->compact();
+  released += _blockage_tbl->compact();
+  released += _wire_tbl->compact();
+  released += _swire_tbl->compact();
+  released += _sbox_tbl->compact();
+  released += _row_tbl->compact();
+  released += _fill_tbl->compact();
+  released += _region_tbl->compact();
+  released += _hier_tbl->compact();
+  released += _bpin_tbl->compact();
+  released += _non_default_rule_tbl->compact();
+  released += _layer_rule_tbl->compact();
+  released += _prop_tbl->compact();
+  released += _module_tbl->compact();
+  released += _powerdomain_tbl->compact();
+  released += _logicport_tbl->compact();
+  released += _powerswitch_tbl->compact();
+  released += _isolation_tbl->compact();
+  released += _levelshifter_tbl->compact();
+  released += _modinst_tbl->compact();
+  released += _group_tbl->compact();
+  released += ap_tbl_->compact();
+  released += global_connect_tbl_->compact();
+  released += _guide_tbl->compact();
+  released += _net_tracks_tbl->compact();
+  released += _dft_tbl->compact();
+  released += _marker_categories_tbl->compact();
+  released += _modbterm_tbl->compact();
+  released += _moditerm_tbl->compact();
+  released += _modnet_tbl->compact();
+  released += _busport_tbl->compact();
+  released += _cap_node_tbl->compact();
+  released += _r_seg_tbl->compact();
+  released += _cc_seg_tbl->compact();
+
+  _net_hash.compact();
+  _inst_hash.compact();
+  _module_hash.compact();
+  _modinst_hash.compact();
+  _powerdomain_hash.compact();
+  _logicport_hash.compact();
+  _powerswitch_hash.compact();
+  _isolation_hash.compact();
+  _marker_category_hash.compact();
+  _levelshifter_hash.compact();
+  _group_hash.compact();
+  _bterm_hash.compact();
+  return released;
+}
+
 }  // namespace odb
@@ -5,6 +5,7 @@
 
 #include <list>
 #include <map>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,7 @@ class _dbNet;
 class _dbInst;
 class _dbInstHdr;
 class _dbWire;
+class _dbWireGeometryCache;
 class _dbVia;
 class _dbGCellGrid;
 class _dbTrackGrid;
@@ -75,6 +77,7 @@ class _dbGuide;
 class _dbNetTrack;
 class _dbMarkerCategory;
 class dbJournal;
+class dbCheckpointLog;
 
 class dbNetBTermItr;
 class dbBPinItr;
@@ -269,6 +272,7 @@ class _dbBlock : public _dbObject
   dbBPinItr* _bpin_itr;
   dbPropertyItr* _prop_itr;
   dbBlockSearch* _searchDb;
+  _dbWireGeometryCache* _wire_geometry_cache;
 
   std::map<std::string, int> _module_name_id_map;
 
@@ -279,6 +283,10 @@ class _dbBlock : public _dbObject
 
   dbJournal* _journal;
   dbJournal* _journal_pending;
+  dbCheckpointLog* _checkpoint_log;
+
+  // Held shared by dbBlockSnapshot and exclusively by dbBlockWriteLock.
+  std::shared_mutex _snapshot_mutex;
 
   _dbBlock(_dbDatabase* db);
   ~_dbBlock();
@@ -300,6 +308,7 @@ class _dbBlock : public _dbObject
 
   dbObjectTable* getObjectTable(dbObjectType type);
   void collectMemInfo(MemInfo& info);
+  uint64_t compactTables();
   void clearSystemBlockagesAndObstructions();
 };
 
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#include "odb/dbBlockSnapshot.h"
+
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include "dbBlock.h"
+#include "odb/db.h"
+#include "odb/dbSet.h"
+
+namespace odb {
+
+static std::shared_mutex& snapshotMutex(dbBlock* block)
+{
+  return ((_dbBlock*) block)->_snapshot_mutex;
+}
+
+template <class T>
+static void copySet(dbSet<T> objects, std::vector<T*>& copy)
+{
+  copy.reserve(objects.size());
+  for (T* object : objects) {
+    copy.push_back(object);
+  }
+}
+
+dbBlockSnapshot::dbBlockSnapshot(dbBlock* block)
+    : block_(block), lock_(snapshotMutex(block))
+{
+}
+
+const std::vector<dbInst*>& dbBlockSnapshot::getInsts() const
+{
+  std::call_once(insts_once_, [this] { copySet(block_->getInsts(), insts_); });
+  return insts_;
+}
+
+const std::vector<dbNet*>& dbBlockSnapshot::getNets() const
+{
+  std::call_once(nets_once_, [this] { copySet(block_->getNets(), nets_); });
+  return nets_;
+}
+
+const std::vector<dbBTerm*>& dbBlockSnapshot::getBTerms() const
+{
+  std::call_once(bterms_once_,
+                 [this] { copySet(block_->getBTerms(), bterms_); });
+  return bterms_;
+}
+
+dbInst* dbBlockSnapshot::findInst(const char* name) const
+{
+  return block_->findInst(name);
+}
+
+dbNet* dbBlockSnapshot::findNet(const char* name) const
+{
+  return block_->findNet(name);
+}
+
+dbITerm* dbBlockSnapshot::findITerm(const char* name) const
+{
+  return block_->findITerm(name);
+}
+
+dbBTerm* dbBlockSnapshot::findBTerm(const char* name) const
+{
+  return block_->findBTerm(name);
+}
+
+////////////////////////////////////////////////////////////////
+
+dbBlockWriteLock::dbBlockWriteLock(dbBlock* block)
+    : lock_(snapshotMutex(block))
+{
+}
+
+}  // namespace odb
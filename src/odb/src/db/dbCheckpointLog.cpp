@@ -0,0 +1,347 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#include "dbCheckpointLog.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+
+#include "dbBlock.h"
+#include "dbDatabase.h"
+#include "dbJournal.h"
+#include "odb/db.h"
+#include "odb/dbStream.h"
+#include "utl/Logger.h"
+
+namespace odb {
+
+namespace fs = std::filesystem;
+
+template <class T>
+static void writeValue(std::ostream& file, T value)
+{
+  file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <class T>
+static bool readValue(std::istream& file, T& value)
+{
+  return static_cast<bool>(
+      file.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+dbCheckpointLog::dbCheckpointLog(_dbBlock* block, const std::string& base_file)
+    : block_(block), base_file_(base_file)
+{
+}
+
+std::string dbCheckpointLog::journalFile() const
+{
+  return base_file_ + ".journal";
+}
+
+void dbCheckpointLog::baseStamp(uint64_t& size, int64_t& time) const
+{
+  std::error_code ec;
+  size = fs::file_size(base_file_, ec);
+  if (!ec) {
+    time = fs::last_write_time(base_file_, ec).time_since_epoch().count();
+  }
+  if (ec) {
+    block_->getLogger()->error(utl::ODB,
+                               1129,
+                               "Cannot read checkpoint base {}: {}",
+                               base_file_,
+                               ec.message());
+  }
+}
+
+void dbCheckpointLog::writeBase()
+{
+  // Write to the side so a failed write leaves the previous base and
+  // journal intact.
+  const std::string tmp_file = base_file_ + ".tmp";
+  {
+    std::ofstream file(tmp_file, std::ios::binary);
+    if (!file) {
+      int errnum = errno;
+      block_->getLogger()->error(utl::ODB,
+                                 1130,
+                                 "Error opening file {}: {}",
+                                 tmp_file,
+                                 strerror(errnum));
+    }
+    file.exceptions(std::ifstream::failbit | std::ifstream::badbit
+                    | std::ios::eofbit);
+    ((dbDatabase*) block_->getDatabase())->write(file);
+  }
+  fs::rename(tmp_file, base_file_);
+  resetJournalFile();
+}
+
+void dbCheckpointLog::resetJournalFile()
+{
+  uint64_t base_size;
+  int64_t base_time;
+  baseStamp(base_size, base_time);
+
+  std::ofstream file(journalFile(), std::ios::binary | std::ios::trunc);
+  if (!file) {
+    int errnum = errno;
+    block_->getLogger()->error(utl::ODB,
+                               1113,
+                               "Error opening file {}: {}",
+                               journalFile(),
+                               strerror(errnum));
+  }
+  file.exceptions(std::ifstream::failbit | std::ifstream::badbit
+                  | std::ios::eofbit);
+  file.write(magic_, sizeof(magic_));
+  writeValue(file, version_);
+  writeValue(file, base_size);
+  writeValue(file, base_time);
+}
+
+void dbCheckpointLog::startJournal()
+{
+  block_->_journal = new dbJournal((dbBlock*) block_);
+}
+
+void dbCheckpointLog::unjournaledEdit()
+{
+  if (!needs_compact_) {
+    debugPrint(block_->getLogger(),
+               utl::ODB,
+               "checkpoint",
+               1,
+               "Edit not recorded by the journal; the next checkpoint "
+               "rewrites {}.",
+               base_file_);
+  }
+  needs_compact_ = true;
+}
+
+void dbCheckpointLog::begin()
+{
+  writeBase();
+  startJournal();
+  unjournaled_edits_.addOwner((dbBlock*) block_);
+}
+
+void dbCheckpointLog::resume()
+{
+  utl::Logger* logger = block_->getLogger();
+  const std::string journal_file = journalFile();
+  std::ifstream file(journal_file, std::ios::binary);
+  if (!file) {
+    logger->warn(utl::ODB,
+                 1114,
+                 "No checkpoint journal {}; starting a new one.",
+                 journal_file);
+    resetJournalFile();
+    startJournal();
+    unjournaled_edits_.addOwner((dbBlock*) block_);
+    return;
+  }
+
+  uint64_t base_size;
+  int64_t base_time;
+  baseStamp(base_size, base_time);
+  char magic[sizeof(magic_)];
+  uint32_t version;
+  uint64_t size;
+  int64_t time;
+  const bool header_ok = file.read(magic, sizeof(magic))
+                         && readValue(file, version) && readValue(file, size)
+                         && readValue(file, time)
+                         && std::memcmp(magic, magic_, sizeof(magic)) == 0
+                         && version == version_;
+  if (!header_ok || size != base_size || time != base_time) {
+    // Usually a compaction interrupted after the new base was in place,
+    // whose contents already include the journal.
+    logger->warn(utl::ODB,
+                 1115,
+                 "Checkpoint journal {} does not match {}; ignoring it.",
+                 journal_file,
+                 base_file_);
+    file.close();
+    resetJournalFile();
+    startJournal();
+    unjournaled_edits_.addOwner((dbBlock*) block_);
+    return;
+  }
+
+  int num_segments = 0;
+  std::streamoff good_end = file.tellg();
+  std::string bytes;
+  char kind;
+  while (readValue(file, kind)) {
+    if ((kind != REDO && kind != UNDO) || !readValue(file, size)
+        || (bytes.resize(size), !file.read(bytes.data(), size))) {
+      // Torn by a crash while appending; drop the partial segment.
+      logger->warn(utl::ODB,
+                   1116,
+                   "Dropping incomplete segment at the end of checkpoint "
+                   "journal {}.",
+                   journal_file);
+      break;
+    }
+    std::istringstream segment(bytes);
+    dbIStream stream(block_->getDatabase(), segment);
+    dbJournal journal((dbBlock*) block_);
+    stream >> journal;
+    if (kind == REDO) {
+      journal.redo();
+    } else {
+      journal.undo();
+    }
+    good_end = file.tellg();
+    num_segments++;
+  }
+  file.close();
+  fs::resize_file(journal_file, good_end);
+
+  logger->info(utl::ODB,
+               1117,
+               "Replayed {} checkpoint journal segments from {}.",
+               num_segments,
+               journal_file);
+  startJournal();
+  // Replay only makes journaled edits.
+  unjournaled_edits_.addOwner((dbBlock*) block_);
+}
+
+std::string dbCheckpointLog::serialize(const dbJournal& journal,
+                                       SegmentKind kind) const
+{
+  std::ostringstream segment;
+  segment.put(kind);
+  dbOStream stream(block_->getDatabase(), segment);
+  stream << journal;
+  return segment.str();
+}
+
+void dbCheckpointLog::pushSegment(const dbJournal& journal, SegmentKind kind)
+{
+  if (journal.empty()) {
+    return;
+  }
+  segments_.push_back(serialize(journal, kind));
+  last_is_eco_ = false;
+}
+
+void dbCheckpointLog::pushJournal()
+{
+  if (!in_eco_) {
+    pushSegment(*block_->_journal, REDO);
+    block_->_journal->clear();
+  }
+}
+
+void dbCheckpointLog::write()
+{
+  if (needs_compact_) {
+    // The journal file is left as is until the eco ends.
+    if (!in_eco_) {
+      compact();
+    }
+    return;
+  }
+
+  pushJournal();
+
+  std::ofstream file(journalFile(), std::ios::binary | std::ios::app);
+  if (!file) {
+    int errnum = errno;
+    block_->getLogger()->error(utl::ODB,
+                               1118,
+                               "Error opening file {}: {}",
+                               journalFile(),
+                               strerror(errnum));
+  }
+  file.exceptions(std::ifstream::failbit | std::ifstream::badbit
+                  | std::ios::eofbit);
+  for (const std::string& segment : segments_) {
+    // The kind byte is followed by the size of the serialized journal.
+    file.put(segment[0]);
+    writeValue(file, static_cast<uint64_t>(segment.size() - 1));
+    file.write(segment.data() + 1, segment.size() - 1);
+  }
+  file.flush();
+  segments_.clear();
+  last_is_eco_ = false;
+}
+
+void dbCheckpointLog::compact()
+{
+  if (in_eco_) {
+    // The base would hold part of an eco whose journal is appended
+    // when it ends.
+    needs_compact_ = true;
+    return;
+  }
+  writeBase();
+  segments_.clear();
+  last_is_eco_ = false;
+  needs_compact_ = false;
+  block_->_journal->clear();
+}
+
+void dbCheckpointLog::beginEco()
+{
+  // beginEco discards an unfinished eco's journal but its changes stay
+  // in the block.
+  pushSegment(*block_->_journal, REDO);
+  in_eco_ = true;
+}
+
+void dbCheckpointLog::endEco(dbJournal* eco)
+{
+  // eco is the checkpoint journal itself if endEco is called without
+  // beginEco; it is a segment all the same.
+  if (eco) {
+    pushSegment(*eco, REDO);
+    last_is_eco_ = !eco->empty();
+  }
+  in_eco_ = false;
+  startJournal();
+}
+
+bool dbCheckpointLog::commitEco(dbJournal* pending)
+{
+  if (in_eco_) {
+    needs_compact_ = true;
+    return false;
+  }
+  pushJournal();
+  pushSegment(*pending, REDO);
+  return true;
+}
+
+bool dbCheckpointLog::undoEco(dbJournal* pending)
+{
+  if (in_eco_) {
+    needs_compact_ = true;
+    return false;
+  }
+  if (last_is_eco_ && block_->_journal->empty()
+      && segments_.back() == serialize(*pending, REDO)) {
+    // Undoing the eco that just ended, whose segment has not been
+    // written yet; the pair cancels out.
+    segments_.pop_back();
+    last_is_eco_ = false;
+    return true;
+  }
+  pushJournal();
+  pushSegment(*pending, UNDO);
+  return true;
+}
+
+}  // namespace odb
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "odb/dbBlockCallBackObj.h"
+
+namespace odb {
+
+class _dbBlock;
+class dbJournal;
+
+// Incremental checkpoints of a block: a full .odb base file plus an
+// append-only file of journal segments, <base>.journal. While
+// checkpointing, the block's _journal records the changes since the
+// last segment.
+//
+// Ecos nest inside checkpoints. An eco's journal becomes a segment when
+// it ends, and committing or undoing a pending eco appends it again as
+// a segment to redo or undo. Replay then makes the same calls in the
+// same order as the original session, which keeps object ids (and so
+// later segments) consistent. Undoing during another eco is journaled
+// into that eco and can not be mirrored; the next checkpoint rewrites
+// the base instead. An eco that is undone right after it ends, as the
+// resizer does to restore its journal, drops its redo segment rather
+// than appending an undo segment: the table free lists are LIFO and the
+// undo runs in reverse, so the ids created next are the same as if the
+// eco had never run.
+//
+// Edits dbJournal does not record (wires, special wires, rows,
+// blockages, ...) are seen through block callbacks and also make the
+// next checkpoint rewrite the base.
+//
+// The journal file starts with a header holding the size and
+// modification time of the base it extends. Each segment is a kind
+// byte, a byte count and a serialized dbJournal.
+class dbCheckpointLog
+{
+ public:
+  dbCheckpointLog(_dbBlock* block, const std::string& base_file);
+
+  // Writes the base and an empty journal file, then starts journaling.
+  void begin();
+  // Replays the journal file over the just read base, then starts
+  // journaling.
+  void resume();
+  // Appends the changes since the last checkpoint to the journal file.
+  void write();
+  // Rewrites the base with the current block and empties the journal
+  // file.
+  void compact();
+
+  // Called by the dbDatabase eco methods around their changes to the
+  // block's journals. The undo and commit hooks return whether to
+  // suspend journaling while the pending eco is applied.
+  void beginEco();
+  void endEco(dbJournal* eco);
+  bool commitEco(dbJournal* pending);
+  bool undoEco(dbJournal* pending);
+  bool inEco() const { return in_eco_; }
+
+ private:
+  enum SegmentKind : char
+  {
+    REDO,
+    UNDO
+  };
+
+  class UnjournaledEdits : public dbBlockCallBackObj
+  {
+   public:
+    explicit UnjournaledEdits(dbCheckpointLog* log) : log_(log) {}
+
+    void inDbBPinCreate(dbBPin*) override { log_->unjournaledEdit(); }
+    void inDbBPinDestroy(dbBPin*) override { log_->unjournaledEdit(); }
+    void inDbBlockageCreate(dbBlockage*) override { log_->unjournaledEdit(); }
+    void inDbBlockageDestroy(dbBlockage*) override
+    {
+      log_->unjournaledEdit();
+    }
+    void inDbObstructionCreate(dbObstruction*) override
+    {
+      log_->unjournaledEdit();
+    }
+    void inDbObstructionDestroy(dbObstruction*) override
+    {
+      log_->unjournaledEdit();
+    }
+    void inDbRegionCreate(dbRegion*) override { log_->unjournaledEdit(); }
+    void inDbRegionAddBox(dbRegion*, dbBox*) override
+    {
+      log_->unjournaledEdit();
+    }
+    void inDbRegionDestroy(dbRegion*) override { log_->unjournaledEdit(); }
+    void inDbRowCreate(dbRow*) override { log_->unjournaledEdit(); }
+    void inDbRowDestroy(dbRow*) override { log_->unjournaledEdit(); }
+    void inDbWireCreate(dbWire*) override { log_->unjournaledEdit(); }
+    void inDbWireDestroy(dbWire*) override { log_->unjournaledEdit(); }
+    void inDbWirePostModify(dbWire*) override { log_->unjournaledEdit(); }
+    void inDbWirePostAttach(dbWire*) override { log_->unjournaledEdit(); }
+    void inDbWirePostDetach(dbWire*, dbNet*) override
+    {
+      log_->unjournaledEdit();
+    }
+    void inDbWirePostAppend(dbWire*, dbWire*) override
+    {
+      log_->unjournaledEdit();
+    }
+    void inDbWirePostCopy(dbWire*, dbWire*) override
+    {
+      log_->unjournaledEdit();
+    }
+    void inDbSWireCreate(dbSWire*) override { log_->unjournaledEdit(); }
+    void inDbSWireDestroy(dbSWire*) override { log_->unjournaledEdit(); }
+    void inDbSWireAddSBox(dbSBox*) override { log_->unjournaledEdit(); }
+    void inDbSWireRemoveSBox(dbSBox*) override { log_->unjournaledEdit(); }
+    void inDbSWirePostDestroySBoxes(dbSWire*) override
+    {
+      log_->unjournaledEdit();
+    }
+    void inDbFillCreate(dbFill*) override { log_->unjournaledEdit(); }
+    void inDbBlockSetDieArea(dbBlock*) override { log_->unjournaledEdit(); }
+
+   private:
+    dbCheckpointLog* log_;
+  };
+
+  static constexpr char magic_[8] = "ODBJRNL";
+  static constexpr uint32_t version_ = 1;
+
+  std::string journalFile() const;
+  std::string serialize(const dbJournal& journal, SegmentKind kind) const;
+  void baseStamp(uint64_t& size, int64_t& time) const;
+  void writeBase();
+  void resetJournalFile();
+  void pushSegment(const dbJournal& journal, SegmentKind kind);
+  void pushJournal();
+  void startJournal();
+  void unjournaledEdit();
+
+  _dbBlock* block_;
+  std::string base_file_;
+  // Segments not yet appended to the journal file, oldest first.
+  std::vector<std::string> segments_;
+  // The last of segments_ is the redo of the eco that just ended.
+  bool last_is_eco_ = false;
+  bool in_eco_ = false;
+  bool needs_compact_ = false;
+  UnjournaledEdits unjournaled_edits_{this};
+};
+
+}  // namespace odb
@@ -52,6 +52,10 @@ struct MemInfo
   std::map<const char*, MemInfo> children_;
   int cnt{0};
   uint64_t size{0};
+  // Object tables only: bytes held by their pages, live or not, and the
+  // number of slots on their free lists.
+  uint64_t reserved{0};
+  int free_cnt{0};
 
   void add(const char* str)
   {
@@ -82,6 +86,7 @@ struct MemInfo
   {
     cnt += 1;
     size += table._hash_tbl.size() * sizeof(dbId<T>);
+    size += table._index.memoryUsage();
   }
 
   template <typename T>
@@ -15,6 +15,7 @@
 #include "dbBlock.h"
 #include "dbCCSeg.h"
 #include "dbCapNode.h"
+#include "dbCheckpointLog.h"
 #include "dbChip.h"
 #include "dbGDSLib.h"
 #include "dbITerm.h"
@@ -462,6 +463,10 @@ void dbDatabase::beginEco(dbBlock* block_)
 {
   _dbBlock* block = (_dbBlock*) block_;
 
+  if (block->_checkpoint_log) {
+    block->_checkpoint_log->beginEco();
+  }
+
   {
     delete block->_journal;
   }
@@ -481,6 +486,10 @@ void dbDatabase::endEco(dbBlock* block_)
   }
 
   block->_journal_pending = eco;
+
+  if (block->_checkpoint_log) {
+    block->_checkpoint_log->endEco(eco);
+  }
 }
 
 bool dbDatabase::ecoEmpty(dbBlock* block_)
@@ -553,7 +562,13 @@ void dbDatabase::commitEco(dbBlock* block_)
   // TODO: Need a check to ensure the commit is not applied to the block of
   // which this eco was generated from.
   if (block->_journal_pending) {
+    dbJournal* journal = block->_journal;
+    if (block->_checkpoint_log
+        && block->_checkpoint_log->commitEco(block->_journal_pending)) {
+      block->_journal = nullptr;
+    }
     block->_journal_pending->redo();
+    block->_journal = journal;
     delete block->_journal_pending;
     block->_journal_pending = nullptr;
   }
@@ -564,12 +579,94 @@ void dbDatabase::undoEco(dbBlock* block_)
   _dbBlock* block = (_dbBlock*) block_;
 
   if (block->_journal_pending) {
+    // The checkpoint log records the undo as a whole so the changes it
+    // makes are not journaled.
+    dbJournal* journal = block->_journal;
+    if (block->_checkpoint_log
+        && block->_checkpoint_log->undoEco(block->_journal_pending)) {
+      block->_journal = nullptr;
+    }
     block->_journal_pending->undo();
+    block->_journal = journal;
     delete block->_journal_pending;
     block->_journal_pending = nullptr;
   }
 }
 
+void dbDatabase::beginCheckpoints(dbBlock* block_, const char* base_file)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+
+  if (block->_journal || block_ != block_->getChip()->getBlock()) {
+    block->getLogger()->error(
+        utl::ODB,
+        1119,
+        "Checkpoints must begin on the top block outside of an eco.");
+  }
+
+  block->_checkpoint_log = new dbCheckpointLog(block, base_file);
+  block->_checkpoint_log->begin();
+}
+
+void dbDatabase::writeCheckpoint(dbBlock* block_)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+
+  if (block->_checkpoint_log == nullptr) {
+    block->getLogger()->error(
+        utl::ODB, 1120, "writeCheckpoint called before beginCheckpoints.");
+  }
+  block->_checkpoint_log->write();
+}
+
+void dbDatabase::compactCheckpoints(dbBlock* block_)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+
+  if (block->_checkpoint_log == nullptr) {
+    block->getLogger()->error(
+        utl::ODB, 1121, "compactCheckpoints called before beginCheckpoints.");
+  }
+  block->_checkpoint_log->compact();
+}
+
+void dbDatabase::endCheckpoints(dbBlock* block_)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+
+  if (block->_checkpoint_log == nullptr) {
+    return;
+  }
+  if (!block->_checkpoint_log->inEco()) {
+    delete block->_journal;
+    block->_journal = nullptr;
+  }
+  delete block->_checkpoint_log;
+  block->_checkpoint_log = nullptr;
+}
+
+dbBlock* dbDatabase::readCheckpoint(dbDatabase* db, const char* base_file)
+{
+  std::ifstream file;
+  file.exceptions(std::ifstream::failbit | std::ifstream::badbit
+                  | std::ios::eofbit);
+  file.open(base_file, std::ios::binary);
+  db->read(file);
+  file.close();
+
+  dbChip* chip = db->getChip();
+  if (chip == nullptr || chip->getBlock() == nullptr) {
+    ((_dbDatabase*) db)
+        ->_logger->error(
+            utl::ODB, 1122, "Checkpoint base {} has no block.", base_file);
+  }
+
+  _dbBlock* block = (_dbBlock*) chip->getBlock();
+  block->_checkpoint_log = new dbCheckpointLog(block, base_file);
+  block->_checkpoint_log->resume();
+  return (dbBlock*) block;
+}
+
 void dbDatabase::setLogger(utl::Logger* logger)
 {
   _dbDatabase* _db = (_dbDatabase*) this;
@@ -648,6 +745,7 @@ void dbDatabase::report()
   MemInfo root;
   db->collectMemInfo(root);
   utl::Logger* logger = db->getLogger();
+  uint64_t total_reserved = 0;
   std::function<int64_t(MemInfo&, const std::string&, int)> print =
       [&](MemInfo& info, const std::string& name, int depth) {
         double avg_size = 0;
@@ -661,6 +759,15 @@ void dbDatabase::report()
                        info.cnt,
                        info.size,
                        avg_size);
+        if (info.reserved > 0) {
+          // Table pages are allocated whole, so freed objects keep
+          // their memory until the table is compacted.
+          logger->report("{:40s} free={:9d} pages={:11d}",
+                         "",
+                         info.free_cnt,
+                         info.reserved);
+          total_reserved += info.reserved;
+        }
         for (auto [name, child] : info.children_) {
           total_size += print(child, std::string(depth, ' ') + name, depth + 1);
         }
@@ -668,6 +775,7 @@ void dbDatabase::report()
       };
   auto total_size = print(root, "dbDatabase", 1);
   logger->report("Total size = {}", total_size);
+  logger->report("Total table pages = {}", total_reserved);
 }
 
 void dbDatabase::addObserver(dbDatabaseObserver* observer)
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "dbNameIndex.h"
 #include "dbPagedVector.h"
 #include "odb/dbId.h"
 #include "odb/odb.h"
@@ -39,9 +40,13 @@ class dbHashTable
 
   // NON-PERSISTANT-MEMBERS
   dbTable<T>* _obj_tbl;
+  dbNameIndex<T> _index;
+  bool _index_enabled;
 
   void growTable();
   void shrinkTable();
+  // Returns true if lookups go through _index, building it if needed.
+  bool useIndex();
 
   dbHashTable();
   dbHashTable(const dbHashTable<T>& table);
@@ -50,6 +55,10 @@ class dbHashTable
   bool operator!=(const dbHashTable<T>& rhs) const { return !operator==(rhs); }
 
   void setTable(dbTable<T>* table) { _obj_tbl = table; }
+  void setIndexEnabled(bool enabled);
+  // Drops the name index, which keeps the slots of removed objects; it
+  // is rebuilt at its new size on the next lookup.
+  void compact() { _index.clear(); }
   T* find(const char* name);
   int hasMember(const char* name);
   void insert(T* object);
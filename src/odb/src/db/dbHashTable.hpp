@@ -25,14 +25,50 @@ dbHashTable<T>::dbHashTable()
 {
   _obj_tbl = nullptr;
   _num_entries = 0;
+  _index_enabled = false;
 }
 
 template <class T>
 dbHashTable<T>::dbHashTable(const dbHashTable<T>& t)
-    : _hash_tbl(t._hash_tbl), _num_entries(t._num_entries), _obj_tbl(t._obj_tbl)
+    : _hash_tbl(t._hash_tbl),
+      _num_entries(t._num_entries),
+      _obj_tbl(t._obj_tbl),
+      _index_enabled(t._index_enabled)
 {
 }
 
+template <class T>
+void dbHashTable<T>::setIndexEnabled(bool enabled)
+{
+  _index_enabled = enabled;
+  if (!enabled) {
+    _index.clear();
+  }
+}
+
+template <class T>
+bool dbHashTable<T>::useIndex()
+{
+  if (_index.isBuilt()) {
+    return true;
+  }
+  if (!_index_enabled || _num_entries < dbNameIndex<T>::min_entries) {
+    return false;
+  }
+  _index.build(_num_entries, [this](auto add) {
+    const uint sz = _hash_tbl.size();
+    for (uint i = 0; i < sz; ++i) {
+      dbId<T> cur = _hash_tbl[i];
+      while (cur != 0) {
+        T* entry = _obj_tbl->getPtr(cur);
+        add(entry, hash_string(entry->_name));
+        cur = entry->_next_entry;
+      }
+    }
+  });
+  return true;
+}
+
 template <class T>
 bool dbHashTable<T>::operator==(const dbHashTable<T>& rhs) const
 {
@@ -154,10 +190,15 @@ void dbHashTable<T>::insert(T* object)
     }
   }
 
-  uint hid = hash_string(object->_name) & (sz - 1);
+  const uint hash = hash_string(object->_name);
+  uint hid = hash & (sz - 1);
   dbId<T>& e = _hash_tbl[hid];
   object->_next_entry = e;
   e = object->getOID();
+
+  if (_index.isBuilt()) {
+    _index.insert(object, hash);
+  }
 }
 
 template <class T>
@@ -169,7 +210,12 @@ T* dbHashTable<T>::find(const char* name)
     return nullptr;
   }
 
-  uint hid = hash_string(name) & (sz - 1);
+  const uint hash = hash_string(name);
+  if (useIndex()) {
+    return _index.find(_obj_tbl, name, hash);
+  }
+
+  uint hid = hash & (sz - 1);
   dbId<T> cur = _hash_tbl[hid];
 
   while (cur != 0) {
@@ -194,7 +240,12 @@ int dbHashTable<T>::hasMember(const char* name)
     return false;
   }
 
-  uint hid = hash_string(name) & (sz - 1);
+  const uint hash = hash_string(name);
+  if (useIndex()) {
+    return _index.find(_obj_tbl, name, hash) != nullptr;
+  }
+
+  uint hid = hash & (sz - 1);
   dbId<T> cur = _hash_tbl[hid];
 
   while (cur != 0) {
@@ -214,7 +265,8 @@ template <class T>
 void dbHashTable<T>::remove(T* object)
 {
   uint sz = _hash_tbl.size();
-  uint hid = hash_string(object->_name) & (sz - 1);
+  const uint hash = hash_string(object->_name);
+  uint hid = hash & (sz - 1);
   dbId<T> cur = _hash_tbl[hid];
   dbId<T> prev;
 
@@ -230,6 +282,9 @@ void dbHashTable<T>::remove(T* object)
       }
 
       --_num_entries;
+      if (_index.isBuilt()) {
+        _index.remove(object, hash);
+      }
 
       uint r = (_num_entries + _num_entries / 10) / sz;
 
@@ -258,6 +313,8 @@ dbIStream& operator>>(dbIStream& stream, dbHashTable<T>& table)
 {
   stream >> table._hash_tbl;
   stream >> table._num_entries;
+  // Rebuilt on the next lookup.
+  table._index.clear();
   return stream;
 }
 
@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "odb/odb.h"
+
+namespace odb {
+
+template <class T>
+class dbTable;
+
+//////////////////////////////////////////////////////////
+///
+/// dbNameIndex - open-addressing index over the objects of a
+/// dbHashTable.
+///
+/// The chained table has to load every object on its bucket chain to
+/// compare names. The index keeps the full hash and the first bytes of
+/// the name inline in a flat array probed linearly, so a lookup
+/// usually touches a single cache line and one object.
+///
+/// The index is not persistent and is off by default, as it costs
+/// 16 bytes per slot at no less than twice the number of entries. Once
+/// enabled with dbBlock::setNameIndexEnabled it is built on the first
+/// lookup if the table is large enough and then kept up to date by
+/// insert and remove. Building is serialized so concurrent lookups are
+/// safe.
+///
+//////////////////////////////////////////////////////////
+template <class T>
+class dbNameIndex
+{
+ public:
+  // Smaller tables are fast enough with chaining.
+  static constexpr uint min_entries = 1024;
+
+  dbNameIndex() = default;
+  // Copies start unbuilt and are rebuilt on demand.
+  dbNameIndex(const dbNameIndex<T>&) {}
+  dbNameIndex<T>& operator=(const dbNameIndex<T>&)
+  {
+    clear();
+    return *this;
+  }
+
+  bool isBuilt() const { return _built.load(std::memory_order_acquire); }
+  void clear();
+  size_t memoryUsage() const { return _slots.capacity() * sizeof(Slot); }
+  // Builds the index unless another thread did. for_each_entry is
+  // called with a function to add an entry given its name hash.
+  template <class ForEachEntry>
+  void build(uint num_entries, ForEachEntry for_each_entry);
+
+  T* find(dbTable<T>* obj_tbl, const char* name, uint hash) const;
+  void insert(T* object, uint hash);
+  void remove(T* object, uint hash);
+
+ private:
+  struct Slot
+  {
+    uint32_t hash;
+    // Object id, 0 for an empty slot or _tombstone for a removed one.
+    uint32_t id;
+    uint64_t prefix;
+  };
+
+  static constexpr uint32_t _tombstone = ~0U;
+  static constexpr int _prefix_size = sizeof(uint64_t);
+
+  static uint64_t namePrefix(const char* name);
+  size_t firstSlot(uint hash) const;
+  void rehash(size_t capacity);
+  void insertSlot(const Slot& slot);
+
+  std::vector<Slot> _slots;
+  size_t _mask = 0;
+  size_t _size = 0;
+  size_t _tombstones = 0;
+  std::atomic<bool> _built{false};
+  std::mutex _build_mutex;
+};
+
+template <class T>
+inline uint64_t dbNameIndex<T>::namePrefix(const char* name)
+{
+  char bytes[_prefix_size] = {};
+  for (int i = 0; i < _prefix_size && name[i] != '\0'; ++i) {
+    bytes[i] = name[i];
+  }
+  uint64_t prefix;
+  std::memcpy(&prefix, bytes, sizeof(prefix));
+  return prefix;
+}
+
+template <class T>
+inline size_t dbNameIndex<T>::firstSlot(uint hash) const
+{
+  // Fibonacci hashing spreads the low quality bits of hash_string.
+  return (static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL >> 32) & _mask;
+}
+
+template <class T>
+void dbNameIndex<T>::clear()
+{
+  std::vector<Slot>().swap(_slots);
+  _mask = 0;
+  _size = 0;
+  _tombstones = 0;
+  _built.store(false, std::memory_order_release);
+}
+
+template <class T>
+template <class ForEachEntry>
+void dbNameIndex<T>::build(uint num_entries, ForEachEntry for_each_entry)
+{
+  std::lock_guard<std::mutex> lock(_build_mutex);
+  if (isBuilt()) {
+    return;
+  }
+
+  size_t capacity = 16;
+  while (capacity < 2 * static_cast<size_t>(num_entries)) {
+    capacity *= 2;
+  }
+  _slots.assign(capacity, Slot{0, 0, 0});
+  _mask = capacity - 1;
+  _size = 0;
+  _tombstones = 0;
+
+  for_each_entry([this](T* entry, uint hash) {
+    insertSlot({hash, entry->getOID(), namePrefix(entry->_name)});
+  });
+
+  _built.store(true, std::memory_order_release);
+}
+
+template <class T>
+T* dbNameIndex<T>::find(dbTable<T>* obj_tbl,
+                        const char* name,
+                        uint hash) const
+{
+  const uint64_t prefix = namePrefix(name);
+  for (size_t i = firstSlot(hash);; i = (i + 1) & _mask) {
+    const Slot& slot = _slots[i];
+    if (slot.id == 0) {
+      return nullptr;
+    }
+    if (slot.hash == hash && slot.prefix == prefix && slot.id != _tombstone) {
+      T* entry = obj_tbl->getPtr(slot.id);
+      if (strcmp(entry->_name, name) == 0) {
+        return entry;
+      }
+    }
+  }
+}
+
+template <class T>
+void dbNameIndex<T>::insert(T* object, uint hash)
+{
+  // Keep the load, including removed slots, under 3/4.
+  if ((_size + _tombstones + 1) * 4 > _slots.size() * 3) {
+    size_t capacity = _slots.size();
+    while ((_size + 1) * 2 > capacity) {
+      capacity *= 2;
+    }
+    rehash(capacity);
+  }
+  insertSlot({hash, object->getOID(), namePrefix(object->_name)});
+}
+
+template <class T>
+void dbNameIndex<T>::remove(T* object, uint hash)
+{
+  const uint32_t id = object->getOID();
+  for (size_t i = firstSlot(hash);; i = (i + 1) & _mask) {
+    Slot& slot = _slots[i];
+    if (slot.id == 0) {
+      return;
+    }
+    if (slot.id == id) {
+      slot.id = _tombstone;
+      --_size;
+      ++_tombstones;
+      return;
+    }
+  }
+}
+
+template <class T>
+void dbNameIndex<T>::rehash(size_t capacity)
+{
+  std::vector<Slot> slots(capacity, Slot{0, 0, 0});
+  slots.swap(_slots);
+  _mask = capacity - 1;
+  _size = 0;
+  _tombstones = 0;
+  for (const Slot& slot : slots) {
+    if (slot.id != 0 && slot.id != _tombstone) {
+      insertSlot(slot);
+    }
+  }
+}
+
+template <class T>
+inline void dbNameIndex<T>::insertSlot(const Slot& slot)
+{
+  size_t i = firstSlot(slot.hash);
+  while (_slots[i].id != 0 && _slots[i].id != _tombstone) {
+    i = (i + 1) & _mask;
+  }
+  if (_slots[i].id == _tombstone) {
+    --_tombstones;
+  }
+  _slots[i] = slot;
+  ++_size;
+}
+
+}  // namespace odb
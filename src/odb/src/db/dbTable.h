@@ -56,6 +56,12 @@ class dbTable : public dbObjectTable, public dbIterator
 
   void collectMemInfo(MemInfo& info);
 
+  // Releases the empty pages, both above the last object and between
+  // live objects, and relinks the free list in id order, so new objects
+  // fill the lowest free ids and the table stays dense. Ids of existing
+  // objects do not change. Returns the number of bytes released.
+  uint64_t compact();
+
   bool operator==(const dbTable<T>& rhs) const;
   bool operator!=(const dbTable<T>& table) const;
 
@@ -81,6 +87,7 @@ class dbTable : public dbObjectTable, public dbIterator
 
   void readPage(dbIStream& stream, dbTablePage* page);
   void writePage(dbOStream& stream, const dbTablePage* page) const;
+  void writeEmptyPage(dbOStream& stream) const;
 
   _dbFreeObject* getFreeObj(dbId<T> id);
 
@@ -95,7 +102,8 @@ class dbTable : public dbObjectTable, public dbIterator
   uint _free_list;      // objects on freelist
 
   // NON-PERSISTANT-DATA
-  dbTablePage** _pages;  // page-table
+  dbTablePage** _pages;  // page-table, nullptr for pages released by compact
+  uint _hole_cnt;        // number of released pages below _page_cnt
 
   template <class U>
   friend dbOStream& operator<<(dbOStream& stream, const dbTable<U>& table);
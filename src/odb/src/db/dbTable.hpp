@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstring>
 #include <new>
 #include <vector>
@@ -49,7 +50,7 @@ inline bool dbTable<T>::validId(dbId<T> id) const
   const uint page = (uint) id >> _page_shift;
   const uint offset = (uint) id & _page_mask;
 
-  if (((uint) id != 0) && (page < _page_cnt)) {
+  if (((uint) id != 0) && (page < _page_cnt) && _pages[page]) {
     T* p = (T*) &(_pages[page]->_objects[offset * sizeof(T)]);
     return (p->_oid & DB_ALLOC_BIT) == DB_ALLOC_BIT;
   }
@@ -88,6 +89,9 @@ void dbTable<T>::clear()
 {
   for (uint i = 0; i < _page_cnt; ++i) {
     dbTablePage* page = _pages[i];
+    if (page == nullptr) {
+      continue;
+    }
     const T* t = (T*) page->_objects;
     const T* e = &t[pageSize()];
 
@@ -109,6 +113,7 @@ void dbTable<T>::clear()
   _alloc_cnt = 0;
   _free_list = 0;
   _pages = nullptr;
+  _hole_cnt = 0;
 }
 
 template <class T>
@@ -129,6 +134,7 @@ dbTable<T>::dbTable(_dbDatabase* db,
   _alloc_cnt = 0;
   _free_list = 0;
   _pages = nullptr;
+  _hole_cnt = 0;
 }
 
 template <class T>
@@ -166,16 +172,24 @@ void dbTable<T>::newPage()
   ZALLOCATED(page);
   memset(page, 0, size);
 
-  const uint page_id = _page_cnt;
+  uint page_id = _page_cnt;
+
+  if (_hole_cnt > 0) {
+    // Refill the lowest page released by compact().
+    for (page_id = 0; _pages[page_id] != nullptr; ++page_id) {
+    }
+    --_hole_cnt;
+  } else {
+    if (_page_tbl_size == 0) {
+      _pages = new dbTablePage*[1];
+      _page_tbl_size = 1;
+    } else if (_page_tbl_size == _page_cnt) {
+      resizePageTbl();
+    }
 
-  if (_page_tbl_size == 0) {
-    _pages = new dbTablePage*[1];
-    _page_tbl_size = 1;
-  } else if (_page_tbl_size == _page_cnt) {
-    resizePageTbl();
+    ++_page_cnt;
   }
 
-  ++_page_cnt;
   page->_table = this;
   page->_page_addr = page_id << _page_shift;
   page->_alloccnt = 0;
@@ -275,7 +289,7 @@ inline void dbTable<T>::findBottom()
     assert(page_id < _page_cnt);
     page = _pages[page_id];
 
-    if (page->valid_page()) {
+    if (page && page->valid_page()) {
       break;
     }
   }
@@ -330,7 +344,7 @@ inline void dbTable<T>::findTop()
     assert(page_id >= 0);
     page = _pages[page_id];
 
-    if (page->valid_page()) {
+    if (page && page->valid_page()) {
       break;
     }
   }
@@ -434,9 +448,15 @@ uint dbTable<T>::next(uint id, ...)
   }
 
   uint page_id = id >> _page_shift;
-  dbTablePage* page = _pages[page_id];
   uint offset = id & _page_mask;
 
+  // Skip pages released by compact(); the page of _top_idx is never one.
+  while (_pages[page_id] == nullptr) {
+    ++page_id;
+    offset = 0;
+  }
+  dbTablePage* page = _pages[page_id];
+
 next_obj:
   T* p = (T*) &(page->_objects[offset * sizeof(T)]);
   T* e = (T*) &(page->_objects[pageSize() * sizeof(T)]);
@@ -454,7 +474,7 @@ next_obj:
   for (++page_id; page_id < _page_cnt; ++page_id) {
     page = _pages[page_id];
 
-    if (page->valid_page()) {
+    if (page && page->valid_page()) {
       offset = 0;
       goto next_obj;
     }
@@ -490,6 +510,21 @@ void dbTable<T>::writePage(dbOStream& stream, const dbTablePage* page) const
   }
 }
 
+// A page released by compact() is written as unlinked free objects so
+// the file format is unchanged. Reading it back allocates the page; the
+// next compact() releases it again.
+template <class T>
+void dbTable<T>::writeEmptyPage(dbOStream& stream) const
+{
+  const char allocated = 0;
+  const uint unlinked = 0;
+  for (uint i = 0; i < pageSize(); ++i) {
+    stream << allocated;
+    stream << unlinked;
+    stream << unlinked;
+  }
+}
+
 template <class T>
 void dbTable<T>::readPage(dbIStream& stream, dbTablePage* page)
 {
@@ -544,7 +579,11 @@ dbOStream& operator<<(dbOStream& stream, const dbTable<T>& table)
 
   for (uint i = 0; i < table._page_cnt; ++i) {
     const dbTablePage* page = table._pages[i];
-    table.writePage(stream, page);
+    if (page == nullptr) {
+      table.writeEmptyPage(stream);
+    } else {
+      table.writePage(stream, page);
+    }
   }
 
   stream << table._prop_list;
@@ -661,6 +700,86 @@ void dbTable<T>::collectMemInfo(MemInfo& info)
       getPtr(i)->collectMemInfo(info);
     }
   }
+
+  const uint64_t page_size = pageSize() * sizeof(T) + sizeof(dbObjectPage);
+  const uint page_cnt = _page_cnt - _hole_cnt;
+  info.reserved += page_cnt * page_size;
+  info.reserved += _page_tbl_size * sizeof(dbTablePage*);
+  if (page_cnt > 0) {
+    // The zero-object of the first page is never allocated.
+    info.free_cnt += page_cnt * pageSize() - _alloc_cnt - 1;
+  }
+}
+
+template <class T>
+uint64_t dbTable<T>::compact()
+{
+  const uint64_t page_size = pageSize() * sizeof(T) + sizeof(dbObjectPage);
+  uint64_t released = 0;
+
+  uint page_cnt = 0;
+  if (_alloc_cnt > 0) {
+    page_cnt = (_top_idx >> _page_shift) + 1;
+  }
+
+  for (uint i = page_cnt; i < _page_cnt; ++i) {
+    if (_pages[i]) {
+      free(_pages[i]);
+      _pages[i] = nullptr;
+      released += page_size;
+    }
+  }
+  _page_cnt = page_cnt;
+
+  // Release the empty pages below the top as holes in the page table;
+  // newPage() refills them before growing the table. The first page
+  // holds the zero-object and is kept.
+  _hole_cnt = 0;
+  for (uint i = 1; i < _page_cnt; ++i) {
+    if (_pages[i] && !_pages[i]->valid_page()) {
+      free(_pages[i]);
+      _pages[i] = nullptr;
+      released += page_size;
+    }
+    if (_pages[i] == nullptr) {
+      ++_hole_cnt;
+    }
+  }
+
+  if (_page_cnt == 0) {
+    released += _page_tbl_size * sizeof(dbTablePage*);
+    delete[] _pages;
+    _pages = nullptr;
+    _page_tbl_size = 0;
+  } else if (_page_cnt < _page_tbl_size) {
+    released += (_page_tbl_size - _page_cnt) * sizeof(dbTablePage*);
+    dbTablePage** old_tbl = _pages;
+    _pages = new dbTablePage*[_page_cnt];
+    std::copy(old_tbl, old_tbl + _page_cnt, _pages);
+    delete[] old_tbl;
+    _page_tbl_size = _page_cnt;
+  }
+
+  // Push from the top so the lowest ids are popped first, as newPage
+  // does. The zero-object is never linked.
+  _free_list = 0;
+  for (uint page_id = _page_cnt; page_id-- > 0;) {
+    dbTablePage* page = _pages[page_id];
+    if (page == nullptr) {
+      continue;
+    }
+    T* b = (T*) page->_objects;
+    for (T* t = &b[_page_mask]; t >= b; --t) {
+      if (page_id == 0 && t == b) {
+        break;
+      }
+      if ((t->_oid & DB_ALLOC_BIT) == 0) {
+        pushQ(_free_list, (_dbFreeObject*) t);
+      }
+    }
+  }
+
+  return released;
 }
 
 }  // namespace odb
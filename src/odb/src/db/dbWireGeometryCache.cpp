@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#include "dbWireGeometryCache.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "odb/db.h"
+#include "odb/dbShape.h"
+#include "odb/dbWireGeometry.h"
+
+namespace odb {
+
+static void addRect(dbWireRects& rects, const Rect& rect, uint net_id)
+{
+  rects.xlo.push_back(rect.xMin());
+  rects.ylo.push_back(rect.yMin());
+  rects.xhi.push_back(rect.xMax());
+  rects.yhi.push_back(rect.yMax());
+  rects.net_ids.push_back(net_id);
+}
+
+static void appendRects(dbWireRects& dst, const dbWireRects& src)
+{
+  dst.xlo.insert(dst.xlo.end(), src.xlo.begin(), src.xlo.end());
+  dst.ylo.insert(dst.ylo.end(), src.ylo.begin(), src.ylo.end());
+  dst.xhi.insert(dst.xhi.end(), src.xhi.begin(), src.xhi.end());
+  dst.yhi.insert(dst.yhi.end(), src.yhi.begin(), src.yhi.end());
+  dst.net_ids.insert(
+      dst.net_ids.end(), src.net_ids.begin(), src.net_ids.end());
+}
+
+static void decodeWire(dbWire* wire,
+                       uint net_id,
+                       std::vector<dbWireLayerGeometry>& layers)
+{
+  dbWireShapeItr shapes;
+  dbShape shape;
+  for (shapes.begin(wire); shapes.next(shape);) {
+    if (shape.isVia()) {
+      dbTechLayer* bottom;
+      dbObject* via;
+      if (shape.getTechVia()) {
+        dbTechVia* tech_via = shape.getTechVia();
+        bottom = tech_via->getBottomLayer();
+        via = tech_via;
+      } else {
+        dbVia* block_via = shape.getVia();
+        bottom = block_via->getBottomLayer();
+        via = block_via;
+      }
+      if (bottom == nullptr) {
+        continue;
+      }
+      dbWireVias& vias = layers[bottom->getNumber()].vias;
+      addRect(vias, shape.getBox(), net_id);
+      vias.vias.push_back(via);
+    } else {
+      addRect(layers[shape.getTechLayer()->getNumber()].segments,
+              shape.getBox(),
+              net_id);
+    }
+  }
+}
+
+_dbWireGeometryCache::_dbWireGeometryCache(dbBlock* block) : block_(block)
+{
+  addOwner(block);
+}
+
+void _dbWireGeometryCache::invalidate()
+{
+  if (valid_) {
+    geometry_ = dbWireGeometry();
+    valid_ = false;
+  }
+}
+
+const dbWireGeometry& _dbWireGeometryCache::get(int num_threads)
+{
+  if (!valid_) {
+    decode(num_threads);
+    valid_ = true;
+  }
+  return geometry_;
+}
+
+void _dbWireGeometryCache::decode(int num_threads)
+{
+  std::vector<dbNet*> nets;
+  for (dbNet* net : block_->getNets()) {
+    if (net->getWire()) {
+      nets.push_back(net);
+    }
+  }
+
+  dbTech* tech = block_->getTech();
+  geometry_.layers.clear();
+  geometry_.layers.resize(tech->getLayerCount());
+  for (dbTechLayer* layer : tech->getLayers()) {
+    geometry_.layers[layer->getNumber()].layer = layer;
+  }
+
+  // Decoding only reads the block. Each chunk of nets is decoded into
+  // its own arrays, which are concatenated in net order so the result
+  // does not depend on the thread count.
+  const int chunk_size = 1024;
+  const int net_count = nets.size();
+  const int chunk_count = (net_count + chunk_size - 1) / chunk_size;
+  const int layer_count = geometry_.layers.size();
+  std::vector<std::vector<dbWireLayerGeometry>> chunks(chunk_count);
+#pragma omp parallel for num_threads(std::max(num_threads, 1)) \
+    schedule(dynamic)
+  for (int c = 0; c < chunk_count; c++) {
+    std::vector<dbWireLayerGeometry>& chunk = chunks[c];
+    chunk.resize(layer_count);
+    const int end = std::min((c + 1) * chunk_size, net_count);
+    for (int i = c * chunk_size; i < end; i++) {
+      decodeWire(nets[i]->getWire(), nets[i]->getId(), chunk);
+    }
+  }
+
+  for (std::vector<dbWireLayerGeometry>& chunk : chunks) {
+    for (int l = 0; l < layer_count; l++) {
+      dbWireLayerGeometry& layer = geometry_.layers[l];
+      appendRects(layer.segments, chunk[l].segments);
+      appendRects(layer.vias, chunk[l].vias);
+      layer.vias.vias.insert(layer.vias.vias.end(),
+                             chunk[l].vias.vias.begin(),
+                             chunk[l].vias.vias.end());
+    }
+    chunk.clear();
+    chunk.shrink_to_fit();
+  }
+}
+
+}  // namespace odb
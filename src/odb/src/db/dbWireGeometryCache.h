@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#pragma once
+
+#include "odb/db.h"
+#include "odb/dbBlockCallBackObj.h"
+#include "odb/dbWireGeometry.h"
+
+namespace odb {
+
+// Decoded wire geometry of a block. It registers as a block callback
+// and drops the geometry whenever a dbWire is created, modified,
+// attached, detached, appended to or destroyed.
+class _dbWireGeometryCache : public dbBlockCallBackObj
+{
+ public:
+  explicit _dbWireGeometryCache(dbBlock* block);
+
+  const dbWireGeometry& get(int num_threads);
+
+  void inDbNetDestroy(dbNet*) override { invalidate(); }
+  void inDbWireCreate(dbWire*) override { invalidate(); }
+  void inDbWireDestroy(dbWire*) override { invalidate(); }
+  void inDbWirePostModify(dbWire*) override { invalidate(); }
+  void inDbWirePostAttach(dbWire*) override { invalidate(); }
+  void inDbWirePostDetach(dbWire*, dbNet*) override { invalidate(); }
+  void inDbWirePostAppend(dbWire*, dbWire*) override { invalidate(); }
+
+ private:
+  void invalidate();
+  void decode(int num_threads);
+
+  dbBlock* block_;
+  dbWireGeometry geometry_;
+  bool valid_ = false;
+};
+
+}  // namespace odb
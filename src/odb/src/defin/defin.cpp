@@ -58,6 +58,11 @@ void defin::continueOnErrors()
   _reader->continueOnErrors();
 }
 
+void defin::setThreads(int num_threads)
+{
+  _reader->setThreads(num_threads);
+}
+
 void defin::namesAreDBIDs()
 {
   _reader->namesAreDBIDs();
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#include "definComponentPipeline.h"
+
+#include <exception>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "defiComponent.hpp"
+
+namespace odb {
+
+definComponentRecord::definComponentRecord(DefParser::defiComponent* comp,
+                                           const char* id)
+    : _id(id),
+      _name(comp->name()),
+      _has_source(comp->hasSource()),
+      _has_weight(comp->hasWeight()),
+      _has_region(comp->hasRegionName()),
+      _has_halo(comp->hasHalo() > 0),
+      _weight(_has_weight ? comp->weight() : 0),
+      _halo{0, 0, 0, 0},
+      _status(comp->placementStatus()),
+      _x(comp->placementX()),
+      _y(comp->placementY()),
+      _orient(comp->placementOrient())
+{
+  if (_has_source) {
+    _source = comp->source();
+  }
+  if (_has_region) {
+    _region = comp->regionName();
+  }
+  if (_has_halo) {
+    comp->haloEdges(&_halo[0], &_halo[1], &_halo[2], &_halo[3]);
+  }
+  _props.reserve(comp->numProps());
+  for (int i = 0; i < comp->numProps(); ++i) {
+    Prop prop;
+    prop.name = comp->propName(i);
+    prop.type = comp->propType(i);
+    prop.number = comp->propNumber(i);
+    if (comp->propValue(i)) {
+      prop.value = comp->propValue(i);
+    }
+    _props.push_back(std::move(prop));
+  }
+}
+
+void definComponentRecord::haloEdges(int* left,
+                                     int* bottom,
+                                     int* right,
+                                     int* top) const
+{
+  *left = _halo[0];
+  *bottom = _halo[1];
+  *right = _halo[2];
+  *top = _halo[3];
+}
+
+////////////////////////////////////////////////////////////////
+
+definComponentPipeline::definComponentPipeline(CreateFn create)
+    : _create(std::move(create))
+{
+}
+
+definComponentPipeline::~definComponentPipeline()
+{
+  stop();
+}
+
+void definComponentPipeline::start()
+{
+  _done = false;
+  _error = nullptr;
+  _batch.reserve(_batch_size);
+  _thread = std::thread(&definComponentPipeline::run, this);
+}
+
+void definComponentPipeline::add(DefParser::defiComponent* comp,
+                                 const char* id)
+{
+  _batch.emplace_back(comp, id);
+  if (_batch.size() == _batch_size) {
+    push();
+  }
+}
+
+void definComponentPipeline::push()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  _queue_changed.wait(lock, [this] {
+    return _error || _queue.size() < _max_queued_batches;
+  });
+  if (_error) {
+    std::rethrow_exception(_error);
+  }
+  _queue.push_back(std::move(_batch));
+  lock.unlock();
+  _queue_changed.notify_all();
+  _batch.clear();
+  _batch.reserve(_batch_size);
+}
+
+void definComponentPipeline::finish()
+{
+  if (!_thread.joinable()) {
+    return;
+  }
+  if (!_batch.empty()) {
+    try {
+      push();
+    } catch (...) {
+      stop();
+      throw;
+    }
+  }
+  stop();
+  if (_error) {
+    std::rethrow_exception(_error);
+  }
+}
+
+void definComponentPipeline::stop()
+{
+  if (!_thread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _done = true;
+  }
+  _queue_changed.notify_all();
+  _thread.join();
+}
+
+void definComponentPipeline::run()
+{
+  for (;;) {
+    std::vector<definComponentRecord> batch;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _queue_changed.wait(lock, [this] { return _done || !_queue.empty(); });
+      if (_queue.empty()) {
+        return;
+      }
+      batch = std::move(_queue.front());
+      _queue.pop_front();
+    }
+    _queue_changed.notify_all();
+    try {
+      for (const definComponentRecord& record : batch) {
+        _create(record);
+      }
+    } catch (...) {
+      // Letting the exception escape the thread would terminate the
+      // process. Stop here and hand it to the parser thread instead.
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _error = std::current_exception();
+        _queue.clear();
+      }
+      _queue_changed.notify_all();
+      return;
+    }
+  }
+}
+
+}  // namespace odb
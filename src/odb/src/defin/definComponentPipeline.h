@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace DefParser {
+class defiComponent;
+}
+
+namespace odb {
+
+// Copy of a parsed COMPONENTS statement. It has the accessors of
+// defiComponent used by definReader so both can be handled by the same
+// code.
+class definComponentRecord
+{
+ public:
+  definComponentRecord(DefParser::defiComponent* comp, const char* id);
+
+  const char* id() const { return _id.c_str(); }
+  const char* name() const { return _name.c_str(); }
+  int hasSource() const { return _has_source; }
+  const char* source() const { return _source.c_str(); }
+  int hasWeight() const { return _has_weight; }
+  int weight() const { return _weight; }
+  int hasRegionName() const { return _has_region; }
+  const char* regionName() const { return _region.c_str(); }
+  int hasHalo() const { return _has_halo; }
+  void haloEdges(int* left, int* bottom, int* right, int* top) const;
+  int placementStatus() const { return _status; }
+  int placementX() const { return _x; }
+  int placementY() const { return _y; }
+  int placementOrient() const { return _orient; }
+  int numProps() const { return _props.size(); }
+  const char* propName(int index) const { return _props[index].name.c_str(); }
+  const char* propValue(int index) const
+  {
+    return _props[index].value.c_str();
+  }
+  double propNumber(int index) const { return _props[index].number; }
+  char propType(int index) const { return _props[index].type; }
+
+ private:
+  struct Prop
+  {
+    std::string name;
+    std::string value;
+    double number;
+    char type;
+  };
+
+  std::string _id;
+  std::string _name;
+  std::string _source;
+  std::string _region;
+  bool _has_source;
+  bool _has_weight;
+  bool _has_region;
+  bool _has_halo;
+  int _weight;
+  int _halo[4];
+  int _status;
+  int _x;
+  int _y;
+  int _orient;
+  std::vector<Prop> _props;
+};
+
+// Creates the components of a COMPONENTS section on a worker thread
+// while the parser tokenizes the rest of the section. Records are handed
+// over in batches and created in file order. Nothing else may touch the
+// block between start() and finish(). An error raised while creating a
+// component stops the worker and is rethrown on the parser thread by the
+// next add() or by finish().
+class definComponentPipeline
+{
+ public:
+  using CreateFn = std::function<void(const definComponentRecord&)>;
+
+  explicit definComponentPipeline(CreateFn create);
+  ~definComponentPipeline();
+
+  void start();
+  void add(DefParser::defiComponent* comp, const char* id);
+  // Flush the last batch and wait for all components to be created.
+  void finish();
+
+ private:
+  void push();
+  void run();
+  void stop();
+
+  CreateFn _create;
+  std::vector<definComponentRecord> _batch;
+  std::deque<std::vector<definComponentRecord>> _queue;
+  std::mutex _mutex;
+  std::condition_variable _queue_changed;
+  bool _done = false;
+  std::exception_ptr _error;
+  std::thread _thread;
+
+  static constexpr size_t _batch_size = 4096;
+  // Bounds the memory held by records the worker has not caught up with.
+  static constexpr size_t _max_queued_batches = 64;
+};
+
+}  // namespace odb
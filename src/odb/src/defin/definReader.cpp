@@ -15,6 +15,7 @@
 #include "definBlockage.h"
 #include "definComponent.h"
 #include "definComponentMaskShift.h"
+#include "definComponentPipeline.h"
 #include "definFill.h"
 #include "definGCell.h"
 #include "definGroup.h"
@@ -165,6 +166,7 @@ definReader::definReader(dbDatabase* db, utl::Logger* logger, defin::MODE mode)
   _db = db;
   parent_ = nullptr;
   _continue_on_errors = false;
+  _num_threads = 1;
   hier_delimiter_ = 0;
   left_bus_delimiter_ = 0;
   right_bus_delimiter_ = 0;
@@ -273,6 +275,11 @@ void definReader::continueOnErrors()
   _continue_on_errors = true;
 }
 
+void definReader::setThreads(int num_threads)
+{
+  _num_threads = num_threads;
+}
+
 void definReader::replaceWires()
 {
   _netR->replaceWires();
@@ -347,6 +354,38 @@ static void handle_props(DEF_TYPE* def_obj, CALLBACK* callback)
   }
 }
 
+// Create one component from a defiComponent or a definComponentRecord.
+template <typename COMP>
+static void createComponent(COMP* comp,
+                            const char* id,
+                            definComponent* componentR)
+{
+  componentR->begin(id, comp->name());
+  if (comp->hasSource()) {
+    componentR->source(dbSourceType(comp->source()));
+  }
+  if (comp->hasWeight()) {
+    componentR->weight(comp->weight());
+  }
+  if (comp->hasRegionName()) {
+    componentR->region(comp->regionName());
+  }
+  if (comp->hasHalo() > 0) {
+    int left, bottom, right, top;
+    comp->haloEdges(&left, &bottom, &right, &top);
+    componentR->halo(left, bottom, right, top);
+  }
+
+  componentR->placement(comp->placementStatus(),
+                        comp->placementX(),
+                        comp->placementY(),
+                        comp->placementOrient());
+
+  handle_props(comp, componentR);
+
+  componentR->end();
+}
+
 static std::string renameBlock(dbBlock* parent, const char* old_name)
 {
   int cnt = 1;
@@ -583,31 +622,46 @@ int definReader::componentsCallback(
     UNSUPPORTED("ROUTEHALO on component is unsupported");
   }
 
-  componentR->begin(id.c_str(), comp->name());
-  if (comp->hasSource()) {
-    componentR->source(dbSourceType(comp->source()));
-  }
-  if (comp->hasWeight()) {
-    componentR->weight(comp->weight());
-  }
-  if (comp->hasRegionName()) {
-    componentR->region(comp->regionName());
-  }
-  if (comp->hasHalo() > 0) {
-    int left, bottom, right, top;
-    comp->haloEdges(&left, &bottom, &right, &top);
-    componentR->halo(left, bottom, right, top);
+  if (reader->_component_pipeline) {
+    reader->_component_pipeline->add(comp, id.c_str());
+  } else {
+    createComponent(comp, id.c_str(), componentR);
   }
 
-  componentR->placement(comp->placementStatus(),
-                        comp->placementX(),
-                        comp->placementY(),
-                        comp->placementOrient());
-
-  handle_props(comp, componentR);
+  return PARSE_OK;
+}
 
-  componentR->end();
+int definReader::componentsStartCallback(
+    DefParser::defrCallbackType_e /* unused: type */,
+    int /* unused: count */,
+    DefParser::defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  // Other modes look up existing instances while parsing, which would
+  // race with the worker.
+  if (reader->_num_threads > 1 && reader->_mode == defin::DEFAULT) {
+    definComponent* componentR = reader->_componentR;
+    reader->_component_pipeline = std::make_unique<definComponentPipeline>(
+        [componentR](const definComponentRecord& record) {
+          createComponent(&record, record.id(), componentR);
+        });
+    reader->_component_pipeline->start();
+  }
+  return PARSE_OK;
+}
 
+int definReader::componentsEndCallback(
+    DefParser::defrCallbackType_e /* unused: type */,
+    void* /* unused: v */,
+    DefParser::defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  // The rest of the DEF refers to the components so they must all exist.
+  // finish() rethrows any error the worker hit creating a component.
+  if (reader->_component_pipeline) {
+    reader->_component_pipeline->finish();
+    reader->_component_pipeline.reset();
+  }
   return PARSE_OK;
 }
 
@@ -2064,7 +2118,9 @@ bool definReader::createBlock(const char* file)
   defrSetDividerCbk(divideCharCallback);
   defrSetDesignCbk(designCallback);
   defrSetUnitsCbk(unitsCallback);
+  defrSetComponentStartCbk(componentsStartCallback);
   defrSetComponentCbk(componentsCallback);
+  defrSetComponentEndCbk(componentsEndCallback);
   defrSetComponentMaskShiftLayerCbk(componentMaskShiftCallback);
   defrSetPinCbk(pinCallback);
   defrSetPinEndCbk(pinsEndCallback);
@@ -2135,6 +2191,8 @@ bool definReader::createBlock(const char* file)
     res = DefParser::defrReadGZip(f, file, (DefParser::defiUserData) this);
     DefParser::defGZipClose(f);
   }
+  // A parse error may stop the reader inside COMPONENTS.
+  _component_pipeline.reset();
 
   if (res != 0 || errors() != 0) {
     if (!_continue_on_errors) {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -20,6 +21,7 @@ namespace odb {
 class definBlockage;
 class definComponentMaskShift;
 class definComponent;
+class definComponentPipeline;
 class definFill;
 class definGCell;
 class definNet;
@@ -41,6 +43,8 @@ class definReader : public definBase
   definBlockage* _blockageR;
   definComponentMaskShift* _componentMaskShift;
   definComponent* _componentR;
+  // Set while a COMPONENTS section is read with more than one thread.
+  std::unique_ptr<definComponentPipeline> _component_pipeline;
   definFill* _fillR;
   definGCell* _gcellR;
   definNet* _netR;
@@ -57,6 +61,7 @@ class definReader : public definBase
   std::vector<definBase*> _interfaces;
   bool _update;
   bool _continue_on_errors;
+  int _num_threads;
   std::string _block_name;
   std::string version_;
   char hier_delimiter_;
@@ -86,6 +91,14 @@ class definReader : public definBase
                                 DefParser::defiComponent* comp,
                                 DefParser::defiUserData data);
 
+  static int componentsStartCallback(DefParser::defrCallbackType_e type,
+                                     int count,
+                                     DefParser::defiUserData data);
+
+  static int componentsEndCallback(DefParser::defrCallbackType_e type,
+                                   void* v,
+                                   DefParser::defiUserData data);
+
   static int componentMaskShiftCallback(
       DefParser::defrCallbackType_e type,
       DefParser::defiComponentMaskShiftLayer* shiftLayers,
@@ -239,6 +252,7 @@ class definReader : public definBase
   void skipBlockWires();
   void skipFillWires();
   void continueOnErrors();
+  void setThreads(int num_threads);
   void useBlockName(const char* name);
   void namesAreDBIDs();
   void setAssemblyMode();
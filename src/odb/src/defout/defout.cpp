@@ -46,6 +46,11 @@ void defout::setVersion(Version v)
   _writer->setVersion(v);
 }
 
+void defout::setThreads(int num_threads)
+{
+  _writer->setThreads(num_threads);
+}
+
 bool defout::writeBlock(dbBlock* block, const char* def_file)
 {
   return _writer->writeBlock(block, def_file);
@@ -3,11 +3,14 @@
 
 #include "defout_impl.h"
 
-#include <sys/stat.h>
+#include <omp.h>
+#include <unistd.h>
+#include <zlib.h>
 
 #include <algorithm>
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <limits>
 #include <map>
 #include <optional>
@@ -36,6 +39,17 @@ std::string getPinName(dbITerm* iterm)
 
 static const int max_name_length = 256;
 
+// Objects formatted by a thread at a time in the large sections, and
+// chunks per thread kept in memory before they are written out.
+static const size_t chunk_size = 4096;
+static const int chunks_per_thread = 4;
+
+bool hasSuffix(const std::string& str, const std::string& suffix)
+{
+  return str.size() >= suffix.size()
+         && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
 template <typename T>
 std::vector<T*> sortedSet(dbSet<T>& to_sort)
 {
@@ -141,25 +155,27 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
 
   _dist_factor
       = (double) block->getDefUnits() / (double) block->getDbUnitsPerMicron();
-  utl::FileHandler fileHandler(def_file);
-  _out = fileHandler.getFile();
+  const bool compress = hasSuffix(def_file, ".gz");
+  utl::FileHandler fileHandler(def_file, compress);
+  _file = fileHandler.getFile();
 
-  if (_out == nullptr) {
+  if (_file == nullptr) {
     _logger->warn(
         utl::ODB, 172, "Cannot open DEF file ({}) for writing", def_file);
     return false;
   }
-
-  // By default C File*'s are line buffered which means they get dumped on every
-  // newline, which is nominally pretty expensive. This makes it so that the
-  // writes are buffered according to the block size which on modern systems can
-  // be as much as 16kb. DEF's have a lot of newlines, and are large in size
-  // which makes writing them really slow with line buffering.
-  //
-  // The following lines enable IO buffering based on disk block size.
-  struct stat stats;
-  fstat(fileno(_out), &stats);
-  setvbuf(_out, nullptr, _IOFBF, stats.st_blksize);
+  if (compress) {
+    // gzclose closes the dup'ed descriptor; fileHandler closes _file.
+    _gz_file = gzdopen(dup(fileno(_file)), "wb");
+    if (_gz_file == nullptr) {
+      fileHandler.discard();
+      _logger->warn(
+          utl::ODB, 496, "Cannot open gzip stream for DEF file ({})", def_file);
+      return false;
+    }
+  }
+  _write_failed = false;
+  beginOutput();
 
   if (_version == defout::DEF_5_3) {
     fprintf(_out, "VERSION 5.3 ;\n");
@@ -239,23 +255,107 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
   }
   writeInsts(block);
   writeBTerms(block);
+  flushOutput();
   writePinProperties(block);
   writeBlockages(block);
+  flushOutput();
   writeFills(block);
+  flushOutput();
   writeNets(block);
   writeGroups(block);
   writeScanChains(block);
 
   fprintf(_out, "END DESIGN\n");
+  endOutput();
+  if (_gz_file) {
+    if (gzclose(_gz_file) != Z_OK) {
+      _write_failed = true;
+    }
+    _gz_file = nullptr;
+  } else if (fflush(_file) != 0) {
+    _write_failed = true;
+  }
+  _file = nullptr;
   {
     delete _select_net_map;
   }
   {
     delete _select_inst_map;
   }
+  if (_write_failed) {
+    // Keep the truncated output from replacing def_file.
+    fileHandler.discard();
+    _logger->error(utl::ODB, 1126, "Error writing DEF file ({})", def_file);
+  }
   return true;
 }
 
+void defout_impl::beginOutput()
+{
+  _out = open_memstream(&_out_buffer, &_out_size);
+}
+
+void defout_impl::endOutput()
+{
+  fclose(_out);
+  _out = nullptr;
+  writeOutput(_out_buffer, _out_size);
+  free(_out_buffer);
+  _out_buffer = nullptr;
+  _out_size = 0;
+}
+
+void defout_impl::flushOutput()
+{
+  endOutput();
+  beginOutput();
+}
+
+void defout_impl::writeOutput(const char* data, size_t size)
+{
+  if (size == 0 || _write_failed) {
+    return;
+  }
+  if (_gz_file) {
+    _write_failed = gzwrite(_gz_file, data, size) != static_cast<int>(size);
+  } else {
+    _write_failed = fwrite(data, 1, size, _file) != size;
+  }
+}
+
+// Format objects with write in chunks on _num_threads threads, each
+// into its own memory stream, and write the chunks in order.
+template <typename T>
+void defout_impl::writeChunks(const std::vector<T*>& objects,
+                              void (defout_impl::*write)(T*))
+{
+  flushOutput();
+  // Each thread formats with its own copy of the writer state.
+  std::vector<defout_impl> writers(_num_threads, *this);
+  const int chunk_count = (objects.size() + chunk_size - 1) / chunk_size;
+  const int wave_size = _num_threads * chunks_per_thread;
+  for (int wave = 0; wave < chunk_count; wave += wave_size) {
+    const int wave_end = std::min(wave + wave_size, chunk_count);
+    std::vector<char*> buffers(wave_end - wave, nullptr);
+    std::vector<size_t> sizes(wave_end - wave, 0);
+#pragma omp parallel for num_threads(_num_threads) schedule(dynamic)
+    for (int chunk = wave; chunk < wave_end; chunk++) {
+      defout_impl& writer = writers[omp_get_thread_num()];
+      writer._out
+          = open_memstream(&buffers[chunk - wave], &sizes[chunk - wave]);
+      const size_t end = std::min((chunk + 1) * chunk_size, objects.size());
+      for (size_t i = chunk * chunk_size; i < end; i++) {
+        (writer.*write)(objects[i]);
+      }
+      fclose(writer._out);
+    }
+    for (int i = 0; i < wave_end - wave; i++) {
+      writeOutput(buffers[i], sizes[i]);
+      free(buffers[i]);
+    }
+  }
+}
+
 void defout_impl::writeRows(dbBlock* block)
 {
   dbSet<dbRow> rows = block->getRows();
@@ -534,12 +634,14 @@ void defout_impl::writeInsts(dbBlock* block)
   fprintf(_out, "COMPONENTS %u ;\n", insts.size());
 
   // Sort the components for consistent output
+  std::vector<dbInst*> selected;
   for (dbInst* inst : sortedSet(insts)) {
     if (_select_inst_map && !(*_select_inst_map)[inst]) {
       continue;
     }
-    writeInst(inst);
+    selected.push_back(inst);
   }
+  writeChunks(selected, &defout_impl::writeInst);
 
   fprintf(_out, "END COMPONENTS\n");
 }
@@ -1467,29 +1569,33 @@ void defout_impl::writeNets(dbBlock* block)
   if (snet_cnt > 0) {
     fprintf(_out, "SPECIALNETS %d ;\n", snet_cnt);
 
+    std::vector<dbNet*> snets;
     for (dbNet* net : sorted_nets) {
       if (_select_net_map && !(*_select_net_map)[net]) {
         continue;
       }
       if (net->isSpecial()) {
-        writeSNet(net);
+        snets.push_back(net);
       }
     }
+    writeChunks(snets, &defout_impl::writeSNet);
 
     fprintf(_out, "END SPECIALNETS\n");
   }
 
   fprintf(_out, "NETS %d ;\n", net_cnt);
 
+  std::vector<dbNet*> regular_nets;
   for (dbNet* net : sorted_nets) {
     if (_select_net_map && !(*_select_net_map)[net]) {
       continue;
     }
 
     if (regular_net[net] == 1) {
-      writeNet(net);
+      regular_nets.push_back(net);
     }
   }
+  writeChunks(regular_nets, &defout_impl::writeNet);
 
   fprintf(_out, "END NETS\n");
 }
@@ -3,9 +3,13 @@
 
 #pragma once
 
+#include <zlib.h>
+
+#include <cstdio>
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "odb/db.h"
 #include "odb/dbMap.h"
@@ -39,7 +43,16 @@ class defout_impl
   };
 
   double _dist_factor;
+  // Sections are formatted into memory streams and copied to the DEF
+  // file (or gzip stream) when complete.
   FILE* _out;
+  char* _out_buffer;
+  size_t _out_size;
+  FILE* _file;
+  gzFile _gz_file;
+  // Set when a write to _file or _gz_file comes up short.
+  bool _write_failed;
+  int _num_threads;
   bool _use_net_inst_ids;
   bool _use_master_ids;
   bool _use_alias;
@@ -56,6 +69,14 @@ class defout_impl
 
   int defdist(uint value) { return (uint) (((double) value) * _dist_factor); }
 
+  void beginOutput();
+  void flushOutput();
+  void endOutput();
+  void writeOutput(const char* data, size_t size);
+  template <typename T>
+  void writeChunks(const std::vector<T*>& objects,
+                   void (defout_impl::*write)(T*));
+
   void writePropertyDefinitions(dbBlock* block);
   void writeRows(dbBlock* block);
   void writeTracks(dbBlock* block);
@@ -92,6 +113,12 @@ class defout_impl
   {
     _dist_factor = 0;
     _out = nullptr;
+    _out_buffer = nullptr;
+    _out_size = 0;
+    _file = nullptr;
+    _gz_file = nullptr;
+    _write_failed = false;
+    _num_threads = 1;
     _use_net_inst_ids = false;
     _use_master_ids = false;
     _use_alias = false;
@@ -114,6 +141,7 @@ class defout_impl
 
   void selectInst(dbInst* inst);
   void setVersion(int v) { _version = v; }
+  void setThreads(int num_threads) { _num_threads = num_threads; }
 
   bool writeBlock(dbBlock* block, const char* def_file);
 };
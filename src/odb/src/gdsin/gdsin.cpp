@@ -4,7 +4,9 @@
 #include "odb/gdsin.h"
 
 #include <cstddef>
+#include <cstring>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -23,6 +25,9 @@ dbGDSLib* GDSReader::read_gds(const std::string& filename, dbDatabase* db)
   if (!_file) {
     _logger->error(ODB, 450, "Could not open file {}", filename);
   }
+  _buffer.resize(_buffer_size);
+  _buffer_begin = 0;
+  _buffer_end = 0;
   readRecord();
   checkRType(RecordType::HEADER);
 
@@ -30,6 +35,8 @@ dbGDSLib* GDSReader::read_gds(const std::string& filename, dbDatabase* db)
   if (_file.is_open()) {
     _file.close();
   }
+  _buffer.clear();
+  _buffer.shrink_to_fit();
   _db = nullptr;
 
   return _lib;
@@ -57,71 +64,77 @@ void GDSReader::checkRData(DataType eType, size_t eSize)
   }
 }
 
-double GDSReader::readReal8()
+bool GDSReader::fillBuffer(size_t size)
 {
-  uint64_t value;
-  _file.read(reinterpret_cast<char*>(&value), 8);
-  return real8_to_double(htobe64(value));
-}
-
-int32_t GDSReader::readInt32()
-{
-  int32_t value;
-  _file.read(reinterpret_cast<char*>(&value), 4);
-  return htobe32(value);
-}
-
-int16_t GDSReader::readInt16()
-{
-  int16_t value;
-  _file.read(reinterpret_cast<char*>(&value), 2);
-  return htobe16(value);
-}
-
-int8_t GDSReader::readInt8()
-{
-  int8_t value;
-  _file.read(reinterpret_cast<char*>(&value), 1);
-  return value;
+  const size_t available = _buffer_end - _buffer_begin;
+  if (available >= size) {
+    return true;
+  }
+  // Move the partial record to the front and top up the buffer.
+  std::memmove(_buffer.data(), _buffer.data() + _buffer_begin, available);
+  _buffer_begin = 0;
+  _buffer_end = available;
+  while (_buffer_end < size && _file) {
+    _file.read(_buffer.data() + _buffer_end, _buffer.size() - _buffer_end);
+    _buffer_end += _file.gcount();
+  }
+  return _buffer_end >= size;
 }
 
 bool GDSReader::readRecord()
 {
-  const uint16_t recordLength = readInt16();
-  const uint8_t recordType = readInt8();
-  const DataType dataType = toDataType(readInt8());
+  // Records are at most 64K, which always fits in the buffer.
+  if (!fillBuffer(4)) {
+    return false;
+  }
+  const char* header = _buffer.data() + _buffer_begin;
+  uint16_t recordLength;
+  std::memcpy(&recordLength, header, sizeof(recordLength));
+  recordLength = be16toh(recordLength);
+  const uint8_t recordType = header[2];
+  const DataType dataType = toDataType(header[3]);
   _r.type = toRecordType(recordType);
   _r.dataType = dataType;
-  if ((recordLength - 4) % dataTypeSize[(int) dataType] != 0) {
+  if (recordLength < 4
+      || (recordLength - 4) % dataTypeSize[(int) dataType] != 0) {
     throw std::runtime_error(
         "Corrupted GDS, Data size is not a multiple of data type size!");
   }
+  if (!fillBuffer(recordLength)) {
+    throw std::runtime_error("Corrupted GDS, Unexpected end of file!");
+  }
   _r.length = recordLength;
   const int length = recordLength - 4;
+  const char* data = _buffer.data() + _buffer_begin + 4;
+  _buffer_begin += recordLength;
+
+  // Copy the payload as is and swap the bytes in place.
   if (dataType == DataType::INT_2) {
-    _r.data16.clear();
-    for (int i = 0; i < length; i += 2) {
-      _r.data16.push_back(readInt16());
+    _r.data16.resize(length / 2);
+    std::memcpy(_r.data16.data(), data, length);
+    for (int16_t& value : _r.data16) {
+      value = be16toh(value);
     }
   } else if (dataType == DataType::INT_4) {
-    _r.data32.clear();
-    for (int i = 0; i < length; i += 4) {
-      _r.data32.push_back(readInt32());
+    _r.data32.resize(length / 4);
+    std::memcpy(_r.data32.data(), data, length);
+    for (int32_t& value : _r.data32) {
+      value = be32toh(value);
     }
   } else if (dataType == DataType::REAL_8) {
-    _r.data64.clear();
-    for (int i = 0; i < length; i += 8) {
-      _r.data64.push_back(readReal8());
+    _r.data64.resize(length / 8);
+    for (double& value : _r.data64) {
+      uint64_t real8;
+      std::memcpy(&real8, data, sizeof(real8));
+      data += sizeof(real8);
+      value = real8_to_double(be64toh(real8));
     }
   } else if (dataType == DataType::ASCII_STRING
              || dataType == DataType::BIT_ARRAY) {
-    _r.data8.clear();
-    for (int i = 0; i < length; i++) {
-      _r.data8.push_back(readInt8());
-    }
+    _r.data8.assign(data, length);
   }
 
-  return static_cast<bool>(_file);
+  return true;
 }
 
 bool GDSReader::processLib()
@@ -3,6 +3,9 @@
 
 #include "odb/gdsout.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <ctime>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -15,6 +18,11 @@ GDSWriter::GDSWriter(utl::Logger* logger) : _logger(logger)
 {
 }
 
+void GDSWriter::setThreads(int num_threads)
+{
+  _num_threads = std::max(num_threads, 1);
+}
+
 void GDSWriter::write_gds(dbGDSLib* lib, const std::string& filename)
 {
   _lib = lib;
@@ -22,13 +30,21 @@ void GDSWriter::write_gds(dbGDSLib* lib, const std::string& filename)
   if (!_file) {
     _logger->error(ODB, 447, "Could not open file {}", filename);
   }
+  _buffer.reserve(_flush_size);
   writeLib();
+  flushBuffer();
   if (_file.is_open()) {
     _file.close();
   }
   _lib = nullptr;
 }
 
+void GDSWriter::flushBuffer()
+{
+  _file.write(_buffer.data(), _buffer.size());
+  _buffer.clear();
+}
+
 void GDSWriter::calcRecSize(record_t& r)
 {
   r.length = 4;
@@ -58,29 +74,36 @@ void GDSWriter::calcRecSize(record_t& r)
 void GDSWriter::writeReal8(double real)
 {
   const uint64_t value = htobe64(double_to_real8(real));
-  _file.write(reinterpret_cast<const char*>(&value), sizeof(uint64_t));
+  writeBytes(&value, sizeof(uint64_t));
 }
 
 void GDSWriter::writeInt32(int32_t i)
 {
   const int32_t value = htobe32(i);
-  _file.write(reinterpret_cast<const char*>(&value), sizeof(int32_t));
+  writeBytes(&value, sizeof(int32_t));
 }
 
 void GDSWriter::writeInt16(int16_t i)
 {
   const int16_t value = htobe16(i);
-  _file.write(reinterpret_cast<const char*>(&value), sizeof(int16_t));
+  writeBytes(&value, sizeof(int16_t));
 }
 
 void GDSWriter::writeInt8(int8_t i)
 {
-  _file.write(reinterpret_cast<const char*>(&i), sizeof(int8_t));
+  _buffer.push_back(i);
+}
+
+void GDSWriter::writeBytes(const void* data, size_t size)
+{
+  const char* bytes = static_cast<const char*>(data);
+  _buffer.insert(_buffer.end(), bytes, bytes + size);
 }
 
 void GDSWriter::writeRecord(record_t& r)
 {
   calcRecSize(r);
+  _buffer.reserve(_buffer.size() + r.length);
   writeInt16(r.length);
   writeInt8(fromRecordType(r.type));
   writeInt8(fromDataType(r.dataType));
@@ -106,7 +129,7 @@ void GDSWriter::writeRecord(record_t& r)
     }
     case DataType::ASCII_STRING:
     case DataType::BIT_ARRAY: {
-      _file.write(r.data8.c_str(), r.data8.size());
+      writeBytes(r.data8.data(), r.data8.size());
       break;
     }
     case DataType::NO_DATA: {
@@ -127,24 +150,21 @@ void GDSWriter::writeLib()
   rh.data16 = {600};
   writeRecord(rh);
 
+  const std::time_t now = std::time(nullptr);
+  const std::tm* lt = std::localtime(&now);
+  _timestamp = {(int16_t) lt->tm_year,
+                (int16_t) lt->tm_mon,
+                (int16_t) lt->tm_mday,
+                (int16_t) lt->tm_hour,
+                (int16_t) lt->tm_min,
+                (int16_t) lt->tm_sec};
+
   record_t r;
   r.type = RecordType::BGNLIB;
   r.dataType = DataType::INT_2;
-
-  const std::time_t now = std::time(nullptr);
-  const std::tm* lt = std::localtime(&now);
-  r.data16 = {(int16_t) lt->tm_year,
-              (int16_t) lt->tm_mon,
-              (int16_t) lt->tm_mday,
-              (int16_t) lt->tm_hour,
-              (int16_t) lt->tm_min,
-              (int16_t) lt->tm_sec,
-              (int16_t) lt->tm_year,
-              (int16_t) lt->tm_mon,
-              (int16_t) lt->tm_mday,
-              (int16_t) lt->tm_hour,
-              (int16_t) lt->tm_min,
-              (int16_t) lt->tm_sec};
+  // Modification and access time.
+  r.data16 = _timestamp;
+  r.data16.insert(r.data16.end(), _timestamp.begin(), _timestamp.end());
   writeRecord(r);
 
   record_t r2;
@@ -161,10 +181,7 @@ void GDSWriter::writeLib()
   r3.data64 = {units.first, units.second};
   writeRecord(r3);
 
-  auto structures = _lib->getGDSStructures();
-  for (auto s : structures) {
-    writeStruct(s);
-  }
+  writeStructs();
 
   record_t r4;
   r4.type = RecordType::ENDLIB;
@@ -172,26 +189,56 @@ void GDSWriter::writeLib()
   writeRecord(r4);
 }
 
+void GDSWriter::writeStructs()
+{
+  std::vector<dbGDSStructure*> structures;
+  for (dbGDSStructure* str : _lib->getGDSStructures()) {
+    structures.push_back(str);
+  }
+  if (_num_threads == 1) {
+    for (dbGDSStructure* str : structures) {
+      writeStruct(str);
+      if (_buffer.size() >= _flush_size) {
+        flushBuffer();
+      }
+    }
+    return;
+  }
+
+  // Structures are encoded independently into buffers of their own and
+  // written in library order. Encoding only reads the database. Working
+  // in waves bounds the memory held by encoded structures.
+  const int wave_size = _num_threads * 4;
+  const int count = structures.size();
+  std::vector<std::vector<char>> buffers(wave_size);
+  for (int wave_start = 0; wave_start < count; wave_start += wave_size) {
+    const int wave_end = std::min(wave_start + wave_size, count);
+#pragma omp parallel for num_threads(_num_threads) schedule(dynamic)
+    for (int i = wave_start; i < wave_end; i++) {
+      GDSWriter writer(_logger);
+      writer._lib = _lib;
+      writer._timestamp = _timestamp;
+      writer._buffer.swap(buffers[i - wave_start]);
+      writer.writeStruct(structures[i]);
+      buffers[i - wave_start].swap(writer._buffer);
+    }
+    flushBuffer();
+    for (int i = wave_start; i < wave_end; i++) {
+      std::vector<char>& buffer = buffers[i - wave_start];
+      _file.write(buffer.data(), buffer.size());
+      buffer.clear();
+    }
+  }
+}
+
 void GDSWriter::writeStruct(dbGDSStructure* str)
 {
   record_t r;
   r.type = RecordType::BGNSTR;
   r.dataType = DataType::INT_2;
 
-  std::time_t now = std::time(nullptr);
-  std::tm* lt = std::localtime(&now);
-  r.data16 = {(int16_t) lt->tm_year,
-              (int16_t) lt->tm_mon,
-              (int16_t) lt->tm_mday,
-              (int16_t) lt->tm_hour,
-              (int16_t) lt->tm_min,
-              (int16_t) lt->tm_sec,
-              (int16_t) lt->tm_year,
-              (int16_t) lt->tm_mon,
-              (int16_t) lt->tm_mday,
-              (int16_t) lt->tm_hour,
-              (int16_t) lt->tm_min,
-              (int16_t) lt->tm_sec};
+  r.data16 = _timestamp;
+  r.data16.insert(r.data16.end(), _timestamp.begin(), _timestamp.end());
   writeRecord(r);
 
   record_t r2;
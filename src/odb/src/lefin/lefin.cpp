@@ -9,13 +9,16 @@
 #include <cctype>
 #include <cstdio>
 #include <list>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "CellEdgeSpacingTableParser.h"
 #include "lefLayerPropParser.h"
 #include "lefMacroPropParser.h"
+#include "lefinGeometry.h"
 #include "lefiDebug.hpp"
 #include "lefiUtil.hpp"
 #include "lefrReader.hpp"
@@ -58,10 +61,13 @@ lefinReader::lefinReader(dbDatabase* db,
       _dbu_per_micron(1000),
       _override_lef_dbu(false),
       _master_modified(false),
-      _ignore_non_routing_layers(ignore_non_routing_layers)
+      _ignore_non_routing_layers(ignore_non_routing_layers),
+      _num_threads(1)
 {
 }
 
+lefinReader::~lefinReader() = default;
+
 void lefinReader::init()
 {
   _tech = nullptr;
@@ -76,6 +82,7 @@ void lefinReader::init()
   _master_cnt = 0;
   _via_cnt = 0;
   _errors = 0;
+  _pending_geoms.clear();
 
   if (!_override_lef_dbu) {
     _lef_units = 0;
@@ -111,69 +118,6 @@ void lefinReader::createLibrary()
   }
 }
 
-static void create_path_box(dbObject* obj,
-                            bool is_pin,
-                            dbTechLayer* layer,
-                            int dw,
-                            int designRuleWidth,
-                            int prev_x,
-                            int prev_y,
-                            int cur_x,
-                            int cur_y,
-                            utl::Logger* logger)
-{
-  int x1, x2, y1, y2;
-
-  if ((cur_x == prev_x) && (cur_y == prev_y)) {  // single point
-    x1 = cur_x - dw;
-    y1 = cur_y - dw;
-    x2 = cur_x + dw;
-    y2 = cur_y + dw;
-    dbBox* box;
-    if (is_pin)
-      box = dbBox::create((dbMPin*) obj, layer, x1, y1, x2, y2);
-    else
-      box = dbBox::create((dbMaster*) obj, layer, x1, y1, x2, y2);
-    box->setDesignRuleWidth(designRuleWidth);
-  } else if (cur_x == prev_x) {  // vert. path
-    x1 = cur_x - dw;
-    x2 = cur_x + dw;
-
-    if (cur_y > prev_y) {
-      y1 = prev_y - dw;
-      y2 = cur_y + dw;
-    } else {
-      y1 = cur_y - dw;
-      y2 = prev_y + dw;
-    }
-    dbBox* box;
-    if (is_pin)
-      box = dbBox::create((dbMPin*) obj, layer, x1, y1, x2, y2);
-    else
-      box = dbBox::create((dbMaster*) obj, layer, x1, y1, x2, y2);
-    box->setDesignRuleWidth(designRuleWidth);
-  } else if (cur_y == prev_y) {  // horiz. path
-    y1 = cur_y - dw;
-    y2 = cur_y + dw;
-
-    if (cur_x > prev_x) {
-      x1 = prev_x - dw;
-      x2 = cur_x + dw;
-    } else {
-      x1 = cur_x - dw;
-      x2 = prev_x + dw;
-    }
-    dbBox* box;
-    if (is_pin)
-      box = dbBox::create((dbMPin*) obj, layer, x1, y1, x2, y2);
-    else
-      box = dbBox::create((dbMaster*) obj, layer, x1, y1, x2, y2);
-    box->setDesignRuleWidth(designRuleWidth);
-  } else {
-    logger->warn(utl::ODB, 175, "illegal: non-orthogonal-path at Pin");
-  }
-}
-
 //
 // add geoms to master or terminal
 //
@@ -181,299 +125,33 @@ bool lefinReader::addGeoms(dbObject* object,
                            bool is_pin,
                            LefParser::lefiGeometries* geometry)
 {
-  int count = geometry->numItems();
-  dbTechLayer* layer = nullptr;
-  int dw = 0;
-  int designRuleWidth = -1;
-
-  for (int i = 0; i < count; i++) {
+  if (geometry->numItems() > 0) {
     _master_modified = true;
-
-    switch (geometry->itemType(i)) {
-      case LefParser::lefiGeomLayerE: {
-        layer = _tech->findLayer(geometry->getLayer(i));
-
-        if (layer == nullptr) {
-          _logger->warn(utl::ODB,
-                        176,
-                        "error: undefined layer ({}) referenced",
-                        geometry->getLayer(i));
-          return false;
-        }
-
-        dw = dbdist(layer->getWidth()) >> 1;
-        designRuleWidth = -1;
-        break;
-      }
-      case LefParser::lefiGeomWidthE: {
-        dw = dbdist(geometry->getWidth(i)) >> 1;
-        break;
-      }
-      case LefParser::lefiGeomPathE: {
-        LefParser::lefiGeomPath* path = geometry->getPath(i);
-
-        if (path->numPoints == 1) {
-          int x = dbdist(path->x[0]);
-          int y = dbdist(path->y[0]);
-          create_path_box(
-              object, is_pin, layer, dw, designRuleWidth, x, y, x, y, _logger);
-          break;
-        }
-
-        int prev_x = dbdist(path->x[0]);
-        int prev_y = dbdist(path->y[0]);
-        int j;
-
-        for (j = 1; j < path->numPoints; j++) {
-          int cur_x = dbdist(path->x[j]);
-          int cur_y = dbdist(path->y[j]);
-          create_path_box(object,
-                          is_pin,
-                          layer,
-                          dw,
-                          designRuleWidth,
-                          prev_x,
-                          prev_y,
-                          cur_x,
-                          cur_y,
-                          _logger);
-          prev_x = cur_x;
-          prev_y = cur_y;
-        }
-        break;
-      }
-      case LefParser::lefiGeomPathIterE: {
-        LefParser::lefiGeomPathIter* pathItr = geometry->getPathIter(i);
-        int j;
-        std::vector<Point> points;
-
-        for (j = 0; j < pathItr->numPoints; j++) {
-          int x = dbdist(pathItr->x[j]);
-          int y = dbdist(pathItr->y[j]);
-          points.push_back(Point(x, y));
-        }
-
-        int numX = lround(pathItr->xStart);
-        int numY = lround(pathItr->yStart);
-        int stepX = dbdist(pathItr->xStep);
-        int stepY = dbdist(pathItr->yStep);
-        int dx, dy, x_idx, y_idx;
-
-        for (dx = 0, x_idx = 0; x_idx < numX; ++x_idx, dx += stepX) {
-          for (dy = 0, y_idx = 0; y_idx < numY; ++y_idx, dy += stepY) {
-            if (points.size() == 1) {
-              Point p = points[0];
-              int x = p.getX() + dx;
-              int y = p.getY() + dy;
-              create_path_box(object,
-                              is_pin,
-                              layer,
-                              dw,
-                              designRuleWidth,
-                              x,
-                              y,
-                              x,
-                              y,
-                              _logger);
-              continue;
-            }
-
-            std::vector<Point>::iterator itr = points.begin();
-            Point p = *itr;
-            int prev_x = p.getX() + dx;
-            int prev_y = p.getY() + dy;
-
-            for (++itr; itr != points.end(); ++itr) {
-              Point c = *itr;
-              int cur_x = c.getX() + dx;
-              int cur_y = c.getY() + dy;
-              create_path_box(object,
-                              is_pin,
-                              layer,
-                              dw,
-                              designRuleWidth,
-                              cur_x,
-                              cur_y,
-                              prev_x,
-                              prev_y,
-                              _logger);
-              prev_x = cur_x;
-              prev_y = cur_y;
-            }
-          }
-        }
-        break;
-      }
-      case LefParser::lefiGeomRectE: {
-        LefParser::lefiGeomRect* rect = geometry->getRect(i);
-        int x1 = dbdist(rect->xl);
-        int y1 = dbdist(rect->yl);
-        int x2 = dbdist(rect->xh);
-        int y2 = dbdist(rect->yh);
-
-        dbBox* box;
-        if (is_pin)
-          box = dbBox::create((dbMPin*) object, layer, x1, y1, x2, y2);
-        else
-          box = dbBox::create((dbMaster*) object, layer, x1, y1, x2, y2);
-        box->setDesignRuleWidth(designRuleWidth);
-        break;
-      }
-      case LefParser::lefiGeomRectIterE: {
-        LefParser::lefiGeomRectIter* rectItr = geometry->getRectIter(i);
-        int x1 = dbdist(rectItr->xl);
-        int y1 = dbdist(rectItr->yl);
-        int x2 = dbdist(rectItr->xh);
-        int y2 = dbdist(rectItr->yh);
-        int numX = lround(rectItr->xStart);
-        int numY = lround(rectItr->yStart);
-        int stepX = dbdist(rectItr->xStep);
-        int stepY = dbdist(rectItr->yStep);
-        int dx, dy, x_idx, y_idx;
-
-        for (dx = 0, x_idx = 0; x_idx < numX; ++x_idx, dx += stepX) {
-          for (dy = 0, y_idx = 0; y_idx < numY; ++y_idx, dy += stepY) {
-            dbBox* box;
-            if (is_pin)
-              box = dbBox::create(
-                  (dbMPin*) object, layer, x1 + dx, y1 + dy, x2 + dx, y2 + dy);
-            else
-              box = dbBox::create((dbMaster*) object,
-                                  layer,
-                                  x1 + dx,
-                                  y1 + dy,
-                                  x2 + dx,
-                                  y2 + dy);
-            box->setDesignRuleWidth(designRuleWidth);
-          }
-        }
-        break;
-      }
-      case LefParser::lefiGeomPolygonE: {
-        createPolygon(
-            object, is_pin, layer, geometry->getPolygon(i), designRuleWidth);
-        break;
-      }
-      case LefParser::lefiGeomPolygonIterE: {
-        LefParser::lefiGeomPolygonIter* pItr = geometry->getPolygonIter(i);
-        LefParser::lefiGeomPolygon p;
-
-        p.numPoints = pItr->numPoints;
-        p.x = pItr->x;
-        p.y = pItr->y;
-
-        // An oddity of the LEF parser is that the count is stored
-        // in the start field.
-        int num_x = lround(pItr->xStart);
-        int num_y = lround(pItr->yStart);
-
-        for (int y = 0; y < num_y; y++) {
-          for (int x = 0; x < num_x; x++) {
-            createPolygon(object,
-                          is_pin,
-                          layer,
-                          &p,
-                          designRuleWidth,
-                          x * pItr->xStep,
-                          y * pItr->yStep);
-          }
-        }
-        break;
-      }
-      case LefParser::lefiGeomViaE: {
-        LefParser::lefiGeomVia* via = geometry->getVia(i);
-        dbTechVia* dbvia = _tech->findVia(via->name);
-
-        if (dbvia == nullptr) {
-          _logger->warn(
-              utl::ODB, 177, "error: undefined via ({}) referenced", via->name);
-          return false;
-        }
-
-        int x = dbdist(via->x);
-        int y = dbdist(via->y);
-
-        if (is_pin)
-          dbBox::create((dbMPin*) object, dbvia, x, y);
-        else
-          dbBox::create((dbMaster*) object, dbvia, x, y);
-
-        break;
-      }
-      case LefParser::lefiGeomViaIterE: {
-        LefParser::lefiGeomViaIter* viaItr = geometry->getViaIter(i);
-        dbTechVia* dbvia = _tech->findVia(viaItr->name);
-
-        if (dbvia == nullptr) {
-          _logger->warn(utl::ODB,
-                        178,
-                        "error: undefined via ({}) referenced",
-                        viaItr->name);
-          return false;
-        }
-
-        int x = dbdist(viaItr->x);
-        int y = dbdist(viaItr->y);
-        int numX = lround(viaItr->xStart);
-        int numY = lround(viaItr->yStart);
-        int stepX = dbdist(viaItr->xStep);
-        int stepY = dbdist(viaItr->yStep);
-        int dx, dy, x_idx, y_idx;
-
-        for (dx = 0, x_idx = 0; x_idx < numX; ++x_idx, dx += stepX) {
-          for (dy = 0, y_idx = 0; y_idx < numY; ++y_idx, dy += stepY) {
-            if (is_pin)
-              dbBox::create((dbMPin*) object, dbvia, x + dx, y + dy);
-            else
-              dbBox::create((dbMaster*) object, dbvia, x + dx, y + dy);
-          }
-        }
-        break;
-      }
-      case LefParser::lefiGeomLayerRuleWidthE: {
-        designRuleWidth = dbdist(geometry->getLayerRuleWidth(i));
-        break;
-      }
-      // FIXME??
-      case LefParser::lefiGeomUnknown:  // error
-      case LefParser::lefiGeomLayerExceptPgNetE:
-      case LefParser::lefiGeomLayerMinSpacingE:
-      case LefParser::lefiGeomClassE:
-
-      default:
-        break;
-    }
   }
 
-  return true;
+  auto geoms = std::make_unique<lefinGeometry>(object, is_pin, _dist_factor);
+  const bool ok = geoms->read(geometry, _tech, _logger);
+  _pending_geoms.push_back(std::move(geoms));
+  if (_num_threads <= 1) {
+    createGeoms();
+  }
+  return ok;
 }
 
-void lefinReader::createPolygon(dbObject* object,
-                                bool is_pin,
-                                dbTechLayer* layer,
-                                LefParser::lefiGeomPolygon* p,
-                                int design_rule_width,
-                                double offset_x,
-                                double offset_y)
+// The geometries of a batch of macros are expanded in parallel and then
+// created in LEF order so the db does not depend on the thread count.
+void lefinReader::createGeoms()
 {
-  std::vector<Point> points;
-
-  for (int j = 0; j < p->numPoints; ++j) {
-    int x = dbdist(p->x[j] + offset_x);
-    int y = dbdist(p->y[j] + offset_y);
-    points.push_back(Point(x, y));
+  const int num_geoms = _pending_geoms.size();
+#pragma omp parallel for num_threads(_num_threads) schedule(dynamic)
+  for (int i = 0; i < num_geoms; i++) {
+    _pending_geoms[i]->expand();
   }
 
-  dbPolygon* pbox = nullptr;
-  if (is_pin) {
-    pbox = dbPolygon::create((dbMPin*) object, layer, points);
-  } else {
-    pbox = dbPolygon::create((dbMaster*) object, layer, points);
-  }
-
-  if (pbox != nullptr) {
-    pbox->setDesignRuleWidth(design_rule_width);
+  for (auto& geoms : _pending_geoms) {
+    geoms->create(_logger);
   }
+  _pending_geoms.clear();
 }
 
 void lefinReader::antenna(lefinReader::AntennaType /* unused: type */,
@@ -1253,6 +931,9 @@ void lefinReader::macroEnd(const char* /* unused: macroName */)
     _master = nullptr;
     _master_cnt++;
   }
+  if (_pending_geoms.size() >= _max_pending_geoms) {
+    createGeoms();
+  }
 }
 
 void lefinReader::manufacturing(double num)
@@ -1402,18 +1083,6 @@ void lefinReader::obstruction(LefParser::lefiObstruction* obs)
 
   if (geometries->numItems()) {
     addGeoms(_master, false, geometries);
-    dbSet<dbPolygon> poly_obstructions = _master->getPolygonObstructions();
-
-    // Reverse the stored order to match the created order.
-    if (poly_obstructions.reversible() && poly_obstructions.orderReversed()) {
-      poly_obstructions.reverse();
-    }
-
-    dbSet<dbBox> obstructions = _master->getObstructions();
-
-    // Reverse the stored order to match the created order.
-    if (obstructions.reversible() && obstructions.orderReversed())
-      obstructions.reverse();
   }
 }
 
@@ -1624,15 +1293,6 @@ void lefinReader::pin(LefParser::lefiPin* pin)
       dbMPin* dbpin = dbMPin::create(term);
       created_mpins = true;
       addGeoms(dbpin, true, geometries);
-
-      dbSet<dbPolygon> poly_geoms = dbpin->getPolygonGeometry();
-      if (poly_geoms.reversible() && poly_geoms.orderReversed()) {
-        poly_geoms.reverse();
-      }
-
-      dbSet<dbBox> geoms = dbpin->getGeometry();
-      if (geoms.reversible() && geoms.orderReversed())
-        geoms.reverse();
     }
   }
 
@@ -2155,6 +1815,7 @@ bool lefinReader::readLef(const char* lef_file)
 bool lefinReader::readLefInner(const char* lef_file)
 {
   bool r = lefin_parse(this, _logger, lef_file);
+  createGeoms();
   for (auto& [obj, name] : _incomplete_props) {
     auto layer = _tech->findLayer(name.c_str());
     switch (obj->getObjectType()) {
@@ -2431,6 +2092,11 @@ int lefin::dbdist(double value)
   return _reader->dbdist(value);
 }
 
+void lefin::setThreads(int num_threads)
+{
+  _reader->setThreads(num_threads);
+}
+
 dbTech* lefin::createTech(const char* name, const char* lef_file)
 {
   std::lock_guard<std::mutex> lock(_lef_mutex);
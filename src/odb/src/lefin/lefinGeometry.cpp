@@ -0,0 +1,371 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#include "lefinGeometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "lefiMisc.hpp"
+#include "odb/db.h"
+#include "utl/Logger.h"
+
+namespace odb {
+
+lefinGeometry::lefinGeometry(dbObject* owner, bool is_pin, double dist_factor)
+    : owner_(owner), is_pin_(is_pin), dist_factor_(dist_factor)
+{
+}
+
+void lefinGeometry::addItem(ItemType type,
+                            dbTechLayer* layer,
+                            int half_width,
+                            int design_rule_width)
+{
+  Item item{};
+  item.type = type;
+  item.layer = layer;
+  item.via = nullptr;
+  item.half_width = half_width;
+  item.design_rule_width = design_rule_width;
+  item.num_x = 1;
+  item.num_y = 1;
+  items_.push_back(std::move(item));
+}
+
+bool lefinGeometry::read(LefParser::lefiGeometries* geometry,
+                         dbTech* tech,
+                         utl::Logger* logger)
+{
+  int count = geometry->numItems();
+  dbTechLayer* layer = nullptr;
+  int dw = 0;
+  int designRuleWidth = -1;
+
+  for (int i = 0; i < count; i++) {
+    switch (geometry->itemType(i)) {
+      case LefParser::lefiGeomLayerE: {
+        layer = tech->findLayer(geometry->getLayer(i));
+
+        if (layer == nullptr) {
+          logger->warn(utl::ODB,
+                       176,
+                       "error: undefined layer ({}) referenced",
+                       geometry->getLayer(i));
+          return false;
+        }
+
+        dw = dbdist(layer->getWidth()) >> 1;
+        designRuleWidth = -1;
+        break;
+      }
+      case LefParser::lefiGeomWidthE: {
+        dw = dbdist(geometry->getWidth(i)) >> 1;
+        break;
+      }
+      case LefParser::lefiGeomPathE: {
+        LefParser::lefiGeomPath* path = geometry->getPath(i);
+        addItem(PATH, layer, dw, designRuleWidth);
+        Item& item = items_.back();
+        item.x.assign(path->x, path->x + path->numPoints);
+        item.y.assign(path->y, path->y + path->numPoints);
+        break;
+      }
+      case LefParser::lefiGeomPathIterE: {
+        LefParser::lefiGeomPathIter* pathItr = geometry->getPathIter(i);
+        addItem(PATH, layer, dw, designRuleWidth);
+        Item& item = items_.back();
+        item.x.assign(pathItr->x, pathItr->x + pathItr->numPoints);
+        item.y.assign(pathItr->y, pathItr->y + pathItr->numPoints);
+        // An oddity of the LEF parser is that the count is stored
+        // in the start field.
+        item.num_x = lround(pathItr->xStart);
+        item.num_y = lround(pathItr->yStart);
+        item.step_x = pathItr->xStep;
+        item.step_y = pathItr->yStep;
+        break;
+      }
+      case LefParser::lefiGeomRectE: {
+        LefParser::lefiGeomRect* rect = geometry->getRect(i);
+        addItem(RECT, layer, dw, designRuleWidth);
+        Item& item = items_.back();
+        item.x = {rect->xl, rect->xh};
+        item.y = {rect->yl, rect->yh};
+        break;
+      }
+      case LefParser::lefiGeomRectIterE: {
+        LefParser::lefiGeomRectIter* rectItr = geometry->getRectIter(i);
+        addItem(RECT, layer, dw, designRuleWidth);
+        Item& item = items_.back();
+        item.x = {rectItr->xl, rectItr->xh};
+        item.y = {rectItr->yl, rectItr->yh};
+        item.num_x = lround(rectItr->xStart);
+        item.num_y = lround(rectItr->yStart);
+        item.step_x = rectItr->xStep;
+        item.step_y = rectItr->yStep;
+        break;
+      }
+      case LefParser::lefiGeomPolygonE: {
+        LefParser::lefiGeomPolygon* p = geometry->getPolygon(i);
+        addItem(POLYGON, layer, dw, designRuleWidth);
+        Item& item = items_.back();
+        item.x.assign(p->x, p->x + p->numPoints);
+        item.y.assign(p->y, p->y + p->numPoints);
+        break;
+      }
+      case LefParser::lefiGeomPolygonIterE: {
+        LefParser::lefiGeomPolygonIter* pItr = geometry->getPolygonIter(i);
+        addItem(POLYGON, layer, dw, designRuleWidth);
+        Item& item = items_.back();
+        item.x.assign(pItr->x, pItr->x + pItr->numPoints);
+        item.y.assign(pItr->y, pItr->y + pItr->numPoints);
+        item.num_x = lround(pItr->xStart);
+        item.num_y = lround(pItr->yStart);
+        item.step_x = pItr->xStep;
+        item.step_y = pItr->yStep;
+        break;
+      }
+      case LefParser::lefiGeomViaE: {
+        LefParser::lefiGeomVia* via = geometry->getVia(i);
+        dbTechVia* dbvia = tech->findVia(via->name);
+
+        if (dbvia == nullptr) {
+          logger->warn(
+              utl::ODB, 177, "error: undefined via ({}) referenced", via->name);
+          return false;
+        }
+
+        addItem(VIA, layer, dw, designRuleWidth);
+        Item& item = items_.back();
+        item.via = dbvia;
+        item.x = {via->x};
+        item.y = {via->y};
+        break;
+      }
+      case LefParser::lefiGeomViaIterE: {
+        LefParser::lefiGeomViaIter* viaItr = geometry->getViaIter(i);
+        dbTechVia* dbvia = tech->findVia(viaItr->name);
+
+        if (dbvia == nullptr) {
+          logger->warn(utl::ODB,
+                       178,
+                       "error: undefined via ({}) referenced",
+                       viaItr->name);
+          return false;
+        }
+
+        addItem(VIA, layer, dw, designRuleWidth);
+        Item& item = items_.back();
+        item.via = dbvia;
+        item.x = {viaItr->x};
+        item.y = {viaItr->y};
+        item.num_x = lround(viaItr->xStart);
+        item.num_y = lround(viaItr->yStart);
+        item.step_x = viaItr->xStep;
+        item.step_y = viaItr->yStep;
+        break;
+      }
+      case LefParser::lefiGeomLayerRuleWidthE: {
+        designRuleWidth = dbdist(geometry->getLayerRuleWidth(i));
+        break;
+      }
+      // FIXME??
+      case LefParser::lefiGeomUnknown:  // error
+      case LefParser::lefiGeomLayerExceptPgNetE:
+      case LefParser::lefiGeomLayerMinSpacingE:
+      case LefParser::lefiGeomClassE:
+
+      default:
+        break;
+    }
+  }
+
+  return true;
+}
+
+void lefinGeometry::addPathBox(const Item& item,
+                               int prev_x,
+                               int prev_y,
+                               int cur_x,
+                               int cur_y)
+{
+  const int dw = item.half_width;
+  if (cur_x == prev_x || cur_y == prev_y) {
+    // A single point, vertical or horizontal path.
+    const Rect rect(std::min(prev_x, cur_x) - dw,
+                    std::min(prev_y, cur_y) - dw,
+                    std::max(prev_x, cur_x) + dw,
+                    std::max(prev_y, cur_y) + dw);
+    shapes_.push_back({BOX, &item, rect, -1});
+  } else {
+    shapes_.push_back({NON_ORTHOGONAL_PATH, &item, Rect(), -1});
+  }
+}
+
+void lefinGeometry::expandPath(const Item& item)
+{
+  std::vector<Point> points;
+  points.reserve(item.x.size());
+  for (size_t j = 0; j < item.x.size(); j++) {
+    points.emplace_back(dbdist(item.x[j]), dbdist(item.y[j]));
+  }
+  if (points.empty()) {
+    return;
+  }
+
+  const int step_x = dbdist(item.step_x);
+  const int step_y = dbdist(item.step_y);
+  for (int x_idx = 0, dx = 0; x_idx < item.num_x; ++x_idx, dx += step_x) {
+    for (int y_idx = 0, dy = 0; y_idx < item.num_y; ++y_idx, dy += step_y) {
+      if (points.size() == 1) {
+        const int x = points[0].getX() + dx;
+        const int y = points[0].getY() + dy;
+        addPathBox(item, x, y, x, y);
+        continue;
+      }
+      for (size_t j = 1; j < points.size(); j++) {
+        addPathBox(item,
+                   points[j - 1].getX() + dx,
+                   points[j - 1].getY() + dy,
+                   points[j].getX() + dx,
+                   points[j].getY() + dy);
+      }
+    }
+  }
+}
+
+void lefinGeometry::expand()
+{
+  for (const Item& item : items_) {
+    switch (item.type) {
+      case PATH:
+        expandPath(item);
+        break;
+      case RECT: {
+        const int x1 = dbdist(item.x[0]);
+        const int y1 = dbdist(item.y[0]);
+        const int x2 = dbdist(item.x[1]);
+        const int y2 = dbdist(item.y[1]);
+        const int step_x = dbdist(item.step_x);
+        const int step_y = dbdist(item.step_y);
+        for (int x_idx = 0, dx = 0; x_idx < item.num_x; ++x_idx, dx += step_x) {
+          for (int y_idx = 0, dy = 0; y_idx < item.num_y;
+               ++y_idx, dy += step_y) {
+            const Rect rect(x1 + dx, y1 + dy, x2 + dx, y2 + dy);
+            shapes_.push_back({BOX, &item, rect, -1});
+          }
+        }
+        break;
+      }
+      case POLYGON: {
+        // Array offsets are applied before conversion to db units.
+        for (int y = 0; y < item.num_y; y++) {
+          for (int x = 0; x < item.num_x; x++) {
+            std::vector<Point> points;
+            points.reserve(item.x.size());
+            for (size_t j = 0; j < item.x.size(); ++j) {
+              points.emplace_back(dbdist(item.x[j] + x * item.step_x),
+                                  dbdist(item.y[j] + y * item.step_y));
+            }
+            shapes_.push_back(
+                {POLYGON_SHAPE, &item, Rect(), (int) polygons_.size()});
+            polygons_.push_back(std::move(points));
+          }
+        }
+        break;
+      }
+      case VIA: {
+        const int x = dbdist(item.x[0]);
+        const int y = dbdist(item.y[0]);
+        const int step_x = dbdist(item.step_x);
+        const int step_y = dbdist(item.step_y);
+        for (int x_idx = 0, dx = 0; x_idx < item.num_x; ++x_idx, dx += step_x) {
+          for (int y_idx = 0, dy = 0; y_idx < item.num_y;
+               ++y_idx, dy += step_y) {
+            const Rect origin(x + dx, y + dy, x + dx, y + dy);
+            shapes_.push_back({VIA_BOX, &item, origin, -1});
+          }
+        }
+        break;
+      }
+    }
+  }
+}
+
+void lefinGeometry::create(utl::Logger* logger)
+{
+  dbMPin* pin = is_pin_ ? (dbMPin*) owner_ : nullptr;
+  dbMaster* master = is_pin_ ? nullptr : (dbMaster*) owner_;
+
+  for (const Shape& shape : shapes_) {
+    const Item& item = *shape.item;
+    const Rect& r = shape.rect;
+    switch (shape.type) {
+      case BOX: {
+        dbBox* box;
+        if (is_pin_) {
+          box = dbBox::create(
+              pin, item.layer, r.xMin(), r.yMin(), r.xMax(), r.yMax());
+        } else {
+          box = dbBox::create(
+              master, item.layer, r.xMin(), r.yMin(), r.xMax(), r.yMax());
+        }
+        box->setDesignRuleWidth(item.design_rule_width);
+        break;
+      }
+      case VIA_BOX:
+        if (is_pin_) {
+          dbBox::create(pin, item.via, r.xMin(), r.yMin());
+        } else {
+          dbBox::create(master, item.via, r.xMin(), r.yMin());
+        }
+        break;
+      case POLYGON_SHAPE: {
+        const std::vector<Point>& points = polygons_[shape.polygon];
+        dbPolygon* pbox = nullptr;
+        if (is_pin_) {
+          pbox = dbPolygon::create(pin, item.layer, points);
+        } else {
+          pbox = dbPolygon::create(master, item.layer, points);
+        }
+        if (pbox != nullptr) {
+          pbox->setDesignRuleWidth(item.design_rule_width);
+        }
+        break;
+      }
+      case NON_ORTHOGONAL_PATH:
+        logger->warn(utl::ODB, 175, "illegal: non-orthogonal-path at Pin");
+        break;
+    }
+  }
+
+  // Reverse the stored order to match the created order.
+  if (is_pin_) {
+    dbSet<dbPolygon> poly_geoms = pin->getPolygonGeometry();
+    if (poly_geoms.reversible() && poly_geoms.orderReversed()) {
+      poly_geoms.reverse();
+    }
+    dbSet<dbBox> geoms = pin->getGeometry();
+    if (geoms.reversible() && geoms.orderReversed()) {
+      geoms.reverse();
+    }
+  } else {
+    dbSet<dbPolygon> poly_obstructions = master->getPolygonObstructions();
+    if (poly_obstructions.reversible() && poly_obstructions.orderReversed()) {
+      poly_obstructions.reverse();
+    }
+    dbSet<dbBox> obstructions = master->getObstructions();
+    if (obstructions.reversible() && obstructions.orderReversed()) {
+      obstructions.reverse();
+    }
+  }
+
+  shapes_.clear();
+  shapes_.shrink_to_fit();
+  polygons_.clear();
+  polygons_.shrink_to_fit();
+}
+
+}  // namespace odb
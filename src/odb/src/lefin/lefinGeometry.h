@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "odb/geom.h"
+
+namespace LefParser {
+class lefiGeometries;
+}
+
+namespace utl {
+class Logger;
+}
+
+namespace odb {
+
+class dbObject;
+class dbTech;
+class dbTechLayer;
+class dbTechVia;
+
+// Geometry of an OBS section or a PIN PORT, built in three steps:
+//  read   copies the parsed LEF items and resolves layers and vias,
+//  expand converts them to shapes in db units, unrolling arrays and
+//         paths; it only touches this object so geometries may be
+//         expanded in parallel,
+//  create makes the dbBoxes and dbPolygons in LEF order.
+class lefinGeometry
+{
+ public:
+  lefinGeometry(dbObject* owner, bool is_pin, double dist_factor);
+
+  // Returns false after warning about an undefined layer or via; the
+  // items before it are kept.
+  bool read(LefParser::lefiGeometries* geometries,
+            dbTech* tech,
+            utl::Logger* logger);
+  void expand();
+  void create(utl::Logger* logger);
+
+ private:
+  enum ItemType
+  {
+    PATH,
+    RECT,
+    POLYGON,
+    VIA
+  };
+
+  struct Item
+  {
+    ItemType type;
+    dbTechLayer* layer;
+    dbTechVia* via;
+    int half_width;
+    int design_rule_width;
+    // Path and polygon points, rect corners or via origin in microns.
+    std::vector<double> x;
+    std::vector<double> y;
+    // Array of num_x by num_y copies.
+    int num_x;
+    int num_y;
+    double step_x;
+    double step_y;
+  };
+
+  enum ShapeType
+  {
+    BOX,
+    VIA_BOX,
+    POLYGON_SHAPE,
+    NON_ORTHOGONAL_PATH
+  };
+
+  struct Shape
+  {
+    ShapeType type;
+    const Item* item;
+    // The box, or the via origin in its low corner.
+    Rect rect;
+    // Index into polygons_.
+    int polygon;
+  };
+
+  int dbdist(double value) const { return lround(value * dist_factor_); }
+  void addItem(ItemType type,
+               dbTechLayer* layer,
+               int half_width,
+               int design_rule_width);
+  void expandPath(const Item& item);
+  void addPathBox(const Item& item,
+                  int prev_x,
+                  int prev_y,
+                  int cur_x,
+                  int cur_y);
+
+  dbObject* owner_;
+  bool is_pin_;
+  double dist_factor_;
+  std::vector<Item> items_;
+  std::vector<Shape> shapes_;
+  std::vector<std::vector<Point>> polygons_;
+};
+
+}  // namespace odb
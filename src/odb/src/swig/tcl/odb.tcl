@@ -681,6 +681,96 @@ proc design_is_routed { args } {
   return [$block designIsRouted [info exists flags(-verbose)]]
 }
 
+sta::define_cmd_args "report_db_memory" {}
+
+proc report_db_memory { args } {
+  sta::parse_key_args "report_db_memory" args keys {} flags {}
+  sta::check_argc_eq0 "report_db_memory" $args
+
+  [ord::get_db] report
+}
+
+sta::define_cmd_args "compact_db_tables" {}
+
+proc compact_db_tables { args } {
+  sta::parse_key_args "compact_db_tables" args keys {} flags {}
+  sta::check_argc_eq0 "compact_db_tables" $args
+
+  set db [ord::get_db]
+  set chip [$db getChip]
+  if { $chip == "NULL" } {
+    utl::error ODB 1124 "please load the design before trying to use this command."
+  }
+  set block [$chip getBlock]
+  set released [$block compactTables]
+  utl::info ODB 1125 "Released [expr $released / 1024] KB from the object tables."
+}
+
+sta::define_cmd_args "set_db_name_index" {enable}
+
+proc set_db_name_index { args } {
+  sta::parse_key_args "set_db_name_index" args keys {} flags {}
+  sta::check_argc_eq1 "set_db_name_index" $args
+  set enable [lindex $args 0]
+  if { ![string is boolean -strict $enable] } {
+    utl::error ODB 1127 "set_db_name_index argument must be a boolean."
+  }
+
+  set db [ord::get_db]
+  set chip [$db getChip]
+  if { $chip == "NULL" } {
+    utl::error ODB 1128 "please load the design before trying to use this command."
+  }
+  [$chip getBlock] setNameIndexEnabled [expr { $enable ? 1 : 0 }]
+}
+
+sta::define_cmd_args "begin_checkpoints" {base_file}
+
+proc begin_checkpoints { args } {
+  sta::parse_key_args "begin_checkpoints" args keys {} flags {}
+  sta::check_argc_eq1 "begin_checkpoints" $args
+  set base_file [file nativename [lindex $args 0]]
+  odb::dbDatabase_beginCheckpoints [odb::checkpoint_block] $base_file
+}
+
+sta::define_cmd_args "write_checkpoint" {[-compact]}
+
+proc write_checkpoint { args } {
+  sta::parse_key_args "write_checkpoint" args keys {} flags {-compact}
+  sta::check_argc_eq0 "write_checkpoint" $args
+  set block [odb::checkpoint_block]
+  if { [info exists flags(-compact)] } {
+    odb::dbDatabase_compactCheckpoints $block
+  } else {
+    odb::dbDatabase_writeCheckpoint $block
+  }
+}
+
+sta::define_cmd_args "end_checkpoints" {}
+
+proc end_checkpoints { args } {
+  sta::parse_key_args "end_checkpoints" args keys {} flags {}
+  sta::check_argc_eq0 "end_checkpoints" $args
+  odb::dbDatabase_endCheckpoints [odb::checkpoint_block]
+}
+
+sta::define_cmd_args "read_checkpoint" {base_file}
+
+proc read_checkpoint { args } {
+  sta::parse_key_args "read_checkpoint" args keys {} flags {}
+  sta::check_argc_eq1 "read_checkpoint" $args
+  set base_file [file nativename [lindex $args 0]]
+  if { ![file readable $base_file] } {
+    utl::error ODB 1132 "$base_file is not readable."
+  }
+  set db [ord::get_db]
+  set chip [$db getChip]
+  if { $chip != "NULL" && [$chip getBlock] != "NULL" } {
+    utl::error ODB 1133 "read_checkpoint needs an empty database."
+  }
+  odb::dbDatabase_readCheckpoint $db $base_file
+}
+
 sta::define_cmd_args "set_io_pin_constraint" {[-direction direction] \
                                               [-pin_names names] \
                                               [-region region] \
@@ -908,4 +998,12 @@ proc get_block {} {
   set chip [$db getChip]
   return [$chip getBlock]
 }
+
+proc checkpoint_block {} {
+  set chip [[ord::get_db] getChip]
+  if { $chip == "NULL" } {
+    utl::error ODB 1131 "please load the design before trying to use this command."
+  }
+  return [$chip getBlock]
+}
 }
@@ -0,0 +1,49 @@
+# begin_checkpoints/write_checkpoint/read_checkpoint on gcd: an undone eco
+# adds nothing to the journal, a routing edit rewrites the base and the
+# journal is replayed on read
+source "helpers.tcl"
+
+read_lef "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+read_def "data/gcd/gcd_nangate45_route.def"
+
+set db [ord::get_db]
+set block [ord::get_db_block]
+set buf [$db findMaster BUF_X1]
+set base [make_result_file "checkpoints.odb"]
+set journal "$base.journal"
+
+begin_checkpoints $base
+odb::dbInst_create $block $buf "ckpt_buf1"
+write_checkpoint
+set size [file size $journal]
+
+# Routing is not journaled so the checkpoint rewrites the base.
+odb::dbWire_destroy [[$block findNet "_000_"] getWire]
+write_checkpoint
+puts "journal reset: [expr {[file size $journal] < $size}]"
+
+odb::dbInst_create $block $buf "ckpt_buf2"
+write_checkpoint
+set size [file size $journal]
+
+# An eco undone right after it ends cancels out.
+odb::dbDatabase_beginEco $block
+odb::dbInst_create $block $buf "ckpt_undone"
+odb::dbDatabase_endEco $block
+odb::dbDatabase_undoEco $block
+write_checkpoint
+puts "undone eco journaled: [expr {[file size $journal] != $size}]"
+end_checkpoints
+
+odb::dbChip_destroy [$db getChip]
+tee -quiet -variable log "read_checkpoint $base"
+regexp {Replayed (\d+) checkpoint journal segments} $log -> segments
+puts "replayed segments: $segments"
+set block [ord::get_db_block]
+foreach name {ckpt_buf1 ckpt_buf2 ckpt_undone} {
+  puts "$name: [expr {[$block findInst $name] != "NULL"}]"
+}
+puts "_000_ routed: [expr {[[$block findNet "_000_"] getWire] != "NULL"}]"
+
+puts "pass"
+exit 0
@@ -0,0 +1,84 @@
+#define BOOST_TEST_MODULE TestBlockSnapshot
+#include <boost/test/included/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "helper.h"
+#include "odb/db.h"
+#include "odb/dbBlockSnapshot.h"
+
+namespace odb {
+namespace {
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(test_concurrent_lookup)
+{
+  dbDatabase* db = createSimpleDB();
+  dbBlock* block = db->getChip()->getBlock();
+  dbMaster* and2 = db->findMaster("and2");
+  constexpr int size = 5000;
+  for (int i = 0; i < size; i++) {
+    const std::string name = "i" + std::to_string(i);
+    dbInst* inst = dbInst::create(block, and2, name.c_str());
+    dbNet* net = dbNet::create(block, ("n" + std::to_string(i)).c_str());
+    inst->findITerm("o")->connect(net);
+  }
+
+  dbBlockSnapshot snapshot(block);
+  std::atomic<int> errors = 0;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    // Boost.Test assertions are not thread-safe, so just count errors.
+    threads.emplace_back([&snapshot, &errors, t] {
+      if (snapshot.getInsts().size() != size) {
+        errors++;
+      }
+      for (int i = t; i < size; i += 4) {
+        const std::string name = "i" + std::to_string(i);
+        dbInst* inst = snapshot.findInst(name.c_str());
+        dbNet* net = snapshot.findNet(("n" + std::to_string(i)).c_str());
+        dbITerm* iterm = snapshot.findITerm((name + "/o").c_str());
+        if (inst == nullptr || net == nullptr || iterm == nullptr
+            || iterm->getInst() != inst || iterm->getNet() != net) {
+          errors++;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  BOOST_TEST(errors == 0);
+  BOOST_TEST(snapshot.getNets().size() == size);
+}
+
+BOOST_AUTO_TEST_CASE(test_write_lock_waits)
+{
+  dbDatabase* db = createSimpleDB();
+  dbBlock* block = db->getChip()->getBlock();
+  std::atomic<bool> written = false;
+  std::thread writer;
+  {
+    dbBlockSnapshot snapshot(block);
+    writer = std::thread([block, &written] {
+      dbBlockWriteLock lock(block);
+      dbNet::create(block, "late");
+      written = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    BOOST_TEST(!written);
+    BOOST_TEST(snapshot.findNet("late") == nullptr);
+  }
+  writer.join();
+  BOOST_TEST(written);
+  BOOST_TEST(block->findNet("late") != nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
+}  // namespace odb
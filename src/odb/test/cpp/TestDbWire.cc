@@ -11,6 +11,7 @@
 #include "gtest/gtest.h"
 #include "odb/db.h"
 #include "odb/dbWireCodec.h"
+#include "odb/dbWireGeometry.h"
 #include "odb/lefin.h"
 #include "utl/Logger.h"
 
@@ -135,4 +136,59 @@ TEST_F(OdbMultiPatternedTest, WireColorIsClearedOnNewPath)
   EXPECT_EQ(decoder.getColor().value(), /*mask_color=*/2);
 }
 
+TEST_F(OdbMultiPatternedTest, WireGeometryIsCachedUntilWireChanges)
+{
+  // Arrange
+  dbNet* net0 = dbNet::create(block_.get(), "net0");
+  dbNet* net1 = dbNet::create(block_.get(), "net1");
+  dbTech* tech = lib_->getTech();
+  dbTechLayer* met1 = tech->findLayer("met1");
+  dbTechLayer* met2 = tech->findLayer("met2");
+  dbTechVia* met1_met2 = tech->findVia("M1M2_PR_MR");
+
+  dbWireEncoder encoder;
+  encoder.begin(dbWire::create(net0));
+  encoder.newPath(met1, dbWireType::ROUTED);
+  encoder.addPoint(50, 50);
+  encoder.addPoint(100, 50);
+  encoder.addTechVia(met1_met2);
+  encoder.addPoint(100, 150);
+  encoder.end();
+
+  dbWire* wire1 = dbWire::create(net1);
+  encoder.begin(wire1);
+  encoder.newPath(met1, dbWireType::ROUTED);
+  encoder.addPoint(50, 300);
+  encoder.addPoint(200, 300);
+  encoder.end();
+
+  // Act
+  const dbWireGeometry& geometry = block_->getWireGeometry(/*num_threads=*/2);
+
+  // Assert
+  const dbWireLayerGeometry& m1 = geometry.layers[met1->getNumber()];
+  const dbWireLayerGeometry& m2 = geometry.layers[met2->getNumber()];
+  EXPECT_EQ(m1.layer, met1);
+  ASSERT_EQ(m1.segments.size(), 2);
+  EXPECT_EQ(m1.segments.net_ids[0], net0->getId());
+  EXPECT_EQ(m1.segments.net_ids[1], net1->getId());
+  EXPECT_EQ(m1.segments.xlo[1], 50 - met1->getWidth() / 2);
+  EXPECT_EQ(m1.segments.xhi[1], 200 + met1->getWidth() / 2);
+  ASSERT_EQ(m1.vias.size(), 1);
+  EXPECT_EQ(m1.vias.vias[0], met1_met2);
+  EXPECT_EQ(m2.segments.size(), 1);
+  EXPECT_EQ(&block_->getWireGeometry(), &geometry);
+
+  // Editing a wire drops the cached geometry.
+  encoder.begin(wire1);
+  encoder.newPath(met2, dbWireType::ROUTED);
+  encoder.addPoint(50, 300);
+  encoder.addPoint(50, 400);
+  encoder.end();
+
+  const dbWireGeometry& updated = block_->getWireGeometry();
+  EXPECT_EQ(updated.layers[met1->getNumber()].segments.size(), 1);
+  EXPECT_EQ(updated.layers[met2->getNumber()].segments.size(), 2);
+}
+
 }  // namespace odb
@@ -202,6 +202,45 @@ BOOST_AUTO_TEST_CASE(edit)
   BOOST_TEST(ref_str == str1_read);
 }
 
+BOOST_AUTO_TEST_CASE(threaded_writer)
+{
+  dbDatabase* db = dbDatabase::create();
+  dbGDSLib* lib = createEmptyGDSLib(db, "threads_lib");
+
+  const int num_structs = 50;
+  for (int i = 0; i < num_structs; i++) {
+    dbGDSStructure* str
+        = dbGDSStructure::create(lib, ("str" + std::to_string(i)).c_str());
+    for (int j = 0; j <= i; j++) {
+      dbGDSBox* box = dbGDSBox::create(str);
+      box->setLayer(i);
+      box->setDatatype(j);
+      box->setBounds({0, 0, 10 * (j + 1), 10 * (i + 1)});
+    }
+  }
+
+  std::string outpath = testTmpPath("results", "threaded_writer_out.gds");
+
+  auto logger = std::make_unique<utl::Logger>();
+  GDSWriter writer(logger.get());
+  writer.setThreads(4);
+  writer.write_gds(lib, outpath);
+
+  GDSReader reader(logger.get());
+  dbGDSLib* lib2 = reader.read_gds(outpath, db);
+
+  BOOST_TEST(lib2->getGDSStructures().size() == num_structs);
+  int i = 0;
+  for (dbGDSStructure* str : lib2->getGDSStructures()) {
+    BOOST_TEST(str->getName() == "str" + std::to_string(i));
+    BOOST_TEST(str->getGDSBoxs().size() == i + 1);
+    dbGDSBox* box = *str->getGDSBoxs().begin();
+    BOOST_TEST(box->getLayer() == i);
+    BOOST_TEST(box->getBounds() == Rect(0, 0, 10, 10 * (i + 1)));
+    i++;
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace
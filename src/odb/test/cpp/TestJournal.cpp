@@ -1,8 +1,11 @@
 #define BOOST_TEST_MODULE TestJournal
+#include <algorithm>
 #include <boost/test/included/unit_test.hpp>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "env.h"
 #include "helper.h"
@@ -196,6 +199,127 @@ BOOST_FIXTURE_TEST_CASE(test_undo_iterm_disconnect, F_DEFAULT)
   BOOST_TEST(iterm->getNet() == net);
 }
 
+BOOST_FIXTURE_TEST_CASE(test_checkpoint_replay, F_DEFAULT)
+{
+  std::string path = testTmpPath("results", "TestJournalCheckpoint.odb");
+  dbDatabase::beginCheckpoints(block, path.c_str());
+
+  auto inst = dbInst::create(block, and2, "a");
+  auto net = dbNet::create(block, "n");
+  inst->findITerm("b")->connect(net);
+  dbDatabase::writeCheckpoint(block);
+
+  // Nested ecos are replayed whether undone or kept.
+  in_eco([&]() { dbInst::create(block, or2, "b"); });
+  dbDatabase::beginEco(block);
+  dbInst::create(block, or2, "c");
+  dbDatabase::endEco(block);
+  inst->setOrigin(100, 200);
+  dbDatabase::writeCheckpoint(block);
+  dbDatabase::endCheckpoints(block);
+
+  dbDatabase* db2 = dbDatabase::create();
+  dbBlock* block2 = dbDatabase::readCheckpoint(db2, path.c_str());
+  dbInst* inst2 = block2->findInst("a");
+  BOOST_TEST_REQUIRE(inst2 != nullptr);
+  BOOST_TEST(inst2->findITerm("b")->getNet() == block2->findNet("n"));
+  BOOST_TEST(inst2->getOrigin() == Point(100, 200));
+  BOOST_TEST(block2->findInst("b") == nullptr);
+  BOOST_TEST(block2->findInst("c") != nullptr);
+
+  // Compacting folds the journal into the base.
+  dbInst::destroy(inst2);
+  dbDatabase::compactCheckpoints(block2);
+  dbDatabase::endCheckpoints(block2);
+  dbDatabase::destroy(db2);
+
+  dbDatabase* db3 = dbDatabase::create();
+  dbBlock* block3 = dbDatabase::readCheckpoint(db3, path.c_str());
+  BOOST_TEST(block3->findInst("a") == nullptr);
+  BOOST_TEST(block3->findInst("c") != nullptr);
+  dbDatabase::destroy(db3);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_compact_tables, F_DEFAULT)
+{
+  std::vector<dbInst*> insts;
+  for (int i = 0; i < 300; ++i) {
+    insts.push_back(dbInst::create(block, and2, std::to_string(i).c_str()));
+  }
+  dbInst* keep = insts[5];
+  for (dbInst* inst : insts) {
+    if (inst != keep) {
+      dbInst::destroy(inst);
+    }
+  }
+
+  // Journals rely on the free lists so ecos block compaction.
+  dbDatabase::beginEco(block);
+  BOOST_TEST(block->compactTables() == 0);
+  dbDatabase::endEco(block);
+  dbDatabase::commitEco(block);
+
+  BOOST_TEST(block->compactTables() > 0);
+  BOOST_TEST(block->findInst("5") == keep);
+  BOOST_TEST(block->getInsts().size() == 1);
+  BOOST_TEST(dbInst::create(block, and2, "a")->getId() == 1);
+  BOOST_TEST(dbInst::create(block, and2, "b")->getId() == 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_compact_interior_pages, F_DEFAULT)
+{
+  std::vector<dbInst*> insts;
+  for (int i = 0; i < 1000; ++i) {
+    const std::string name = "i" + std::to_string(i);
+    insts.push_back(dbInst::create(block, and2, name.c_str()));
+  }
+  block->compactTables();
+
+  // Empty whole pages in the middle of the tables; the top stays in use.
+  for (int i = 200; i < 800; ++i) {
+    dbInst::destroy(insts[i]);
+  }
+  BOOST_TEST(block->compactTables() > 0);
+  BOOST_TEST(block->compactTables() == 0);
+  BOOST_TEST(block->getInsts().size() == 400);
+  BOOST_TEST(block->findInst("i999")->getId() == 1000);
+  for (dbInst* inst : block->getInsts()) {
+    BOOST_TEST((inst->getId() <= 200 || inst->getId() > 800));
+  }
+
+  // Released pages are written as free objects and ids are kept.
+  std::string path = testTmpPath("results", "TestJournalCompact.odb");
+  std::ofstream write;
+  write.exceptions(std::ifstream::failbit | std::ifstream::badbit
+                   | std::ios::eofbit);
+  write.open(path, std::ios::binary);
+  db->write(write);
+  write.close();
+
+  dbDatabase* db2 = dbDatabase::create();
+  std::ifstream read;
+  read.exceptions(std::ifstream::failbit | std::ifstream::badbit
+                  | std::ios::eofbit);
+  read.open(path, std::ios::binary);
+  db2->read(read);
+  dbBlock* block2 = db2->getChip()->getBlock();
+  BOOST_TEST(block2->getInsts().size() == 400);
+  BOOST_TEST(block2->findInst("i999")->getId() == 1000);
+  BOOST_TEST(block2->findInst("i0")->findITerm("a") != nullptr);
+  dbDatabase::destroy(db2);
+
+  // Released pages are refilled before the tables grow.
+  BOOST_TEST(dbInst::create(block, and2, "a")->getId() == 201);
+  uint max_id = 0;
+  for (int i = 0; i < 599; ++i) {
+    const std::string name = "b" + std::to_string(i);
+    dbInst* inst = dbInst::create(block, and2, name.c_str());
+    max_id = std::max(max_id, inst->getId());
+  }
+  BOOST_TEST(max_id == 1000);
+  BOOST_TEST(block->getInsts().size() == 1000);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace
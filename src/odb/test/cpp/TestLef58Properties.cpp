@@ -4,6 +4,8 @@
 #include <boost/test/included/unit_test.hpp>
 #include <fstream>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "env.h"
 #include "odb/db.h"
@@ -553,6 +555,64 @@ BOOST_AUTO_TEST_CASE(test_default)
               && !edge_spc->isOptional() && !edge_spc->isSoft()));
 }
 
+// Shapes of every master in creation order, as text.
+static std::vector<std::string> masterShapes(dbDatabase* db)
+{
+  std::vector<std::string> shapes;
+  auto add = [&shapes](const std::string& owner, dbBox* box) {
+    const Rect r = box->getBox();
+    shapes.push_back(owner + " " + std::to_string(r.xMin()) + " "
+                     + std::to_string(r.yMin()) + " "
+                     + std::to_string(r.xMax()) + " "
+                     + std::to_string(r.yMax()));
+  };
+  for (dbLib* lib : db->getLibs()) {
+    for (dbMaster* master : lib->getMasters()) {
+      for (dbBox* box : master->getObstructions()) {
+        add(master->getName(), box);
+      }
+      for (dbPolygon* polygon : master->getPolygonObstructions()) {
+        for (dbBox* box : polygon->getGeometry()) {
+          add(master->getName() + " poly", box);
+        }
+      }
+      for (dbMTerm* mterm : master->getMTerms()) {
+        for (dbMPin* mpin : mterm->getMPins()) {
+          for (dbBox* box : mpin->getGeometry()) {
+            add(mterm->getName(), box);
+          }
+          for (dbPolygon* polygon : mpin->getPolygonGeometry()) {
+            for (dbBox* box : polygon->getGeometry()) {
+              add(mterm->getName() + " poly", box);
+            }
+          }
+        }
+      }
+    }
+  }
+  return shapes;
+}
+
+BOOST_AUTO_TEST_CASE(test_threads)
+{
+  utl::Logger* logger = new utl::Logger();
+  for (const char* file : {"gscl45nm.lef", "gscl45nm_polygon.lef"}) {
+    const std::string path = testTmpPath("data", file);
+    std::vector<std::string> shapes[2];
+    for (int i = 0; i < 2; i++) {
+      dbDatabase* db = dbDatabase::create();
+      db->setLogger(logger);
+      lefin lefParser(db, logger, false);
+      lefParser.setThreads(i == 0 ? 1 : 4);
+      lefParser.createTechAndLib("tech", file, path.c_str());
+      shapes[i] = masterShapes(db);
+      dbDatabase::destroy(db);
+    }
+    BOOST_TEST(!shapes[0].empty());
+    BOOST_TEST(shapes[0] == shapes[1], boost::test_tools::per_element());
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace odb
@@ -0,0 +1,142 @@
+#define BOOST_TEST_MODULE TestNameIndex
+#include <boost/test/included/unit_test.hpp>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "helper.h"
+#include "odb/db.h"
+
+namespace odb {
+namespace {
+
+std::string instName(int i)
+{
+  return "u_core/u_alu_" + std::to_string(i % 64) + "/g"
+         + std::to_string(i);
+}
+
+std::string netName(int i)
+{
+  return "u_core/n" + std::to_string(i);
+}
+
+dbBlock* createLargeBlock(int size, bool name_index = true)
+{
+  dbDatabase* db = createSimpleDB();
+  dbBlock* block = db->getChip()->getBlock();
+  dbMaster* and2 = db->findMaster("and2");
+  block->setNameIndexEnabled(name_index);
+  for (int i = 0; i < size; i++) {
+    dbInst::create(block, and2, instName(i).c_str());
+    dbNet::create(block, netName(i).c_str());
+  }
+  return block;
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(test_find)
+{
+  const int size = 20000;
+  dbBlock* block = createLargeBlock(size);
+
+  for (int i = 0; i < size; i++) {
+    dbInst* inst = block->findInst(instName(i).c_str());
+    BOOST_TEST_REQUIRE(inst != nullptr);
+    BOOST_TEST(inst->getName() == instName(i));
+    dbNet* net = block->findNet(netName(i).c_str());
+    BOOST_TEST_REQUIRE(net != nullptr);
+    BOOST_TEST(net->getName() == netName(i));
+  }
+  BOOST_TEST(block->findInst("u_core/u_alu_0/g") == nullptr);
+  BOOST_TEST(block->findNet("u_core/n") == nullptr);
+
+  dbITerm* iterm = block->findITerm((instName(7) + "/b").c_str());
+  BOOST_TEST_REQUIRE(iterm != nullptr);
+  BOOST_TEST(iterm->getInst() == block->findInst(instName(7).c_str()));
+  BOOST_TEST(iterm->getMTerm()->getName() == "b");
+  BOOST_TEST(block->findITerm((instName(7) + "/c").c_str()) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_update)
+{
+  const int size = 5000;
+  dbBlock* block = createLargeBlock(size);
+  // Build the index before editing.
+  BOOST_TEST(block->findInst(instName(0).c_str()) != nullptr);
+
+  dbInst* inst = block->findInst(instName(1).c_str());
+  BOOST_TEST(inst->rename("renamed"));
+  BOOST_TEST(block->findInst(instName(1).c_str()) == nullptr);
+  BOOST_TEST(block->findInst("renamed") == inst);
+
+  for (int i = 2; i < size; i += 2) {
+    dbInst::destroy(block->findInst(instName(i).c_str()));
+    dbNet::destroy(block->findNet(netName(i).c_str()));
+  }
+  dbMaster* and2 = block->getDb()->findMaster("and2");
+  for (int i = size; i < 2 * size; i++) {
+    dbInst::create(block, and2, instName(i).c_str());
+  }
+
+  for (int i = 2; i < 2 * size; i++) {
+    const bool exists = i >= size || i % 2 == 1;
+    BOOST_TEST((block->findInst(instName(i).c_str()) != nullptr) == exists);
+  }
+  for (int i = 2; i < size; i++) {
+    const bool exists = i % 2 == 1;
+    BOOST_TEST((block->findNet(netName(i).c_str()) != nullptr) == exists);
+  }
+
+  block->setNameIndexEnabled(false);
+  BOOST_TEST(block->findInst("renamed") == inst);
+  BOOST_TEST(block->findInst(instName(2).c_str()) == nullptr);
+}
+
+// Not a pass/fail test; prints lookup times with the index off, as
+// blocks start out, and after opting in the way set_db_name_index does.
+BOOST_AUTO_TEST_CASE(benchmark_lookup)
+{
+  const int size = 200000;
+  dbBlock* block = createLargeBlock(size, false);
+  std::vector<std::string> names;
+  names.reserve(size);
+  for (int i = 0; i < size; i++) {
+    names.push_back(instName((i * 7919) % size));
+  }
+
+  auto lookup = [&](const char* label) {
+    const auto start = std::chrono::steady_clock::now();
+    int found = 0;
+    for (int pass = 0; pass < 5; pass++) {
+      for (const std::string& name : names) {
+        found += block->findInst(name.c_str()) != nullptr;
+      }
+    }
+    const std::chrono::duration<double> elapsed
+        = std::chrono::steady_clock::now() - start;
+    BOOST_TEST(found == 5 * size);
+    printf("findInst %d lookups, index %s: %.3fs\n",
+           5 * size,
+           label,
+           elapsed.count());
+  };
+
+  lookup("off");
+  // The index is built on the first lookup after it is enabled, so that
+  // lookup pays for the build.
+  block->setNameIndexEnabled(true);
+  const auto start = std::chrono::steady_clock::now();
+  BOOST_TEST(block->findInst(names[0].c_str()) != nullptr);
+  const std::chrono::duration<double> elapsed
+      = std::chrono::steady_clock::now() - start;
+  printf("findInst index build: %.3fs\n", elapsed.count());
+  lookup("on");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
+}  // namespace odb
@@ -0,0 +1,39 @@
+# set_db_name_index keeps lookups consistent across edits
+source "helpers.tcl"
+
+read_lef "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+read_def "data/gcd/gcd_nangate45_route.def"
+
+set block [ord::get_db_block]
+set_db_name_index 1
+
+set mismatches 0
+foreach inst [$block getInsts] {
+  if { [$block findInst [$inst getName]] != $inst } {
+    incr mismatches
+  }
+}
+foreach net [$block getNets] {
+  if { [$block findNet [$net getName]] != $net } {
+    incr mismatches
+  }
+}
+puts "mismatches: $mismatches"
+
+set inst [lindex [$block getInsts] 10]
+set name [$inst getName]
+$inst rename "renamed_inst"
+puts "old name found: [expr { [$block findInst $name] != "NULL" }]"
+puts "new name found: [expr { [$block findInst renamed_inst] == $inst }]"
+
+set victim [lindex [$block getInsts] 20]
+set victim_name [$victim getName]
+odb::dbInst_destroy $victim
+puts "deleted found: [expr { [$block findInst $victim_name] != "NULL" }]"
+
+set_db_name_index 0
+puts "new name found: [expr { [$block findInst renamed_inst] == $inst }]"
+puts "deleted found: [expr { [$block findInst $victim_name] != "NULL" }]"
+
+puts "pass"
+exit 0
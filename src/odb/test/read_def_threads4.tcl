@@ -0,0 +1,20 @@
+# read_def with set_thread_count 4 creates the components in file order
+source "helpers.tcl"
+
+set_thread_count 4
+read_lef "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+read_def "data/gcd/gcd_nangate45_route.def"
+
+set dump_file [make_result_file "read_def_threads4.dump"]
+set stream [open $dump_file w]
+foreach inst [[ord::get_db_block] getInsts] {
+  set bbox [$inst getBBox]
+  puts $stream [list [$inst getId] [$inst getName] [[$inst getMaster] getName] \
+    [$inst getPlacementStatus] [$inst getOrient] [$bbox xMin] [$bbox yMin]]
+}
+close $stream
+
+diff_files $dump_file "read_def_threads.dumpok"
+
+puts "pass"
+exit 0
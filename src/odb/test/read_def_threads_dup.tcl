@@ -0,0 +1,32 @@
+# read_def with set_thread_count 4 reports a duplicate component created
+# on the pipeline worker as a regular error
+source "helpers.tcl"
+
+set num_comps 10000
+set def_file [make_result_file "read_def_threads_dup.def"]
+set stream [open $def_file w]
+puts $stream "VERSION 5.8 ;"
+puts $stream "DIVIDERCHAR \"/\" ;"
+puts $stream "BUSBITCHARS \"\[\]\" ;"
+puts $stream "DESIGN dup ;"
+puts $stream "UNITS DISTANCE MICRONS 2000 ;"
+puts $stream "DIEAREA ( 0 0 ) ( 1000000 1000000 ) ;"
+puts $stream "COMPONENTS [expr {$num_comps + 1}] ;"
+for {set i 0} {$i < $num_comps} {incr i} {
+  puts $stream "- u$i BUF_X1 ;"
+  # Lands in the second batch while the parser is still reading.
+  if {$i == 5000} {
+    puts $stream "- u10 BUF_X1 ;"
+  }
+}
+puts $stream "END COMPONENTS"
+puts $stream "END DESIGN"
+close $stream
+
+set_thread_count 4
+read_lef "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+catch {read_def $def_file} error
+puts $error
+
+puts "pass"
+exit 0
@@ -0,0 +1,43 @@
+# read_def with set_thread_count 4 on a COMPONENTS section larger than
+# the pipeline queue so batching and backpressure both run
+source "helpers.tcl"
+
+# 66 batches of 4096 components overruns the 64 batch queue.
+set num_comps 270000
+set def_file [make_result_file "read_def_threads_large.def"]
+set stream [open $def_file w]
+puts $stream "VERSION 5.8 ;"
+puts $stream "DIVIDERCHAR \"/\" ;"
+puts $stream "BUSBITCHARS \"\[\]\" ;"
+puts $stream "DESIGN large ;"
+puts $stream "UNITS DISTANCE MICRONS 2000 ;"
+puts $stream "DIEAREA ( 0 0 ) ( 1000000 1000000 ) ;"
+puts $stream "COMPONENTS $num_comps ;"
+for {set i 0} {$i < $num_comps} {incr i} {
+  puts $stream "- u$i BUF_X1 + PLACED ( [expr {($i % 1000) * 380}]\
+    [expr {($i / 1000) * 2800}] ) N ;"
+}
+puts $stream "END COMPONENTS"
+puts $stream "END DESIGN"
+close $stream
+
+set_thread_count 4
+read_lef "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+read_def $def_file
+
+set i 0
+set mismatches 0
+foreach inst [[ord::get_db_block] getInsts] {
+  set bbox [$inst getBBox]
+  if {[$inst getId] != $i + 1 || [$inst getName] != "u$i"
+      || [$bbox xMin] != ($i % 1000) * 380
+      || [$bbox yMin] != ($i / 1000) * 2800} {
+    incr mismatches
+  }
+  incr i
+}
+puts "components: $i"
+puts "out of order: $mismatches"
+
+puts "pass"
+exit 0
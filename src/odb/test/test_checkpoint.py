@@ -0,0 +1,72 @@
+import os
+import tempfile
+import odb
+import helper
+import odbUnitTest
+import unittest
+from openroad import Design
+
+
+class TestCheckpoint(odbUnitTest.TestCase):
+    def setUp(self):
+        self.db, self.lib = helper.createSimpleDB()
+        self.block = helper.create1LevelBlock(self.db, self.lib, self.db.getChip())
+        self.and2 = self.lib.findMaster("and2")
+        self.tmp_dir = tempfile.TemporaryDirectory()
+        self.base = os.path.join(self.tmp_dir.name, "checkpoint.odb")
+        self.journal = self.base + ".journal"
+
+    def tearDown(self):
+        self.db.destroy(self.db)
+        self.tmp_dir.cleanup()
+
+    def readBack(self):
+        db = Design.createDetachedDb()
+        return db, odb.dbDatabase.readCheckpoint(db, self.base)
+
+    def test_replay(self):
+        odb.dbDatabase.beginCheckpoints(self.block, self.base)
+        odb.dbInst.create(self.block, self.and2, "a")
+        odb.dbDatabase.writeCheckpoint(self.block)
+        odb.dbDatabase.endCheckpoints(self.block)
+        db, block = self.readBack()
+        self.assertIsNotNone(block.findInst("a"))
+        db.destroy(db)
+
+    def test_undone_eco(self):
+        odb.dbDatabase.beginCheckpoints(self.block, self.base)
+        size = os.path.getsize(self.journal)
+        odb.dbDatabase.beginEco(self.block)
+        undone_id = odb.dbInst.create(self.block, self.and2, "a").getId()
+        odb.dbDatabase.endEco(self.block)
+        odb.dbDatabase.undoEco(self.block)
+        odb.dbDatabase.writeCheckpoint(self.block)
+        self.assertEqual(os.path.getsize(self.journal), size)
+        # The next instance gets the id the undone one had, as it does on
+        # replay where the eco never ran.
+        inst = odb.dbInst.create(self.block, self.and2, "b")
+        self.assertEqual(inst.getId(), undone_id)
+        odb.dbDatabase.writeCheckpoint(self.block)
+        odb.dbDatabase.endCheckpoints(self.block)
+        db, block = self.readBack()
+        self.assertIsNone(block.findInst("a"))
+        self.assertEqual(block.findInst("b").getId(), undone_id)
+        db.destroy(db)
+
+    def test_unjournaled_edit(self):
+        odb.dbDatabase.beginCheckpoints(self.block, self.base)
+        odb.dbInst.create(self.block, self.and2, "a")
+        odb.dbDatabase.writeCheckpoint(self.block)
+        size = os.path.getsize(self.journal)
+        odb.dbWire.create(self.block.findNet("n1"))
+        odb.dbDatabase.writeCheckpoint(self.block)
+        self.assertLess(os.path.getsize(self.journal), size)
+        odb.dbDatabase.endCheckpoints(self.block)
+        db, block = self.readBack()
+        self.assertIsNotNone(block.findInst("a"))
+        self.assertIsNotNone(block.findNet("n1").getWire())
+        db.destroy(db)
+
+
+if __name__ == "__main__":
+    unittest.main()
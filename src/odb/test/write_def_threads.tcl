@@ -0,0 +1,25 @@
+# write_def with set_thread_count 4 matches the serial output
+source "helpers.tcl"
+
+set_thread_count 4
+read_lef "data/gscl45nm.lef"
+read_def "data/design.def"
+
+set out_def [make_result_file "write_def_threads.def"]
+write_def $out_def
+diff_files $out_def "write_lef_and_def.defok"
+
+# Compressed output goes through the same chunked writer.
+set out_def_gz [make_result_file "write_def_threads.def.gz"]
+write_def $out_def_gz
+set stream [open $out_def_gz rb]
+set def_text [zlib gunzip [read $stream]]
+close $stream
+set out_def_unzipped [make_result_file "write_def_threads_unzipped.def"]
+set stream [open $out_def_unzipped wb]
+puts -nonewline $stream $def_text
+close $stream
+diff_files $out_def_unzipped "write_lef_and_def.defok"
+
+puts "pass"
+exit 0
@@ -0,0 +1,52 @@
+# write_def with set_thread_count 4 matches the serial output on a design
+# with enough components and nets for several waves of chunks
+source "helpers.tcl"
+
+set num_comps 70000
+set def_file [make_result_file "write_def_threads_large_in.def"]
+set stream [open $def_file w]
+puts $stream "VERSION 5.8 ;"
+puts $stream "DIVIDERCHAR \"/\" ;"
+puts $stream "BUSBITCHARS \"\[\]\" ;"
+puts $stream "DESIGN large ;"
+puts $stream "UNITS DISTANCE MICRONS 2000 ;"
+puts $stream "DIEAREA ( 0 0 ) ( 1000000 1000000 ) ;"
+puts $stream "COMPONENTS $num_comps ;"
+for {set i 0} {$i < $num_comps} {incr i} {
+  puts $stream "- u$i BUF_X1 + PLACED ( [expr {($i % 1000) * 380}]\
+    [expr {($i / 1000) * 2800}] ) N ;"
+}
+puts $stream "END COMPONENTS"
+puts $stream "NETS [expr {$num_comps - 1}] ;"
+for {set i 1} {$i < $num_comps} {incr i} {
+  puts $stream "- n$i ( u[expr {$i - 1}] Z ) ( u$i A ) + USE SIGNAL ;"
+}
+puts $stream "END NETS"
+puts $stream "END DESIGN"
+close $stream
+
+read_lef "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+read_def $def_file
+
+set_thread_count 1
+set serial_def [make_result_file "write_def_threads_large1.def"]
+write_def $serial_def
+
+set_thread_count 4
+set out_def [make_result_file "write_def_threads_large4.def"]
+write_def $out_def
+diff_files $out_def $serial_def
+
+set out_def_gz [make_result_file "write_def_threads_large4.def.gz"]
+write_def $out_def_gz
+set stream [open $out_def_gz rb]
+set def_text [zlib gunzip [read $stream]]
+close $stream
+set out_def_unzipped [make_result_file "write_def_threads_large4_unzipped.def"]
+set stream [open $out_def_unzipped wb]
+puts -nonewline $stream $def_text
+close $stream
+diff_files $out_def_unzipped $serial_def
+
+puts "pass"
+exit 0
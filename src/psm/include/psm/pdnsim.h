@@ -79,7 +79,8 @@ class PDNSim : public odb::dbBlockCallBackObj
                         bool enable_em,
                         const std::string& em_file,
                         const std::string& error_file,
-                        const std::string& voltage_source_file);
+                        const std::string& voltage_source_file,
+                        bool hierarchical = false);
   void writeSpiceNetwork(odb::dbNet* net,
                          sta::Corner* corner,
                          GeneratedSourceType source_type,
@@ -98,9 +99,12 @@ class PDNSim : public odb::dbBlockCallBackObj
   void clearSolvers();
 
   void setGeneratedSourceSettings(const GeneratedSourceSettings& settings);
+  // Threads used to construct the power grid networks
+  void setThreads(int threads) { threads_ = threads; }
 
   // from dbBlockCallBackObj
   void inDbPostMoveInst(odb::dbInst*) override;
+  void inDbInstDestroy(odb::dbInst*) override;
   void inDbNetDestroy(odb::dbNet*) override;
   void inDbBTermPostConnect(odb::dbBTerm*) override;
   void inDbBTermPostDisConnect(odb::dbBTerm*, odb::dbNet*) override;
@@ -136,6 +140,8 @@ class PDNSim : public odb::dbBlockCallBackObj
 
   GeneratedSourceSettings generated_source_settings_;
 
+  int threads_ = 1;
+
   std::map<odb::dbNet*, std::unique_ptr<IRSolver>> solvers_;
   std::map<odb::dbNet*, std::map<sta::Corner*, double>> user_voltages_;
   std::map<odb::dbInst*, std::map<sta::Corner*, float>> user_powers_;
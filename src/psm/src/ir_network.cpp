@@ -22,8 +22,14 @@
 
 namespace psm {
 
-IRNetwork::IRNetwork(odb::dbNet* net, utl::Logger* logger, bool floorplanning)
-    : net_(net), logger_(logger), floorplanning_(floorplanning)
+IRNetwork::IRNetwork(odb::dbNet* net,
+                     utl::Logger* logger,
+                     bool floorplanning,
+                     int threads)
+    : net_(net),
+      logger_(logger),
+      floorplanning_(floorplanning),
+      threads_(std::max(threads, 1))
 {
   if (!net_->getSigType().isSupply()) {
     logger_->error(utl::PSM, 87, "{} is not a supply net.", net_->getName());
@@ -58,6 +64,15 @@ void IRNetwork::initMinimumNodePitch()
   }
 }
 
+int IRNetwork::getMinNodePitch(odb::dbTechLayer* layer) const
+{
+  const auto pitch = min_node_pitch_.find(layer);
+  if (pitch == min_node_pitch_.end()) {
+    return 0;
+  }
+  return pitch->second;
+}
+
 odb::dbBlock* IRNetwork::getBlock() const
 {
   return net_->getBlock();
@@ -77,6 +92,8 @@ void IRNetwork::reset()
   iterm_nodes_.clear();
   bpin_nodes_.clear();
 
+  node_id_count_ = 0;
+
   recoverMemory();
 }
 
@@ -91,6 +108,7 @@ void IRNetwork::construct()
   generateCutLayerNodes();
   generateTopLayerFillerNodes();
   sortNodes();
+  assignNodeIDs();
   if (logger_->debugCheck(utl::PSM, "dump", 2)) {
     dumpNodes("intital_nodes");
   }
@@ -112,6 +130,9 @@ void IRNetwork::construct()
     dumpNodes("after_connection_cleanup");
   }
 
+  // Nodes were removed, so make the IDs dense again
+  assignNodeIDs();
+
   if (logger_->debugCheck(utl::PSM, "construct", 1)) {
     reportStats();
   }
@@ -471,64 +492,75 @@ void IRNetwork::generateRoutingLayerShapesAndNodes()
 
   const TerminalTree terminal_nodes = getTerminalTree(terminals);
 
-  // Simplify shapes
-  std::vector<std::pair<odb::dbTechLayer*, Polygon90>> all_poly_shapes;
+  // Simplify shapes, each layer on its own thread
+  std::vector<std::pair<odb::dbTechLayer*, Polygon90Set*>> layer_shapes;
   for (auto& [layer, shapes] : shapes_by_layer) {
-    const utl::DebugScopedTimer layer_timer(
-        logger_,
-        utl::PSM,
-        "timer",
-        1,
-        fmt::format("Convert shapes to polygons shapes on {}: {{}}",
-                    layer->getName()));
+    layer_shapes.emplace_back(layer, &shapes);
+  }
+  std::vector<std::vector<Polygon90>> layer_polygons(layer_shapes.size());
+  std::vector<std::size_t> layer_shape_counts(layer_shapes.size());
 
-    std::vector<Polygon90> shape_polygons;
-    shapes.get_polygons(shape_polygons);
+  const utl::Timer reduction_timer;
+#pragma omp parallel for num_threads(threads_) schedule(dynamic)
+  for (std::size_t i = 0; i < layer_shapes.size(); i++) {
+    Polygon90Set* shapes = layer_shapes[i].second;
+    layer_shape_counts[i] = shapes->size();
+    shapes->get_polygons(layer_polygons[i]);
+  }
 
-    debugPrint(logger_,
-               utl::PSM,
-               "timer",
-               1,
-               "Shape reduction on {}: {}",
-               layer->getName(),
-               layer_timer);
+  debugPrint(
+      logger_, utl::PSM, "timer", 1, "Shape reduction: {}", reduction_timer);
 
+  std::vector<std::pair<odb::dbTechLayer*, Polygon90>> all_poly_shapes;
+  for (std::size_t i = 0; i < layer_shapes.size(); i++) {
+    odb::dbTechLayer* layer = layer_shapes[i].first;
     debugPrint(logger_,
                utl::PSM,
                "construct",
                1,
                "Shapes on {}: {} reduced to {}",
                layer->getName(),
-               shapes.size(),
-               shape_polygons.size());
+               layer_shape_counts[i],
+               layer_polygons[i].size());
 
-    for (const auto& shape_poly : shape_polygons) {
-      all_poly_shapes.emplace_back(layer, shape_poly);
+    for (auto& shape_poly : layer_polygons[i]) {
+      all_poly_shapes.emplace_back(layer, std::move(shape_poly));
     }
   }
+  layer_polygons.clear();
   shapes_by_layer.clear();
 
+  // Polygons are split into shapes and nodes independently, then collected
+  // in polygon order so the result does not depend on the thread count.
   const utl::Timer generate_timer;
-  std::vector<std::unique_ptr<Node>> poly_nodes;
-  std::vector<std::unique_ptr<Shape>> poly_shapes;
-  std::map<Shape*, std::set<Node*>> shape_term_nodes;
-  for (const auto& [layer, shape_poly] : all_poly_shapes) {
+  std::vector<std::vector<std::unique_ptr<Node>>> poly_nodes(
+      all_poly_shapes.size());
+  std::vector<std::vector<std::unique_ptr<Shape>>> poly_shapes(
+      all_poly_shapes.size());
+#pragma omp parallel for num_threads(threads_) schedule(dynamic, 16)
+  for (std::size_t i = 0; i < all_poly_shapes.size(); i++) {
+    const auto& [layer, shape_poly] = all_poly_shapes[i];
+    std::map<Shape*, std::set<Node*>> shape_term_nodes;
     processPolygonToRectangles(layer,
                                shape_poly,
                                terminal_nodes,
-                               poly_shapes,
-                               poly_nodes,
+                               poly_shapes[i],
+                               poly_nodes[i],
                                shape_term_nodes);
   }
 
   debugPrint(
       logger_, utl::PSM, "timer", 1, "Shape generation: {}", generate_timer);
 
-  for (auto& node : poly_nodes) {
-    nodes_[node->getLayer()].push_back(std::move(node));
+  for (auto& nodes : poly_nodes) {
+    for (auto& node : nodes) {
+      nodes_[node->getLayer()].push_back(std::move(node));
+    }
   }
-  for (auto& shape : poly_shapes) {
-    shapes_[shape->getLayer()].push_back(std::move(shape));
+  for (auto& shapes : poly_shapes) {
+    for (auto& shape : shapes) {
+      shapes_[shape->getLayer()].push_back(std::move(shape));
+    }
   }
 
   sortShapes();
@@ -573,7 +605,7 @@ void IRNetwork::generateCutNodesForSBox(
   }
 
   const int min_pitch_
-      = std::min(min_node_pitch_[bottom], min_node_pitch_[top]);
+      = std::min(getMinNodePitch(bottom), getMinNodePitch(top));
   const bool use_single_via = box->getBox().maxDXDY() < min_pitch_;
 
   if (single_via || use_single_via) {
@@ -646,23 +678,29 @@ void IRNetwork::generateCutLayerNodes()
     }
   }
 
-  std::vector<std::unique_ptr<Node>> loop_via_nodes;
-  std::vector<std::unique_ptr<Connection>> loop_via_connections;
-  for (odb::dbSBox* box : boxes) {
+  std::vector<std::vector<std::unique_ptr<Node>>> box_via_nodes(boxes.size());
+  std::vector<std::vector<std::unique_ptr<Connection>>> box_via_connections(
+      boxes.size());
+#pragma omp parallel for num_threads(threads_) schedule(dynamic, 64)
+  for (std::size_t i = 0; i < boxes.size(); i++) {
     generateCutNodesForSBox(
-        box, use_single_via, loop_via_nodes, loop_via_connections);
+        boxes[i], use_single_via, box_via_nodes[i], box_via_connections[i]);
   }
   boxes.clear();
 
   LayerMap<std::vector<std::unique_ptr<Node>>> via_nodes;
-  for (auto& node : loop_via_nodes) {
-    via_nodes[node->getLayer()].push_back(std::move(node));
+  for (auto& nodes : box_via_nodes) {
+    for (auto& node : nodes) {
+      via_nodes[node->getLayer()].push_back(std::move(node));
+    }
   }
-  for (auto& connection : loop_via_connections) {
-    connections_.push_back(std::move(connection));
+  for (auto& connections : box_via_connections) {
+    for (auto& connection : connections) {
+      connections_.push_back(std::move(connection));
+    }
   }
-  loop_via_nodes.clear();
-  loop_via_connections.clear();
+  box_via_nodes.clear();
+  box_via_connections.clear();
 
   for (auto& [layer, nodes] : via_nodes) {
     // move vias to nodes_
@@ -681,31 +719,41 @@ void IRNetwork::generateTopLayerFillerNodes()
   odb::dbTechLayer* top = getTopLayer();
   const auto top_nodes = getNodeTree(top);
 
-  const int max_distance = min_node_pitch_[top];
+  const int max_distance = getMinNodePitch(top);
+
+  const auto& top_shapes = shapes_[top];
+  std::vector<std::vector<std::unique_ptr<Node>>> shape_nodes(
+      top_shapes.size());
+#pragma omp parallel for num_threads(threads_) schedule(dynamic, 16)
+  for (std::size_t i = 0; i < top_shapes.size(); i++) {
+    shape_nodes[i] = top_shapes[i]->createFillerNodes(max_distance, top_nodes);
+  }
 
-  for (const auto& shape : shapes_[top]) {
-    for (auto& node : shape->createFillerNodes(max_distance, top_nodes)) {
+  for (auto& nodes : shape_nodes) {
+    for (auto& node : nodes) {
       nodes_[node->getLayer()].push_back(std::move(node));
     }
   }
 }
 
-std::set<Node*> IRNetwork::getSharedShapeNodes() const
+IRNetwork::NodeIdSet IRNetwork::getSharedShapeNodes() const
 {
   const utl::DebugScopedTimer timer(
       logger_, utl::PSM, "timer", 1, "Build node -> shape count: {}");
 
-  std::set<Node*> shared_nodes;
+  NodeIdSet shared_nodes(node_id_count_, false);
   for (const auto& [layer, nodes] : nodes_) {
     const auto layer_shapes = getShapeTree(layer);
 
-    for (const auto& node : nodes) {
+#pragma omp parallel for num_threads(threads_) schedule(dynamic, 1024)
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+      const Node* node = nodes[i].get();
       const Point pt(node->getPoint().x(), node->getPoint().y());
       const auto shapes = std::distance(
           layer_shapes.qbegin(boost::geometry::index::intersects(pt)),
           layer_shapes.qend());
       if (shapes > 1) {
-        shared_nodes.insert(node.get());
+        shared_nodes[node->getID()] = true;
       }
     }
   }
@@ -713,15 +761,17 @@ std::set<Node*> IRNetwork::getSharedShapeNodes() const
   return shared_nodes;
 }
 
-void IRNetwork::mergeNodes(NodePtrMap<Connection>& connection_map)
+void IRNetwork::mergeNodes(NodeIdMap<Connection>& connection_map)
 {
   const utl::DebugScopedTimer timer(
       logger_, utl::PSM, "timer", 1, "Merging nodes: {}");
 
   const auto shared_nodes = getSharedShapeNodes();
 
+  // Merges rewrite connections shared between shapes and layers, so they
+  // are performed serially.
   const utl::Timer perform_timer;
-  std::set<Node*> removes;
+  NodeIdSet removes(node_id_count_, false);
   for (auto& [layer, shapes] : shapes_) {
     debugPrint(logger_,
                utl::PSM,
@@ -733,40 +783,23 @@ void IRNetwork::mergeNodes(NodePtrMap<Connection>& connection_map)
 
     const auto node_trees = getNodeTree(layer);
     for (const auto& shape : shapes) {
-      const int min_distance = min_node_pitch_[shape->getLayer()];
+      const int min_distance = getMinNodePitch(shape->getLayer());
       const auto shape_remove = shape->cleanupNodes(
           min_distance,
           node_trees,
           [&](Node* keep, Node* remove) { copy(keep, remove, connection_map); },
           shared_nodes);
-      removes.insert(shape_remove.begin(), shape_remove.end());
+      for (Node* node : shape_remove) {
+        removes[node->getID()] = true;
+      }
     }
   }
 
   debugPrint(
       logger_, utl::PSM, "timer", 1, "Perform merges: {}", perform_timer);
 
-  LayerMap<std::set<Node*>> remove_by_layer;
-  for (auto* node : removes) {
-    remove_by_layer[node->getLayer()].insert(node);
-  }
-  removes.clear();
-
-  std::vector<std::pair<odb::dbTechLayer*, std::set<Node*>>> remove_sets;
-  for (auto& [layer, layer_remove] : remove_by_layer) {
-    remove_sets.emplace_back(layer, std::move(layer_remove));
-  }
-  remove_by_layer.clear();
-
-  for (auto& [layer, layer_remove] : remove_sets) {
-    debugPrint(logger_,
-               utl::PSM,
-               "construct",
-               2,
-               "Identified {} nodes to be merged on {}",
-               layer_remove.size(),
-               layer->getName());
-    removeNodes(layer_remove, layer, nodes_[layer], connection_map);
+  for (auto& [layer, nodes] : nodes_) {
+    removeNodes(removes, layer, nodes, connection_map);
   }
 
   recoverMemory();
@@ -777,7 +810,14 @@ void IRNetwork::sortShapes()
   const utl::DebugScopedTimer timer(
       logger_, utl::PSM, "timer", 1, "Sorting shapes: {}");
 
+  std::vector<std::vector<std::unique_ptr<Shape>>*> layer_shapes;
   for (auto& [layer, shapes] : shapes_) {
+    layer_shapes.push_back(&shapes);
+  }
+
+#pragma omp parallel for num_threads(threads_) schedule(dynamic)
+  for (std::size_t i = 0; i < layer_shapes.size(); i++) {
+    auto& shapes = *layer_shapes[i];
     shapes.shrink_to_fit();
 
     std::stable_sort(
@@ -792,7 +832,14 @@ void IRNetwork::sortNodes()
   const utl::DebugScopedTimer timer(
       logger_, utl::PSM, "timer", 1, "Sorting nodes: {}");
 
+  std::vector<std::vector<std::unique_ptr<Node>>*> layer_nodes;
   for (auto& [layer, nodes] : nodes_) {
+    layer_nodes.push_back(&nodes);
+  }
+
+#pragma omp parallel for num_threads(threads_) schedule(dynamic)
+  for (std::size_t i = 0; i < layer_nodes.size(); i++) {
+    auto& nodes = *layer_nodes[i];
     std::stable_sort(
         nodes.begin(), nodes.end(), [](const auto& lhs, const auto& rhs) {
           return lhs->compare(rhs);
@@ -800,6 +847,23 @@ void IRNetwork::sortNodes()
   }
 }
 
+void IRNetwork::assignNodeIDs()
+{
+  std::size_t id = 0;
+  for (const auto& [layer, nodes] : nodes_) {
+    for (const auto& node : nodes) {
+      node->setID(id++);
+    }
+  }
+  for (const auto& node : iterm_nodes_) {
+    node->setID(id++);
+  }
+  for (const auto& node : bpin_nodes_) {
+    node->setID(id++);
+  }
+  node_id_count_ = id;
+}
+
 void IRNetwork::sortConnections()
 {
   const utl::DebugScopedTimer timer(
@@ -838,32 +902,31 @@ int IRNetwork::getEffectiveNumberOfCuts(const odb::dbShape& shape) const
   return 1;
 }
 
-IRNetwork::NodePtrMap<Connection> IRNetwork::getConnectionMap() const
+IRNetwork::NodeIdMap<Connection> IRNetwork::getConnectionMap() const
 {
   const utl::DebugScopedTimer timer(
       logger_, utl::PSM, "timer", 1, "Build node -> connection mapping: {}");
 
-  NodePtrMap<Connection> mapping;
+  NodeIdMap<Connection> mapping(node_id_count_);
 
   for (const auto& conn : connections_) {
     mapping[conn->getNode0()].push_back(conn.get());
     mapping[conn->getNode1()].push_back(conn.get());
   }
 
-  for (auto& [node, conns] : mapping) {
-    conns.shrink_to_fit();
-  }
+  mapping.shrink_to_fit();
 
   return mapping;
 }
 
-void IRNetwork::cleanupOverlappingNodes(NodePtrMap<Connection>& connection_map)
+void IRNetwork::cleanupOverlappingNodes(NodeIdMap<Connection>& connection_map)
 {
   const utl::DebugScopedTimer timer(
       logger_, utl::PSM, "timer", 1, "Cleanup overlapping nodes: {}");
 
+  NodeIdSet removes(node_id_count_, false);
   for (auto& [layer, nodes] : nodes_) {
-    std::set<Node*> removes;
+    std::size_t remove_count = 0;
 
     // remove duplicate/overlapping nodes
     auto node = nodes.begin();
@@ -872,7 +935,8 @@ void IRNetwork::cleanupOverlappingNodes(NodePtrMap<Connection>& connection_map)
       const odb::Point& pt = (*node)->getPoint();
       if (pt == prev_node->getPoint()) {
         copy(prev_node, node->get(), connection_map);
-        removes.insert(node->get());
+        removes[(*node)->getID()] = true;
+        remove_count++;
       } else {
         prev_node = node->get();
       }
@@ -885,7 +949,7 @@ void IRNetwork::cleanupOverlappingNodes(NodePtrMap<Connection>& connection_map)
                2,
                "Identified overlapping nodes on {}: {}",
                layer->getName(),
-               removes.size());
+               remove_count);
     removeNodes(removes, layer, nodes, connection_map);
   }
 }
@@ -897,13 +961,6 @@ void IRNetwork::cleanupNodes()
 
   auto node_connection_map = getConnectionMap();
 
-  std::map<Node*, bool> marked_deleted;
-  for (const auto& [layer, nodes] : nodes_) {
-    for (const auto& node : nodes) {
-      marked_deleted[node.get()] = false;
-    }
-  }
-
   cleanupOverlappingNodes(node_connection_map);
 
   mergeNodes(node_connection_map);
@@ -911,12 +968,16 @@ void IRNetwork::cleanupNodes()
   recoverMemory();
 }
 
-void IRNetwork::removeNodes(std::set<Node*>& removes,
+void IRNetwork::removeNodes(const NodeIdSet& removes,
                             odb::dbTechLayer* layer,
                             std::vector<std::unique_ptr<Node>>& nodes,
-                            const NodePtrMap<Connection>& connection_map)
+                            const NodeIdMap<Connection>& connection_map)
 {
-  if (removes.empty()) {
+  const auto is_removed
+      = [&removes](const auto& node) { return removes[node->getID()]; };
+  const std::size_t remove_count
+      = std::count_if(nodes.begin(), nodes.end(), is_removed);
+  if (remove_count == 0) {
     return;
   }
 
@@ -930,40 +991,21 @@ void IRNetwork::removeNodes(std::set<Node*>& removes,
   const std::size_t start_node_size = nodes.size();
 
   // remove connections
-  for (auto* node : removes) {
-    auto find_conn = connection_map.find(node);
-    if (find_conn == connection_map.end()) {
+  for (const auto& node : nodes) {
+    if (!is_removed(node)) {
       continue;
     }
 
-    for (auto* conn : find_conn->second) {
-      conn->changeNode(node, nullptr);
+    for (auto* conn : connection_map.at(node.get())) {
+      conn->changeNode(node.get(), nullptr);
     }
   }
 
-  // use list to speed up erase
-  std::list<std::unique_ptr<Node>> cleanup;
-  for (auto& node : nodes) {
-    cleanup.push_back(std::move(node));
-  }
-  nodes.clear();
-
-  cleanup.erase(std::remove_if(cleanup.begin(),
-                               cleanup.end(),
-                               [&](const auto& other) {
-                                 return removes.find(other.get())
-                                        != removes.end();
-                               }),
-                cleanup.end());
-
-  for (auto& node : cleanup) {
-    nodes.emplace_back(std::move(node));
-  }
+  nodes.erase(std::remove_if(nodes.begin(), nodes.end(), is_removed),
+              nodes.end());
 
   const std::size_t final_node_size = nodes.size();
 
-  removes.clear();
-
   debugPrint(logger_,
              utl::PSM,
              "construct",
@@ -1096,8 +1138,16 @@ void IRNetwork::connectLayerNodes()
 
   for (const auto& [layer, layer_shapes] : shapes_) {
     const auto layer_nodes = getNodeTree(layer);
-    for (const auto& shape : layer_shapes) {
-      for (auto& conn : shape->connectNodes(layer_nodes)) {
+
+    std::vector<std::vector<std::unique_ptr<Connection>>> shape_connections(
+        layer_shapes.size());
+#pragma omp parallel for num_threads(threads_) schedule(dynamic, 16)
+    for (std::size_t i = 0; i < layer_shapes.size(); i++) {
+      shape_connections[i] = layer_shapes[i]->connectNodes(layer_nodes);
+    }
+
+    for (auto& connections : shape_connections) {
+      for (auto& conn : connections) {
         connections_.push_back(std::move(conn));
       }
     }
@@ -1176,7 +1226,7 @@ void IRNetwork::reportStats() const
 
 void IRNetwork::copy(Node* keep,
                      Node* remove,
-                     NodePtrMap<Connection>& connection_map)
+                     NodeIdMap<Connection>& connection_map)
 {
   // change connections
   auto& remove_connections = connection_map[remove];
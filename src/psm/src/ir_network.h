@@ -37,8 +37,36 @@ struct PointIndexableGetter
 class IRNetwork
 {
  public:
+  // Values of each node, indexed by Node::getID().
   template <typename T>
-  using NodePtrMap = std::map<Node*, std::vector<T*>>;
+  class NodeIdMap
+  {
+   public:
+    explicit NodeIdMap(std::size_t size) : values_(size) {}
+
+    std::vector<T*>& operator[](const Node* node)
+    {
+      return values_[node->getID()];
+    }
+    const std::vector<T*>& at(const Node* node) const
+    {
+      return values_.at(node->getID());
+    }
+
+    void shrink_to_fit()
+    {
+      for (auto& values : values_) {
+        values.shrink_to_fit();
+      }
+    }
+
+   private:
+    std::vector<std::vector<T*>> values_;
+  };
+
+  // Membership of each node, indexed by Node::getID(). Bytes rather than
+  // bits, so it can be filled from several threads.
+  using NodeIdSet = std::vector<char>;
 
   template <typename T>
   using LayerMap = std::map<odb::dbTechLayer*, T>;
@@ -64,7 +92,10 @@ class IRNetwork
   using Polygon90 = boost::polygon::polygon_90_with_holes_data<int>;
   using Polygon90Set = boost::polygon::polygon_90_set_data<int>;
 
-  IRNetwork(odb::dbNet* net, utl::Logger* logger, bool floorplanning);
+  IRNetwork(odb::dbNet* net,
+            utl::Logger* logger,
+            bool floorplanning,
+            int threads = 1);
 
   odb::dbNet* getNet() const { return net_; };
 
@@ -108,7 +139,7 @@ class IRNetwork
   {
     return connections_;
   }
-  NodePtrMap<Connection> getConnectionMap() const;
+  NodeIdMap<Connection> getConnectionMap() const;
 
   std::map<odb::dbInst*, Node::NodeSet> getInstanceNodeMapping() const;
 
@@ -130,9 +161,10 @@ class IRNetwork
   void generateCutLayerNodes();
   void generateTopLayerFillerNodes();
   void sortNodes();
+  void assignNodeIDs();
   void cleanupNodes();
-  void cleanupOverlappingNodes(NodePtrMap<Connection>& connection_map);
-  void mergeNodes(NodePtrMap<Connection>& connection_map);
+  void cleanupOverlappingNodes(NodeIdMap<Connection>& connection_map);
+  void mergeNodes(NodeIdMap<Connection>& connection_map);
 
   void connectLayerNodes();
   void cleanupConnections();
@@ -140,17 +172,17 @@ class IRNetwork
   void cleanupDuplicateConnections();
   void sortConnections();
 
-  void removeNodes(std::set<Node*>& removes,
+  void removeNodes(const NodeIdSet& removes,
                    odb::dbTechLayer* layer,
                    std::vector<std::unique_ptr<Node>>& nodes,
-                   const NodePtrMap<Connection>& connection_map);
+                   const NodeIdMap<Connection>& connection_map);
   void removeConnections(std::set<Connection*>& removes);
 
   int getEffectiveNumberOfCuts(const odb::dbShape& shape) const;
 
-  void copy(Node* keep, Node* remove, NodePtrMap<Connection>& connection_map);
+  void copy(Node* keep, Node* remove, NodeIdMap<Connection>& connection_map);
 
-  std::set<Node*> getSharedShapeNodes() const;
+  NodeIdSet getSharedShapeNodes() const;
 
   Polygon90 rectToPolygon(const odb::Rect& rect) const;
   LayerMap<Polygon90Set> generatePolygonsFromSWire(odb::dbSWire* wire);
@@ -180,6 +212,8 @@ class IRNetwork
   NodeTree getNodeTree(odb::dbTechLayer* layer) const;
 
   void initMinimumNodePitch();
+  // 0 for layers without a node pitch; safe to call from parallel regions.
+  int getMinNodePitch(odb::dbTechLayer* layer) const;
 
   void recoverMemory();
 
@@ -191,6 +225,8 @@ class IRNetwork
 
   bool floorplanning_;
 
+  int threads_;
+
   LayerMap<std::vector<std::unique_ptr<Shape>>> shapes_;
   LayerMap<std::vector<std::unique_ptr<Node>>> nodes_;
 
@@ -199,6 +235,9 @@ class IRNetwork
   std::vector<std::unique_ptr<ITermNode>> iterm_nodes_;
   std::vector<std::unique_ptr<BPinNode>> bpin_nodes_;
 
+  // One past the largest Node::getID() in the network
+  std::size_t node_id_count_ = 0;
+
   std::map<odb::dbTechLayer*, int> min_node_pitch_;
 
   static constexpr int min_node_pitch_multiplier_ = 10;
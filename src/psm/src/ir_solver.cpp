@@ -13,6 +13,7 @@
 #include <optional>
 #include <queue>
 #include <set>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -39,12 +40,13 @@ IRSolver::IRSolver(
     utl::Logger* logger,
     const std::map<odb::dbNet*, std::map<sta::Corner*, Voltage>>& user_voltages,
     const std::map<odb::dbInst*, std::map<sta::Corner*, Power>>& user_powers,
-    const PDNSim::GeneratedSourceSettings& generated_source_settings)
+    const PDNSim::GeneratedSourceSettings& generated_source_settings,
+    int threads)
     : net_(net),
       logger_(logger),
       resizer_(resizer),
       sta_(sta),
-      network_(new IRNetwork(net_, logger_, floorplanning)),
+      network_(new IRNetwork(net_, logger_, floorplanning, threads)),
       gui_(nullptr),
       user_voltages_(user_voltages),
       user_powers_(user_powers),
@@ -945,15 +947,426 @@ void IRSolver::addSourcesToMatrixAndVoltages(
   }
 }
 
+Eigen::VectorXd IRSolver::solveMatrix(
+    const Matrix& G,
+    const Eigen::VectorXd& J,
+    const std::map<Node*, std::size_t>& node_index,
+    const std::string& name) const
+{
+  MatrixSolver eigen_solver;
+
+  debugPrint(logger_, utl::PSM, "solve", 1, "Factorizing the {} matrix", name);
+  eigen_solver.compute(G);
+  if (eigen_solver.info() != Eigen::ComputationInfo::Success) {
+    // decomposition failed
+    if (logger_->debugCheck(utl::PSM, "dump", 1)) {
+      network_->dumpNodes(node_index);
+      dumpMatrix(G, name);
+    }
+    logger_->error(
+        utl::PSM,
+        10,
+        "LU factorization of the G Matrix failed. SparseLU solver message: {}.",
+        eigen_solver.lastErrorMessage());
+  }
+
+  debugPrint(logger_, utl::PSM, "solve", 1, "Solving system of equations GV=J");
+  Eigen::VectorXd V = eigen_solver.solve(J);
+  if (eigen_solver.info() != Eigen::ComputationInfo::Success) {
+    // solving failed
+    if (logger_->debugCheck(utl::PSM, "dump", 1)) {
+      network_->dumpNodes(node_index);
+      dumpMatrix(G, name);
+      dumpVector(J, "J");
+    }
+    logger_->error(utl::PSM, 12, "Solving V = inv(G)*J failed.");
+  }
+  debugPrint(logger_,
+             utl::PSM,
+             "solve",
+             1,
+             "Solving system of equations GV=J complete");
+
+  return V;
+}
+
+std::vector<IRSolver::MacroReduction> IRSolver::reduceMacros(
+    const Matrix& G,
+    const std::map<Node*, std::size_t>& node_index)
+{
+  const utl::DebugScopedTimer timer(
+      logger_, utl::PSM, "timer", 1, "Reduce macros: {}");
+
+  using MacroBox = std::pair<odb::Rect, std::size_t>;
+  std::vector<odb::dbInst*> macros;
+  std::vector<MacroBox> macro_boxes;
+  for (odb::dbInst* inst : getBlock()->getInsts()) {
+    if (!inst->getMaster()->isBlock() || !inst->isPlaced()) {
+      continue;
+    }
+    macro_boxes.emplace_back(inst->getBBox()->getBox(), macros.size());
+    macros.push_back(inst);
+  }
+  if (macros.empty()) {
+    return {};
+  }
+  const boost::geometry::index::
+      rtree<MacroBox, boost::geometry::index::quadratic<16>>
+          macro_tree(macro_boxes.begin(), macro_boxes.end());
+
+  // Macro containing each node, the source nodes stay at the top level
+  constexpr int no_macro = -1;
+  std::vector<int> node_macro(G.rows(), no_macro);
+  std::vector<const Node*> index_nodes(G.rows(), nullptr);
+  for (const auto& [node, idx] : node_index) {
+    index_nodes[idx] = node;
+    if (dynamic_cast<const SourceNode*>(node) != nullptr) {
+      continue;
+    }
+    auto itr = macro_tree.qbegin(
+        boost::geometry::index::intersects(node->getPoint()));
+    if (itr != macro_tree.qend()) {
+      node_macro[idx] = itr->second;
+    }
+  }
+
+  // Interior nodes only connect to nodes of the same macro, the other
+  // nodes they connect to are the ports of the macro
+  std::vector<MacroReduction> macro_reductions(macros.size());
+  std::vector<bool> is_interior(G.rows(), false);
+  for (Eigen::Index col = 0; col < G.outerSize(); col++) {
+    const int macro = node_macro[col];
+    if (macro == no_macro) {
+      continue;
+    }
+    bool interior = true;
+    for (Matrix::InnerIterator itr(G, col); itr; ++itr) {
+      if (node_macro[itr.row()] != macro) {
+        interior = false;
+        break;
+      }
+    }
+    if (interior) {
+      is_interior[col] = true;
+      macro_reductions[macro].interior.push_back(col);
+    }
+  }
+
+  // Interior nodes and ports are ordered by their location in the macro,
+  // so instances with the same grid get the same descriptor
+  using NodeKey = std::tuple<int, int, int, int, int>;
+  auto node_key = [&index_nodes](odb::dbInst* inst, std::size_t idx) {
+    const Node* node = index_nodes[idx];
+    const odb::Point origin = inst->getLocation();
+    int kind = 0;
+    int pin = -1;
+    if (auto* iterm = dynamic_cast<const ITermNode*>(node)) {
+      kind = 1;
+      pin = iterm->getITerm()->getMTerm()->getId();
+    } else if (dynamic_cast<const TerminalNode*>(node) != nullptr) {
+      kind = 2;
+    }
+    return NodeKey(node->getLayer()->getNumber(),
+                   node->getPoint().x() - origin.x(),
+                   node->getPoint().y() - origin.y(),
+                   kind,
+                   pin);
+  };
+
+  std::vector<MacroReduction> reductions;
+  for (std::size_t i = 0; i < macros.size(); i++) {
+    MacroReduction& reduction = macro_reductions[i];
+    if (reduction.interior.empty()) {
+      continue;
+    }
+    odb::dbInst* inst = macros[i];
+
+    std::set<std::size_t> ports;
+    for (const std::size_t idx : reduction.interior) {
+      for (Matrix::InnerIterator itr(G, idx); itr; ++itr) {
+        if (!is_interior[itr.row()]) {
+          ports.insert(itr.row());
+        }
+      }
+    }
+    if (ports.size() > max_macro_ports_) {
+      logger_->warn(utl::PSM,
+                    96,
+                    "{} has {} grid ports, more than {}. Its grid is solved "
+                    "with the top level.",
+                    inst->getName(),
+                    ports.size(),
+                    max_macro_ports_);
+      continue;
+    }
+    reduction.ports.assign(ports.begin(), ports.end());
+
+    auto sort_nodes = [&](std::vector<std::size_t>& nodes) {
+      std::stable_sort(
+          nodes.begin(), nodes.end(), [&](std::size_t lhs, std::size_t rhs) {
+            return node_key(inst, lhs) < node_key(inst, rhs);
+          });
+    };
+    sort_nodes(reduction.interior);
+    sort_nodes(reduction.ports);
+
+    std::map<std::size_t, std::size_t> local_index;
+    for (const std::size_t idx : reduction.interior) {
+      local_index.emplace(idx, local_index.size());
+    }
+    for (const std::size_t idx : reduction.ports) {
+      local_index.emplace(idx, local_index.size());
+    }
+
+    std::vector<double> descriptor{
+        static_cast<double>(reduction.interior.size()),
+        static_cast<double>(reduction.ports.size())};
+    auto add_nodes = [&](const std::vector<std::size_t>& nodes) {
+      for (const std::size_t idx : nodes) {
+        const auto [layer, x, y, kind, pin] = node_key(inst, idx);
+        descriptor.insert(descriptor.end(),
+                          {static_cast<double>(layer),
+                           static_cast<double>(x),
+                           static_cast<double>(y),
+                           static_cast<double>(kind),
+                           static_cast<double>(pin)});
+      }
+    };
+    add_nodes(reduction.interior);
+    add_nodes(reduction.ports);
+    for (std::size_t col = 0; col < reduction.interior.size(); col++) {
+      std::vector<std::pair<std::size_t, double>> values;
+      for (Matrix::InnerIterator itr(G, reduction.interior[col]); itr; ++itr) {
+        values.emplace_back(local_index.at(itr.row()), itr.value());
+      }
+      std::sort(values.begin(), values.end());
+      for (const auto& [row, value] : values) {
+        descriptor.insert(descriptor.end(),
+                          {static_cast<double>(col),
+                           static_cast<double>(row),
+                           value});
+      }
+    }
+
+    reduction.model = getMacroModel(inst, G, reduction, std::move(descriptor));
+    reductions.push_back(std::move(reduction));
+  }
+
+  return reductions;
+}
+
+IRSolver::MacroModel* IRSolver::getMacroModel(odb::dbInst* inst,
+                                              const Matrix& G,
+                                              const MacroReduction& reduction,
+                                              std::vector<double> descriptor)
+{
+  auto& models
+      = macro_models_[{inst->getMaster(), inst->getOrient().getValue()}];
+  for (const auto& model : models) {
+    if (model->descriptor == descriptor) {
+      return model.get();
+    }
+  }
+
+  debugPrint(logger_,
+             utl::PSM,
+             "solve",
+             1,
+             "Building macro model for {} with {} interior nodes and {} ports",
+             inst->getName(),
+             reduction.interior.size(),
+             reduction.ports.size());
+
+  std::map<std::size_t, std::size_t> interior_index;
+  for (const std::size_t idx : reduction.interior) {
+    interior_index.emplace(idx, interior_index.size());
+  }
+  std::map<std::size_t, std::size_t> port_index;
+  for (const std::size_t idx : reduction.ports) {
+    port_index.emplace(idx, port_index.size());
+  }
+
+  // G is symmetric between interior nodes and ports, so G_ip is read from
+  // the columns of the interior nodes
+  std::vector<Eigen::Triplet<Connection::Conductance>> interior_values;
+  std::vector<Eigen::Triplet<Connection::Conductance>> port_values;
+  for (std::size_t col = 0; col < reduction.interior.size(); col++) {
+    for (Matrix::InnerIterator itr(G, reduction.interior[col]); itr; ++itr) {
+      auto find_interior = interior_index.find(itr.row());
+      if (find_interior != interior_index.end()) {
+        interior_values.emplace_back(find_interior->second, col, itr.value());
+      } else {
+        port_values.emplace_back(col, port_index.at(itr.row()), itr.value());
+      }
+    }
+  }
+
+  auto model = std::make_unique<MacroModel>();
+  model->descriptor = std::move(descriptor);
+
+  Matrix interior(reduction.interior.size(), reduction.interior.size());
+  interior.setFromTriplets(interior_values.begin(), interior_values.end());
+  model->interior_ports
+      = Matrix(reduction.interior.size(), reduction.ports.size());
+  model->interior_ports.setFromTriplets(port_values.begin(),
+                                        port_values.end());
+
+  model->interior.compute(interior);
+  if (model->interior.info() != Eigen::ComputationInfo::Success) {
+    logger_->error(utl::PSM,
+                   95,
+                   "LU factorization of the grid inside {} failed. SparseLU "
+                   "solver message: {}.",
+                   inst->getName(),
+                   model->interior.lastErrorMessage());
+  }
+  // Solved one port at a time, so only the port update is held dense
+  model->port_update
+      = Eigen::MatrixXd::Zero(reduction.ports.size(), reduction.ports.size());
+  for (std::size_t port = 0; port < reduction.ports.size(); port++) {
+    const Eigen::VectorXd interior_V = model->interior.solve(
+        Eigen::VectorXd(model->interior_ports.col(port)));
+    model->port_update.col(port)
+        = -(model->interior_ports.transpose() * interior_V);
+  }
+
+  models.push_back(std::move(model));
+  return models.back().get();
+}
+
+void IRSolver::clearMacroModels()
+{
+  macro_models_.clear();
+}
+
+Eigen::VectorXd IRSolver::solveHierarchical(
+    const Matrix& G,
+    const Eigen::VectorXd& J,
+    const std::map<Node*, std::size_t>& node_index)
+{
+  const std::vector<MacroReduction> reductions = reduceMacros(G, node_index);
+  if (reductions.empty()) {
+    return solveMatrix(G, J, node_index, "G");
+  }
+
+  std::vector<bool> is_interior(G.rows(), false);
+  std::set<const MacroModel*> models;
+  for (const auto& reduction : reductions) {
+    for (const std::size_t idx : reduction.interior) {
+      is_interior[idx] = true;
+    }
+    models.insert(reduction.model);
+  }
+
+  std::vector<std::size_t> top_index(G.rows(), 0);
+  std::size_t top_count = 0;
+  for (Eigen::Index idx = 0; idx < G.rows(); idx++) {
+    if (!is_interior[idx]) {
+      top_index[idx] = top_count++;
+    }
+  }
+  std::map<Node*, std::size_t> top_node_index;
+  for (const auto& [node, idx] : node_index) {
+    if (!is_interior[idx]) {
+      top_node_index[node] = top_index[idx];
+    }
+  }
+
+  // Top level grid with the macro interiors replaced by their models
+  std::vector<Eigen::Triplet<Connection::Conductance>> top_values;
+  for (Eigen::Index col = 0; col < G.outerSize(); col++) {
+    if (is_interior[col]) {
+      continue;
+    }
+    for (Matrix::InnerIterator itr(G, col); itr; ++itr) {
+      if (!is_interior[itr.row()]) {
+        top_values.emplace_back(
+            top_index[itr.row()], top_index[col], itr.value());
+      }
+    }
+  }
+  Eigen::VectorXd top_J(top_count);
+  for (Eigen::Index idx = 0; idx < G.rows(); idx++) {
+    if (!is_interior[idx]) {
+      top_J[top_index[idx]] = J[idx];
+    }
+  }
+
+  std::vector<Eigen::VectorXd> interior_J;
+  interior_J.reserve(reductions.size());
+  for (const auto& reduction : reductions) {
+    Eigen::VectorXd macro_J(reduction.interior.size());
+    for (std::size_t i = 0; i < reduction.interior.size(); i++) {
+      macro_J[i] = J[reduction.interior[i]];
+    }
+
+    const MacroModel* model = reduction.model;
+    const Eigen::VectorXd port_J
+        = model->interior_ports.transpose() * model->interior.solve(macro_J);
+    for (std::size_t i = 0; i < reduction.ports.size(); i++) {
+      const std::size_t port_i = top_index[reduction.ports[i]];
+      top_J[port_i] -= port_J[i];
+      for (std::size_t j = 0; j < reduction.ports.size(); j++) {
+        const Connection::Conductance cond = model->port_update(i, j);
+        if (cond != 0.0) {
+          top_values.emplace_back(
+              port_i, top_index[reduction.ports[j]], cond);
+        }
+      }
+    }
+    interior_J.push_back(std::move(macro_J));
+  }
+
+  Matrix top_G(top_count, top_count);
+  top_G.setFromTriplets(top_values.begin(), top_values.end());
+  top_values.clear();
+
+  logger_->info(utl::PSM,
+                94,
+                "Reduced {} macro instances with {} macro models, solving {} "
+                "of {} nodes at the top level.",
+                reductions.size(),
+                models.size(),
+                top_count,
+                G.rows());
+
+  const Eigen::VectorXd top_V
+      = solveMatrix(top_G, top_J, top_node_index, "G_top");
+
+  // Recover the interior voltages from the port voltages
+  Eigen::VectorXd V(G.rows());
+  for (Eigen::Index idx = 0; idx < G.rows(); idx++) {
+    if (!is_interior[idx]) {
+      V[idx] = top_V[top_index[idx]];
+    }
+  }
+  for (std::size_t r = 0; r < reductions.size(); r++) {
+    const MacroReduction& reduction = reductions[r];
+    Eigen::VectorXd port_V(reduction.ports.size());
+    for (std::size_t i = 0; i < reduction.ports.size(); i++) {
+      port_V[i] = V[reduction.ports[i]];
+    }
+    const Eigen::VectorXd interior_V = reduction.model->interior.solve(
+        interior_J[r] - reduction.model->interior_ports * port_V);
+    for (std::size_t i = 0; i < reduction.interior.size(); i++) {
+      V[reduction.interior[i]] = interior_V[i];
+    }
+  }
+
+  return V;
+}
+
 void IRSolver::solve(sta::Corner* corner,
                      GeneratedSourceType source_type,
-                     const std::string& source_file)
+                     const std::string& source_file,
+                     bool hierarchical)
 {
   const utl::DebugScopedTimer timer(logger_, utl::PSM, "timer", 1, "Solve: {}");
 
   if (network_->isFloorplanningOnly()) {
     network_->setFloorplanning(false);
     network_->construct();
+    clearMacroModels();
   }
 
   assertResistanceMap(corner);
@@ -1022,39 +1435,8 @@ void IRSolver::solve(sta::Corner* corner,
                              J);
   addSourcesToMatrixAndVoltages(src_voltage, src_nodes, node_index, G, J);
 
-  Eigen::SparseLU<Eigen::SparseMatrix<Connection::Conductance>> eigen_solver;
-
-  debugPrint(logger_, utl::PSM, "solve", 1, "Factorizing the G matrix");
-  eigen_solver.compute(G);
-  if (eigen_solver.info() != Eigen::ComputationInfo::Success) {
-    // decomposition failed
-    if (logger_->debugCheck(utl::PSM, "dump", 1)) {
-      network_->dumpNodes(node_index);
-      dumpMatrix(G, "G");
-    }
-    logger_->error(
-        utl::PSM,
-        10,
-        "LU factorization of the G Matrix failed. SparseLU solver message: {}.",
-        eigen_solver.lastErrorMessage());
-  }
-
-  debugPrint(logger_, utl::PSM, "solve", 1, "Solving system of equations GV=J");
-  const Eigen::VectorXd V = eigen_solver.solve(J);
-  if (eigen_solver.info() != Eigen::ComputationInfo::Success) {
-    // solving failed
-    if (logger_->debugCheck(utl::PSM, "dump", 1)) {
-      network_->dumpNodes(node_index);
-      dumpMatrix(G, "G");
-      dumpVector(J, "J");
-    }
-    logger_->error(utl::PSM, 12, "Solving V = inv(G)*J failed.");
-  }
-  debugPrint(logger_,
-             utl::PSM,
-             "solve",
-             1,
-             "Solving system of equations GV=J complete");
+  const Eigen::VectorXd V = hierarchical ? solveHierarchical(G, J, node_index)
+                                         : solveMatrix(G, J, node_index, "G");
 
   if (logger_->debugCheck(utl::PSM, "dump", 2)) {
     network_->dumpNodes(node_index);
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <Eigen/Sparse>
+#include <Eigen/SparseLU>
 #include <boost/geometry.hpp>
 #include <boost/polygon/polygon.hpp>
 #include <map>
@@ -70,7 +71,8 @@ class IRSolver
       const std::map<odb::dbNet*, std::map<sta::Corner*, Voltage>>&
           user_voltages,
       const std::map<odb::dbInst*, std::map<sta::Corner*, Power>>& user_powers,
-      const PDNSim::GeneratedSourceSettings& generated_source_settings);
+      const PDNSim::GeneratedSourceSettings& generated_source_settings,
+      int threads = 1);
 
   odb::dbNet* getNet() const { return net_; };
 
@@ -78,7 +80,8 @@ class IRSolver
 
   void solve(sta::Corner* corner,
              GeneratedSourceType source_type,
-             const std::string& source_file);
+             const std::string& source_file,
+             bool hierarchical = false);
 
   void report(sta::Corner* corner) const;
   void reportEM(sta::Corner* corner) const;
@@ -126,6 +129,32 @@ class IRSolver
   template <typename T>
   using ValueNodeMap = std::map<const Node*, T>;
 
+  using Matrix = Eigen::SparseMatrix<Connection::Conductance>;
+  using MatrixSolver = Eigen::SparseLU<Matrix>;
+
+  // Grid inside a hard macro reduced to the nodes on its boundary (ports)
+  // by a Schur complement. Shared by all instances of the master with the
+  // same orientation whose grid matches the descriptor.
+  struct MacroModel
+  {
+    // Relative node locations and conductances of the grid
+    std::vector<double> descriptor;
+    // Factorized conductances between the interior nodes
+    MatrixSolver interior;
+    // Conductances from the interior nodes to the ports
+    Matrix interior_ports;
+    // -G_pi * inv(G_ii) * G_ip, added to the port conductances
+    Eigen::MatrixXd port_update;
+  };
+  // Matrix indices of the interior nodes and ports of one macro instance,
+  // in the order of its model.
+  struct MacroReduction
+  {
+    MacroModel* model = nullptr;
+    std::vector<std::size_t> interior;
+    std::vector<std::size_t> ports;
+  };
+
   odb::dbBlock* getBlock() const;
   odb::dbTech* getTech() const;
 
@@ -191,6 +220,22 @@ class IRSolver
       const std::map<Node*, std::size_t>& node_index,
       Eigen::SparseMatrix<Connection::Conductance>& G,
       Eigen::VectorXd& J) const;
+  Eigen::VectorXd solveMatrix(const Matrix& G,
+                              const Eigen::VectorXd& J,
+                              const std::map<Node*, std::size_t>& node_index,
+                              const std::string& name) const;
+  Eigen::VectorXd solveHierarchical(
+      const Matrix& G,
+      const Eigen::VectorXd& J,
+      const std::map<Node*, std::size_t>& node_index);
+  std::vector<MacroReduction> reduceMacros(
+      const Matrix& G,
+      const std::map<Node*, std::size_t>& node_index);
+  MacroModel* getMacroModel(odb::dbInst* inst,
+                            const Matrix& G,
+                            const MacroReduction& reduction,
+                            std::vector<double> descriptor);
+  void clearMacroModels();
 
   std::string getMetricKey(const std::string& key, sta::Corner* corner) const;
 
@@ -224,7 +269,15 @@ class IRSolver
   std::map<sta::Corner*, ValueNodeMap<Voltage>> voltages_;
   std::map<sta::Corner*, ValueNodeMap<Current>> currents_;
 
+  // Reduced macro models by master and orientation, kept across solves
+  std::map<std::pair<odb::dbMaster*, odb::dbOrientType::Value>,
+           std::vector<std::unique_ptr<MacroModel>>>
+      macro_models_;
+
   static constexpr Current spice_file_min_current_ = 1e-18;
+  // Macros with more ports stay in the top level grid, the port update of a
+  // model is dense in the number of ports
+  static constexpr std::size_t max_macro_ports_ = 2000;
 };
 
 }  // namespace psm
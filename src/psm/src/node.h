@@ -55,6 +55,9 @@ class Node
   const odb::Point& getPoint() const { return pt_; };
   odb::dbTechLayer* getLayer() const { return layer_; };
 
+  void setID(std::size_t id) { id_ = id; }
+  std::size_t getID() const { return id_; }
+
   void print(utl::Logger* logger, const std::string& prefix = "") const;
   virtual std::string describe(const std::string& prefix) const;
 
@@ -75,6 +78,8 @@ class Node
 
   odb::Point pt_;
   odb::dbTechLayer* layer_;
+
+  std::size_t id_ = 0;
 };
 
 class SourceNode : public Node
@@ -83,7 +83,8 @@ void PDNSim::analyzePowerGrid(odb::dbNet* net,
                               bool enable_em,
                               const std::string& em_file,
                               const std::string& error_file,
-                              const std::string& voltage_source_file)
+                              const std::string& voltage_source_file,
+                              bool hierarchical)
 {
   if (!checkConnectivity(net, false, error_file, false)) {
     return;
@@ -92,7 +93,7 @@ void PDNSim::analyzePowerGrid(odb::dbNet* net,
   last_corner_ = corner;
   auto* solver = getIRSolver(net, false);
   if (!use_prev_solution || !solver->hasSolution(corner)) {
-    solver->solve(corner, source_type, voltage_source_file);
+    solver->solve(corner, source_type, voltage_source_file, hierarchical);
   } else {
     logger_->info(utl::PSM, 11, "Reusing previous solution");
   }
@@ -158,7 +159,8 @@ psm::IRSolver* PDNSim::getIRSolver(odb::dbNet* net, bool floorplanning)
                                         logger_,
                                         user_voltages_,
                                         user_powers_,
-                                        generated_source_settings_);
+                                        generated_source_settings_,
+                                        threads_);
     addOwner(net->getBlock());
   }
 
@@ -217,6 +219,11 @@ void PDNSim::inDbPostMoveInst(odb::dbInst*)
   clearSolvers();
 }
 
+void PDNSim::inDbInstDestroy(odb::dbInst*)
+{
+  clearSolvers();
+}
+
 void PDNSim::inDbNetDestroy(odb::dbNet*)
 {
   clearSolvers();
@@ -48,10 +48,11 @@ set_net_voltage_cmd(odb::dbNet* net, Corner* corner, double voltage)
 }
 
 void 
-analyze_power_grid_cmd(odb::dbNet* net, Corner* corner, psm::GeneratedSourceType type, const char* error_file, bool reuse_solution, bool enable_em, const char* em_file, const char* voltage_file, const char* voltage_source_file)
+analyze_power_grid_cmd(odb::dbNet* net, Corner* corner, psm::GeneratedSourceType type, const char* error_file, bool reuse_solution, bool enable_em, const char* em_file, const char* voltage_file, const char* voltage_source_file, bool hierarchical)
 {
   PDNSim* pdnsim = getPDNSim();
-  pdnsim->analyzePowerGrid(net, corner, type, voltage_file, reuse_solution, enable_em, em_file, error_file, voltage_source_file);
+  pdnsim->setThreads(ord::OpenRoad::openRoad()->getThreadCount());
+  pdnsim->analyzePowerGrid(net, corner, type, voltage_file, reuse_solution, enable_em, em_file, error_file, voltage_source_file, hierarchical);
 }
 
 void
@@ -72,6 +73,7 @@ bool
 check_connectivity_cmd(odb::dbNet* net, bool floorplanning, const char* error_file, bool dont_require_bterm)
 {
   PDNSim* pdnsim = getPDNSim();
+  pdnsim->setThreads(ord::OpenRoad::openRoad()->getThreadCount());
   return pdnsim->checkConnectivity(net, floorplanning, error_file, !dont_require_bterm);
 }
 
@@ -79,6 +81,7 @@ void
 write_spice_file_cmd(odb::dbNet* net, Corner* corner, psm::GeneratedSourceType type, const char* file, const char* voltage_source_file)
 {
   PDNSim* pdnsim = getPDNSim();
+  pdnsim->setThreads(ord::OpenRoad::openRoad()->getThreadCount());
   return pdnsim->writeSpiceNetwork(net, corner, type, file, voltage_source_file);
 }
 
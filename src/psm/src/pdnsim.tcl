@@ -42,13 +42,14 @@ sta::define_cmd_args "analyze_power_grid" {
   [-vsrc voltage_source_file]
   [-source_type FULL|BUMPS|STRAPS]
   [-allow_reuse]
+  [-hierarchical]
 }
 
 proc analyze_power_grid { args } {
   sta::parse_key_args "analyze_power_grid" args \
     keys {-net -corner -voltage_file -error_file -em_outfile -vsrc \
       -source_type} \
-    flags {-enable_em -allow_reuse}
+    flags {-enable_em -allow_reuse -hierarchical}
   if { ![info exists keys(-net)] } {
     utl::error PSM 58 "Argument -net not specified."
   }
@@ -91,7 +92,8 @@ proc analyze_power_grid { args } {
     $enable_em \
     $em_file \
     $voltage_file \
-    $voltage_source_file
+    $voltage_source_file \
+    [info exists flags(-hierarchical)]
 }
 
 sta::define_cmd_args "insert_decap" { -target_cap target_cap\
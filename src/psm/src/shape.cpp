@@ -134,7 +134,7 @@ std::set<Node*> Shape::cleanupNodes(
     int min_distance,
     const IRNetwork::NodeTree& layer_nodes,
     const std::function<void(Node*, Node*)>& copy_func,
-    const std::set<Node*>& shared_nodes)
+    const IRNetwork::NodeIdSet& shared_nodes)
 {
   // Process and filter nodes
   const Node::NodeSet sorted_nodes = getNodes(layer_nodes);
@@ -183,13 +183,13 @@ std::set<Node*> Shape::cleanupNodes(
 
 Shape::NodeDataTree Shape::createNodeDataValue(
     const Node::NodeSet& nodes,
-    const std::set<Node*>& shared_nodes,
+    const IRNetwork::NodeIdSet& shared_nodes,
     std::vector<std::unique_ptr<NodeData>>& container,
     Node::NodeSet& shape_shared_nodes) const
 {
   // Build RTree of nodes for searching
   for (auto* node : nodes) {
-    if (shared_nodes.find(node) != shared_nodes.end()) {
+    if (shared_nodes[node->getID()]) {
       // don't consider shared nodes
       shape_shared_nodes.insert(node);
       continue;
@@ -35,7 +35,7 @@ class Shape
       int min_distance,
       const IRNetwork::NodeTree& layer_nodes,
       const std::function<void(Node*, Node*)>& copy_func,
-      const std::set<Node*>& shared_nodes);
+      const IRNetwork::NodeIdSet& shared_nodes);
 
   const odb::Rect& getShape() const { return shape_; }
 
@@ -63,7 +63,7 @@ class Shape
 
   NodeDataTree createNodeDataValue(
       const Node::NodeSet& nodes,
-      const std::set<Node*>& shared_nodes,
+      const IRNetwork::NodeIdSet& shared_nodes,
       std::vector<std::unique_ptr<NodeData>>& container,
       Node::NodeSet& shape_shared_nodes) const;
   std::map<Node*, std::set<Node*>> mergeNodes(
@@ -0,0 +1,21 @@
+# write_pg_spice of a network constructed on 1 and 4 threads
+source helpers.tcl
+
+read_lef Nangate45/Nangate45.lef
+read_def Nangate45_data/gcd.def
+read_liberty Nangate45/Nangate45_typ.lib
+read_sdc Nangate45_data/gcd.sdc
+
+foreach threads { 1 4 } {
+  set_thread_count $threads
+  set spice_file($threads) [make_result_file gcd_write_sp_threads$threads.sp]
+  tee -quiet -variable log "analyze_power_grid -vsrc Vsrc_gcd_vdd.loc -net VDD"
+  regexp {#+ IR report #+\n.*\n#+} $log ir_report($threads)
+  tee -quiet -variable log \
+    "write_pg_spice -vsrc Vsrc_gcd_vdd.loc -net VDD $spice_file($threads)"
+}
+
+puts $ir_report(1)
+puts "same IR report: [expr { $ir_report(1) eq $ir_report(4) }]"
+diff_files $spice_file(1) gcd_write_sp_test_vdd.spok
+diff_files $spice_file(1) $spice_file(4)
@@ -0,0 +1,83 @@
+# Compare the hierarchical solve with the flat solve on a design with macros
+source "helpers.tcl"
+
+read_lef Nangate45/Nangate45.lef
+read_lef Nangate45_data/fakeram45_64x32.lef
+
+read_def check_power_grid_macros.def
+
+set_pdnsim_net_voltage -net VDD -voltage 1.1
+set_pdnsim_inst_power \
+  -inst dcache.data.data_arrays_0.data_arrays_0_ext.mem -power 1e-2
+set_pdnsim_inst_power \
+  -inst frontend.icache.data_arrays_0.data_arrays_0_0_ext.mem -power 1e-2
+set_pdnsim_inst_power -inst PHY_0 -power 1e-4
+set_pdnsim_inst_power -inst PHY_1 -power 1e-4
+
+proc read_voltages { file } {
+  set stream [open $file r]
+  gets $stream
+  set voltages {}
+  while { [gets $stream line] >= 0 } {
+    set fields [split $line ","]
+    lappend voltages [join [lrange $fields 0 4] ","] [lindex $fields 5]
+  }
+  close $stream
+  return $voltages
+}
+
+# Returns the PSM-0094 line of a hierarchical solve and the number of
+# macro models built for it.
+proc solve_hierarchical { file } {
+  tee -quiet -variable log \
+    "analyze_power_grid -net VDD -voltage_file $file -hierarchical"
+  set line ""
+  regexp {\[INFO PSM-0094\][^\n]*} $log line
+  return [list $line [regexp -all {Building macro model} $log]]
+}
+
+proc compare_voltages { flat_file hier_file } {
+  set flat [read_voltages $flat_file]
+  set hier [read_voltages $hier_file]
+  set diffs 0
+  if { [llength $flat] != [llength $hier] } {
+    incr diffs
+  }
+  foreach { key voltage } $flat { hier_key hier_voltage } $hier {
+    if { $key ne $hier_key || abs($voltage - $hier_voltage) > 2e-6 } {
+      puts "Differences found: $key $voltage $hier_key $hier_voltage"
+      incr diffs
+    }
+  }
+  if { $diffs == 0 } {
+    puts "No differences found."
+  }
+}
+
+set_debug_level PSM solve 1
+
+set flat_file [make_result_file hierarchical_macros-flat.rpt]
+set hier_file [make_result_file hierarchical_macros-hier.rpt]
+
+tee -quiet -variable log \
+  "analyze_power_grid -net VDD -voltage_file $flat_file"
+lassign [solve_hierarchical $hier_file] line built
+regexp {Reduced (\d+) macro instances with (\d+) macro models} $line \
+  -> reduced models
+puts "macros reduced: [expr { $reduced > 0 && $models <= $reduced }]"
+puts "models built: [expr { $built == $models }]"
+compare_voltages $flat_file $hier_file
+
+# The models are cached across the solves of a grid
+lassign [solve_hierarchical $hier_file] line2 built2
+puts "second solve same reduction: [expr { $line2 eq $line }]"
+puts "second solve models built: $built2"
+compare_voltages $flat_file $hier_file
+
+# Editing the block drops the solver and its models
+odb::dbInst_destroy [[ord::get_db_block] findInst PHY_10]
+lassign [solve_hierarchical $hier_file] line3 built3
+puts "rebuilt models: [expr { $built3 == $models }]"
+tee -quiet -variable log \
+  "analyze_power_grid -net VDD -voltage_file $flat_file"
+compare_voltages $flat_file $hier_file
@@ -46,7 +46,8 @@ def analyze_power_grid(
     enable_em=False,
     em_outfile=None,
     net=None,
-    corner=None
+    corner=None,
+    hierarchical=False
 ):
     pdnsim = design.getPDNSim()
 
@@ -77,7 +78,16 @@ def analyze_power_grid(
         em_outfile = ""
 
     pdnsim.analyzePowerGrid(
-        net, corner, 2, outfile, allow_reuse, enable_em, em_outfile, error_file, vsrc
+        net,
+        corner,
+        2,
+        outfile,
+        allow_reuse,
+        enable_em,
+        em_outfile,
+        error_file,
+        vsrc,
+        hierarchical,
     )
 
 
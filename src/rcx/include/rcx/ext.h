@@ -39,7 +39,8 @@ class Ext
                      const std::string& out_file,
                      const std::string& comment,
                      const std::string& version,
-                     int pattern);
+                     int pattern,
+                     int threads = 1);
   bool define_rcx_corners(const std::string& corner_list);
   static bool get_model_corners(const std::string& ext_model_file,
                                 Logger* logger);
@@ -68,6 +69,7 @@ class Ext
                        bool diag);
   bool write_rcx_model(const char* filename);
   void write_rules(const std::string& name, const std::string& file);
+  void compile_rules(const std::string& rules_file, const std::string& file);
   void bench_verilog(const std::string& file);
 
   void bench_wires(const BenchWiresOptions& bwo);
@@ -87,6 +89,7 @@ class Ext
   void get_corners(std::list<std::string>& corner_list);
   void delete_corners();
   void adjust_rc(float res_factor, float cc_factor, float gndc_factor);
+  void compact_parasitics(bool half_precision, bool release_db);
 
   void write_spef(const SpefOptions& options);
 
@@ -286,6 +286,12 @@ class extMeasureRC : public extMeasure
   uint _lowTrackSearch[2][32];
   uint _hiTrackSearch[2][32];
 
+  // Tiled flow: CouplingFlow only extracts the wires whose base is in
+  // [_tileLo, _tileHi); the others are context.
+  bool _tiled = false;
+  int _tileLo = 0;
+  int _tileHi = 0;
+
   void resetTrackIndices(uint dir);
   int ConnectWires(uint dir, BoundaryData& bounds);
   int FindCouplingNeighbors(uint dir, BoundaryData& bounds);
@@ -1022,6 +1028,19 @@ class extMeasureRC : public extMeasure
                          int metUnder,
                          int metOver,
                          FILE* segFP);
+  // Looks the same context up in the models of all the extracted corners,
+  // rcs[model]. Returns false when the context is not modeled; a corner
+  // without a value for it gets zero values.
+  bool OverUnderRCs(int open,
+                    uint width,
+                    int dist,
+                    int met,
+                    int metUnder,
+                    int metOver,
+                    extDistRC** rcs);
+  // Adds the coupling caps of all the corners, cc[model], as ccsegs or as
+  // fringe depending on the coupling threshold.
+  void addCoupling(dbRSeg* rseg1, dbRSeg* rseg2, const double* cc);
   dbRSeg* GetRSeg(extSegment* cc);
   dbRSeg* GetRSeg(uint rsegId);
   double updateCoupCap(dbRSeg* rseg1, dbRSeg* rseg2, int jj, double v);
@@ -1054,9 +1073,9 @@ class extMeasureRC : public extMeasure
   uint ConnectAllWires(Track* track);
 
   // dkf 061824
-  bool printProgress(uint totalWiresExtracted,
-                     uint totWireCnt,
-                     float& previous_percent_extracted);
+  static bool printProgress(uint totalWiresExtracted,
+                            uint totWireCnt,
+                            float& previous_percent_extracted);
 };
 
 }  // namespace rcx
@@ -4,11 +4,24 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "extRCap.h"
 
 namespace rcx {
 
+// Totals of a calibration pattern net, as read back from the solver SPEF
+// of one corner.
+struct extPatternRC
+{
+  dbNet* net;
+  uint len;
+  double totCC;
+  double totGnd;
+  double res;
+  double contextCoupling;
+};
+
 class extModelGen : public extRCModel
 {
  public:
@@ -17,6 +30,16 @@ class extModelGen : public extRCModel
   {
   }
   uint ReadRCDB(dbBlock* block, uint widthCnt, uint diagOption, char* logFile);
+  // ReadRCDB split in its two steps: reading the pattern totals of the
+  // block, on threads, and building the tables of this model from them.
+  static void ReadPatternRCs(extMain* extMain,
+                             dbBlock* block,
+                             int threads,
+                             std::vector<extPatternRC>& patterns);
+  uint BuildRCDB(const std::vector<extPatternRC>& patterns,
+                 uint widthCnt,
+                 uint diagOption,
+                 const char* logFile);
   void writeRules(FILE* fp, bool binary, uint m, int corner = -1);
   FILE* InitWriteRules(const char* name,
                        std::list<std::string> corner_list,
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "odb/odb.h"
+
+namespace odb {
+class dbBlock;
+}
+
+namespace utl {
+class Logger;
+}
+
+namespace rcx {
+
+using odb::uint;
+using utl::Logger;
+
+// Rows of per-corner values. Rows are added as doubles and packed once
+// filled: as IEEE half precision when requested and every value is in
+// its normal range, as float otherwise.
+class extPackedValues
+{
+ public:
+  void init(uint cornerCnt);
+  void add(const double* values);
+  void pack(bool half);
+  void get(uint row, double* values) const;
+  double get(uint row, uint corner) const;
+  bool isHalf() const { return _isHalf; }
+  size_t getMemory() const;
+
+ private:
+  uint _cornerCnt = 1;
+  bool _isHalf = false;
+  std::vector<float> _float;
+  std::vector<uint16_t> _half;
+};
+
+// Extracted parasitics of a block held apart from the dbRSeg, dbCapNode
+// and dbCCSeg objects. All rows are stored column-wise:
+//  - the nodes and resistors of a net are contiguous and found through
+//    per-net offsets (CSR),
+//  - every coupling cap is one row of a pair table; each net keeps the
+//    rows it is the source of followed by the rows it is the target of,
+//    both in SPEF write order.
+// Node and resistor references are global node rows.
+class extParasiticStore
+{
+ public:
+  enum NodeType : uint8_t
+  {
+    INTERNAL,
+    ITERM,
+    BTERM,
+    NAME
+  };
+
+  // Copies the parasitics of every net with cap nodes. Node caps are the
+  // cap node values when preserveCapValues is set (SPEF read in), half of
+  // the cap of each adjacent resistor otherwise.
+  void build(odb::dbBlock* block,
+             uint cornerCnt,
+             bool preserveCapValues,
+             bool half,
+             Logger* logger);
+  void clear();
+
+  uint getCornerCount() const { return _cornerCnt; }
+  bool preserveCapValues() const { return _preserveCapValues; }
+  uint getNetCount() const { return _netIds.size(); }
+  // Store index of a db net, -1 if the net is not in the store.
+  int getNetIndex(uint netId) const;
+  uint getNetId(uint net) const { return _netIds[net]; }
+  // Total ground and coupling cap of a net.
+  void getNetCaps(uint net, double* caps) const { _netCap.get(net, caps); }
+
+  uint nodeBegin(uint net) const { return _nodeBegin[net]; }
+  uint nodeEnd(uint net) const { return _nodeBegin[net + 1]; }
+  NodeType getNodeType(uint node) const { return (NodeType) _nodeType[node]; }
+  // ITerm or BTerm id, node number of internal nodes.
+  uint getNodeObject(uint node) const { return _nodeObject[node]; }
+  const std::string& getNodeName(uint node) const;
+  uint getNodeNet(uint node) const;
+  void getNodeCaps(uint node, double* caps) const { _nodeCap.get(node, caps); }
+
+  uint resBegin(uint net) const { return _resBegin[net]; }
+  uint resEnd(uint net) const { return _resBegin[net + 1]; }
+  uint getResSource(uint res) const { return _resSource[res]; }
+  uint getResTarget(uint res) const { return _resTarget[res]; }
+  void getRes(uint res, double* values) const { _res.get(res, values); }
+
+  uint ccBegin(uint net) const { return _ccRefBegin[net]; }
+  uint ccEnd(uint net) const { return _ccRefBegin[net + 1]; }
+  uint getCC(uint ref) const { return _ccRef[ref]; }
+  uint getCCSource(uint cc) const { return _ccSource[cc]; }
+  uint getCCTarget(uint cc) const { return _ccTarget[cc]; }
+  void getCCCaps(uint cc, double* caps) const { _ccCap.get(cc, caps); }
+
+  size_t getMemory() const;
+
+ private:
+  uint _cornerCnt = 0;
+  bool _preserveCapValues = false;
+
+  std::vector<uint> _netIds;
+  std::vector<int> _netIndex;
+  extPackedValues _netCap;
+
+  std::vector<uint> _nodeBegin;
+  std::vector<uint8_t> _nodeType;
+  std::vector<uint> _nodeObject;
+  std::vector<std::string> _names;
+  extPackedValues _nodeCap;
+
+  std::vector<uint> _resBegin;
+  std::vector<uint> _resSource;
+  std::vector<uint> _resTarget;
+  extPackedValues _res;
+
+  std::vector<uint> _ccRefBegin;
+  std::vector<uint> _ccRef;
+  std::vector<uint> _ccSource;
+  std::vector<uint> _ccTarget;
+  extPackedValues _ccCap;
+};
+
+}  // namespace rcx
@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ext2dBox.h"
@@ -33,6 +35,7 @@ using namespace odb;
 class extMeasure;
 class extMeasureRC;
 struct SEQ;
+struct extTile;
 
 using odb::Ath__array1D;
 using odb::AthPool;
@@ -40,6 +43,9 @@ using odb::uint;
 using utl::Logger;
 
 class extSpef;
+class extParasiticStore;
+class extNetTracker;
+class extContextParasitics;
 class GridTable;
 
 // CoupleOptions seriously needs to be rewriten to use a class with named
@@ -359,6 +365,11 @@ class extMetRCTable
                                const char* keyword);
   // dkf 12272023
   bool GetViaRes(Ath__parser* p, Ath__parser* w, dbNet* net, FILE* logFP);
+  bool GetViaRes(Ath__parser* p,
+                 Ath__parser* w,
+                 const char* netName,
+                 double via_res,
+                 FILE* logFP);
   extViaModel* addViaModel(char* name,
                            double R,
                            uint cCnt,
@@ -535,6 +546,12 @@ class extRCModel
                          bool& overunder0,
                          bool& overunder1,
                          bool& via_res);
+  // Writes the text rules file as a compiled rules file, which the readers
+  // below map instead of parsing. From a compiled file they only read the
+  // models set by setLoadModels and the layers below setLoadLayerCnt.
+  bool compileRules(const char* rulesFile, const char* compiledFile);
+  void setLoadModels(const std::vector<uint>& models) { _loadModels = models; }
+  void setLoadLayerCnt(uint n) { _loadLayerCnt = n; }
   bool readRules(char* name,
                  bool bin,
                  bool over,
@@ -947,6 +964,12 @@ class extRCModel
 
   bool _OUREVERSEORDER{false};
 
+  // Empty and 0 read all of a compiled rules file.
+  std::vector<uint> _loadModels;
+  uint _loadLayerCnt = 0;
+  bool skipCompiledModel(Ath__parser* parser, uint model);
+  bool skipCompiledLayers(Ath__parser* parser, uint model, uint met);
+
  protected:
   Logger* logger_;
 };
@@ -1248,12 +1271,14 @@ class extMeasure
                    uint trackn,
                    Ath__array1D<SEQ*>* residueSeq);
 
-  odb::dbCCSeg* makeCcap(odb::dbRSeg* rseg1, odb::dbRSeg* rseg2, double ccCap);
-  void addCCcap(odb::dbCCSeg* ccap, double v, uint model);
+  bool isBigCcap(odb::dbRSeg* rseg1, odb::dbRSeg* rseg2, double ccCap);
   void addFringe(odb::dbRSeg* rseg1,
                  odb::dbRSeg* rseg2,
                  double frCap,
                  uint model);
+  // addCCcap and addFringe for every extracted corner, caps[model].
+  void addCCcaps(odb::dbRSeg* rseg1, odb::dbRSeg* rseg2, const double* caps);
+  void addFringes(odb::dbRSeg* rseg1, odb::dbRSeg* rseg2, const double* caps);
   void calcDiagRC(int rsegid1,
                   uint rsegid2,
                   uint len,
@@ -1707,6 +1732,32 @@ struct BoundaryData
   }
 };
 
+// Parasitics measured by one tile of couplingFlow_v2_tiles. They are
+// written to the block in tile order after the tiles are measured.
+struct extTileParasitics
+{
+  struct Value
+  {
+    uint rseg;
+    uint model;
+    double value;
+  };
+  struct Coupling
+  {
+    uint rseg1;
+    uint rseg2;
+    uint model;
+    double value;
+  };
+
+  std::vector<Value> caps;
+  std::vector<Value> res;
+  std::vector<Coupling> couplings;
+  // Running total capacitance by rseg id and model, as returned by
+  // updateTotalCap.
+  std::unordered_map<uint64_t, double> cap_totals;
+};
+
 class extMain
 {
   // --------------------- dkf 092024 ------------------------
@@ -1799,7 +1850,8 @@ class extMain
                    const char* out_file,
                    const char* comment,
                    const char* version,
-                   int pattern);
+                   int pattern,
+                   int threads = 1);
   // CLEANUP dkf 10242024 ----------------------------------
 
   uint benchVerilog_bterms(FILE* fp,
@@ -1838,6 +1890,12 @@ class extMain
 
   bool _v2;  // new flow dkf: 10302023
 
+  int _tiles = 0;  // bands per direction of couplingFlow_v2_tiles
+  int _threads = 1;
+  // Set on the threads measuring tiles so that updateTotalCap, updateRes
+  // and addCouplingCap buffer values instead of writing the block.
+  static thread_local extTileParasitics* _tileParasitics;
+
   void skip_via_wires(bool v) { _skip_via_wires = v; };
   void printUpdateCoup(uint netId1,
                        uint netId2,
@@ -1852,6 +1910,17 @@ class extMain
 
   uint couplingFlow_v2_opt(Rect& extRect, uint ccFlag, extMeasure* m);
   uint couplingFlow_v2(Rect& extRect, uint ccFlag, extMeasure* m);
+  // Splits the die into _tiles bands per direction, measured on
+  // _threads threads with private search grids and pixel planes.
+  uint couplingFlow_v2_tiles(Rect& extRect, uint ccDist);
+  void setupTile(uint dir,
+                 uint ccDist,
+                 int layerCnt,
+                 LayerDimensionData& tables,
+                 Rect& extRect,
+                 extTile& tile);
+  void measureTile(uint dir, extTile& tile);
+  void writeTileParasitics(const extTileParasitics& parasitics);
   void setBranchCapNodeId(dbNet* net, uint junction);
   void markPathHeadTerm(dbWirePath& path);
 
@@ -2056,6 +2125,18 @@ class extMain
   double updateTotalCap(odb::dbRSeg* rseg, double cap, uint modelIndex);
   bool updateCoupCap(odb::dbRSeg* rseg1, odb::dbRSeg* rseg2, int jj, double v);
   double updateRes(odb::dbRSeg* rseg, double res, uint model);
+  // Returns nullptr when the value is buffered by a tile.
+  odb::dbCCSeg* addCouplingCap(odb::dbRSeg* rseg1,
+                               odb::dbRSeg* rseg2,
+                               double v,
+                               uint model);
+  // Forms of updateTotalCap and addCouplingCap taking the values of all
+  // the extracted corners at once, caps[model].
+  void updateTotalCaps(odb::dbRSeg* rseg, const double* caps, uint modelCnt);
+  void addCouplingCaps(odb::dbRSeg* rseg1,
+                       odb::dbRSeg* rseg2,
+                       const double* caps,
+                       uint modelCnt);
 
   uint getExtBbox(int* x1, int* y1, int* x2, int* y2);
 
@@ -2174,7 +2255,8 @@ class extMain
                 bool moreToRead = false,
                 bool diff = false,
                 bool calib = false,
-                int app_print_limit = 0);
+                int app_print_limit = 0,
+                int threads = 1);
   uint readSPEFincr(char* filename);
   void writeSPEF(bool stop);
   uint writeSPEF(uint netId,
@@ -2204,7 +2286,26 @@ class extMain
                  int corner,
                  const char* corner_name,
                  const char* spef_version,
-                 bool parallel);
+                 bool parallel,
+                 int threads);
+  // Copy the extracted parasitics to a columnar store that write_spef reads
+  // from, optionally destroying the db objects they came from.
+  void compactParasitics(bool half, bool releaseDb);
+  void deleteParasiticStore();
+  // Incremental extraction: nets whose wires or terminals changed since
+  // the last extraction are re-extracted together with their coupling
+  // neighbors within ccDist pitches, in one window around each cluster of
+  // them. The parasitics of the other nets measured in the windows are
+  // kept. Changes are only tracked after extractions asking for it.
+  // beginIncremental returns false when no net changed.
+  void trackNetChanges();
+  void deleteNetTracker();
+  bool beginIncremental(uint ccDist);
+  void endIncremental();
+  void findCouplingNeighbors(uint ccDist, std::vector<odb::dbNet*>& nets);
+  bool findNetsToExtract(const char* netNames,
+                         std::vector<odb::dbNet*>& nets);
+  std::vector<odb::Rect> getExtractionWindows();
   uint writeNetSPEF(odb::dbNet* net, double resBound, uint debug);
   uint makeITermCapNode(uint id, odb::dbNet* net);
   uint makeBTermCapNode(uint id, odb::dbNet* net);
@@ -2655,6 +2756,15 @@ class extMain
   odb::dbBlock* _block = nullptr;
   uint _blockId;
   extSpef* _spef = nullptr;
+  extParasiticStore* _parasiticStore = nullptr;
+  // The db parasitics of the stored nets were destroyed.
+  bool _parasiticsReleased = false;
+  bool _trackNetChanges = false;
+  extNetTracker* _netTracker = nullptr;
+  extContextParasitics* _contextParasitics = nullptr;
+  bool _incremental = false;
+  std::vector<odb::dbNet*> _incrNets;
+  std::vector<odb::Rect> _incrWindows;
   bool _writeNameMap = true;
   bool _fullIncrSpef = false;
   bool _noFullIncrSpef = false;
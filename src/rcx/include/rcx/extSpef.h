@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "extRCap.h"
@@ -24,6 +28,9 @@ using utl::Logger;
 
 class NameTable;
 class Ath__parser;
+class extParasiticStore;
+struct extSpefMappedNet;
+struct extSpefMappedNode;
 
 class extSpef
 {
@@ -96,6 +103,12 @@ class extSpef
   uint readBlockIncr(uint debug);
   void setCalibLimit(float upperLimit, float lowerLimit);
   void printAppearance(const int* appcnt, int tapp);
+  // Write nets found in the store from it instead of the db objects.
+  void setParasiticStore(const extParasiticStore* store) { _store = store; }
+  // Read and format nets on this many threads, keeping them in order.
+  void setThreads(int threads) { _threads = threads; }
+  // Order coupling caps the way they are written out.
+  static void sortCCSegs(std::vector<odb::dbCCSeg*>& segs);
 
  private:
   void setLogger(Logger* logger);
@@ -184,6 +197,11 @@ class extSpef
   void writeInstMap();
 
   uint readDNet(uint debug);
+  // Fast path of readBlock for plain reads of uncompressed files.
+  bool canReadMapped() const;
+  bool readDNetsMapped(uint& cnt);
+  void readMappedNet(const extSpefMappedNet& rec);
+  uint getMappedCapNode(const extSpefMappedNode& node, odb::dbNet** ccNet);
   uint getSpefNode(char* nodeWord, uint* instNetId, int* nodeType);
   uint getITermId(uint instId, const char* name);
   uint getBTermId(const char* name);
@@ -268,6 +286,14 @@ class extSpef
   void writeCouplingCaps(const std::vector<odb::dbCCSeg*>& vec_cc, uint netId);
   void writeCouplingCaps(odb::dbSet<odb::dbCCSeg>& capSet, uint netId);
   void writeCouplingCapsNoSort(odb::dbSet<odb::dbCCSeg>& capSet, uint netId);
+  void writeNets(const std::vector<odb::dbNet*>& nets);
+  std::unique_ptr<extSpef> makeWriter() const;
+  // Returns false if the text could not be formatted in memory.
+  bool formatNet(odb::dbNet* net, std::string& text);
+  void writeStoredNet(odb::dbNet* net, uint index);
+  void writeStoredNode(uint node);
+  bool isStoredNodeExcluded(uint node);
+  void markStoredNet(uint index);
   void setSpefFlag(bool v);
   void setExtIds(odb::dbNet* net);
   void setExtIds();
@@ -488,6 +514,11 @@ class extSpef
   uint _childBlockInstBaseMap = 0;
   uint _childBlockNetBaseMap = 0;
 
+  const extParasiticStore* _store = nullptr;
+  int _threads = 1;
+  // Cap node ids of internal nodes by net id and node number.
+  std::unordered_map<uint64_t, uint> _mappedNodes;
+
   Logger* logger_;
 
  public:
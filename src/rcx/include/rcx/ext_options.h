@@ -60,6 +60,16 @@ struct ExtractOptions
   bool _v2 = false;
   float _version = 2.2;
   int _wire_extracted_progress_count = 50000;
+  // Bands per direction extracted in parallel by the v2 flow; 0 or 1
+  // extracts the die as a whole.
+  int tiles = 0;
+  int threads = 1;
+  // Re-extract only the nets changed since the last extraction and their
+  // coupling neighbors.
+  bool incremental = false;
+  // Record the nets changed after this extraction for a later incremental
+  // one; implied by incremental.
+  bool track_changes = false;
 
   int _dbg = 0;
 };
@@ -81,7 +91,7 @@ struct SpefOptions
   const bool term_junction_xy = false;
   const bool single_pi = false;
   const char* file = nullptr;
-  const bool gz = false;
+  bool gz = false;
   const bool stop_after_map = false;
   const bool w_clock = false;
   const bool w_conn = false;
@@ -93,6 +103,7 @@ struct SpefOptions
   const char* cap_units = "PF";
   const char* res_units = "OHM";
   bool coordinates = false;
+  int threads = 1;
 };
 
 struct ReadSpefOpts
@@ -123,6 +134,7 @@ struct ReadSpefOpts
   bool no_cap_num_collapse = false;
   const char* cap_node_map_file = nullptr;
   bool log = false;
+  int threads = 1;
 };
 
 struct DiffOptions
@@ -65,6 +65,9 @@ sta::define_cmd_args "extract_parasitics" {
     [-no_merge_via_res]
     [-skip_over_cell ]
     [-version]
+    [-tiles count]
+    [-incremental]
+    [-track_changes]
 }
 proc extract_parasitics { args } {
   sta::parse_key_args "extract_parasitics" args \
@@ -77,9 +80,11 @@ proc extract_parasitics { args } {
            -dbg
            -cc_model
            -context_depth
-           -version } \
+           -version
+           -tiles } \
     flags { -lef_res -lef_rc
-            -no_merge_via_res -skip_over_cell }
+            -no_merge_via_res -skip_over_cell -incremental
+            -track_changes }
 
   set ext_model_file ""
   if { [info exists keys(-ext_model_file)] } {
@@ -113,6 +118,8 @@ proc extract_parasitics { args } {
   set lef_res [info exists flags(-lef_res)]
   set no_merge_via_res [info exists flags(-no_merge_via_res)]
   set skip_over_cell [info exists flags(-skip_over_cell)]
+  set incremental [info exists flags(-incremental)]
+  set track_changes [info exists flags(-track_changes)]
 
   set cc_model 10
   if { [info exists keys(-cc_model)] } {
@@ -138,22 +145,29 @@ proc extract_parasitics { args } {
     set version $keys(-version)
     sta::check_positive_float "-version" $version
   }
+  set tiles 0
+  if { [info exists keys(-tiles)] } {
+    set tiles $keys(-tiles)
+    sta::check_positive_integer "-tiles" $tiles
+  }
   rcx::extract $ext_model_file $corner_cnt $max_res \
     $coupling_threshold $cc_model \
     $depth $debug_net_id $lef_res $no_merge_via_res \
-    $lef_rc $skip_over_cell $version $corner $dbg
+    $lef_rc $skip_over_cell $version $corner $dbg $tiles $incremental \
+    $track_changes
 }
 
 sta::define_cmd_args "write_spef" {
   [-net_id net_id]
   [-nets nets]
   [-coordinates]
+  [-gzip]
   filename }
 
 proc write_spef { args } {
   sta::parse_key_args "write_spef" args \
     keys { -net_id -nets } \
-    flags { -coordinates }
+    flags { -coordinates -gzip }
   sta::check_argc_eq1 "write_spef" $args
 
   set spef_file $args
@@ -169,8 +183,9 @@ proc write_spef { args } {
   }
 
   set coordinates [info exists flags(-coordinates)]
+  set gzip [info exists flags(-gzip)]
 
-  rcx::write_spef $spef_file $nets $net_id $coordinates
+  rcx::write_spef $spef_file $nets $net_id $coordinates $gzip
 }
 
 sta::define_cmd_args "adjust_rc" {
@@ -206,6 +221,23 @@ proc adjust_rc { args } {
 
   rcx::adjust_rc $res_factor $cc_factor $gndc_factor
 }
+sta::define_cmd_args "compact_parasitics" {
+    [-half_precision]
+    [-release_db]
+}
+
+proc compact_parasitics { args } {
+  sta::parse_key_args "compact_parasitics" args \
+    keys {} \
+    flags { -half_precision -release_db }
+  sta::check_argc_eq0 "compact_parasitics" $args
+
+  set half_precision [info exists flags(-half_precision)]
+  set release_db [info exists flags(-release_db)]
+
+  rcx::compact_parasitics $half_precision $release_db
+}
+
 sta::define_cmd_args "diff_spef" {
     [-file filename]
     [-spef_corner spef_num]
@@ -401,6 +433,26 @@ proc write_rules { args } {
   }
   rcx::write_rules $filename $dir $name
 }
+
+sta::define_cmd_args "compile_rules" {
+    -ext_model_file ext_model_file
+    -file filename
+}
+
+proc compile_rules { args } {
+  sta::parse_key_args "compile_rules" args \
+    keys { -ext_model_file -file } \
+    flags {}
+  sta::check_argc_eq0 "compile_rules" $args
+
+  if { ![info exists keys(-ext_model_file)] } {
+    utl::error RCX 538 "compile_rules: -ext_model_file is required."
+  }
+  if { ![info exists keys(-file)] } {
+    utl::error RCX 539 "compile_rules: -file is required."
+  }
+  rcx::compile_rules $keys(-ext_model_file) $keys(-file)
+}
 sta::define_cmd_args "bench_wires_gen" {
     [  -len		length_in_min_widths ]
     [	 -met	  	metal	 ]
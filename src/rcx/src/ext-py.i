@@ -36,18 +36,23 @@ void extract(const char* ext_model_file,
         bool skip_over_cell,
         float version,
         int corner,
-        int dbg
+        int dbg,
+        int tiles,
+        bool incremental
         );
 void
 write_spef(const char* file,
            const char* nets,
            int net_id,
-           bool coordinates);
+           bool coordinates,
+           bool gzip);
            
 void adjust_rc(double res_factor,
                double cc_factor,
                double gndc_factor);
 
+void compact_parasitics(bool half_precision, bool release_db);
+
 void diff_spef(const char* file,
           bool r_conn,
           bool r_res,
@@ -76,6 +81,8 @@ void bench_verilog(const char* file);
 void write_rules(const char* file,
             const char* name);
 
+void compile_rules(const char* rules_file, const char* file);
+
 void read_spef(const char* file);
 
 %}
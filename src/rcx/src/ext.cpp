@@ -48,6 +48,17 @@ void Ext::write_rules(const std::string& name, const std::string& file)
   _ext->setBlockFromChip();
   _ext->writeRules(name.c_str(), file.c_str());
 }
+void Ext::compile_rules(const std::string& rules_file,
+                        const std::string& file)
+{
+  extRCModel* m = new extRCModel("MINTYPMAX", logger_);
+  const bool compiled = m->compileRules(rules_file.c_str(), file.c_str());
+  delete m;
+  if (!compiled) {
+    logger_->error(
+        RCX, 537, "Cannot compile rules file {}.", rules_file.c_str());
+  }
+}
 void Ext::bench_wires(const BenchWiresOptions& bwo)
 {
   extMainOptions opt;
@@ -227,6 +238,10 @@ void Ext::extract(ExtractOptions options)
   }
   _ext->setExtractionOptions_v2(options);
 
+  if (options.incremental && !_ext->beginIncremental(options.cc_model)) {
+    return;
+  }
+
   if (_ext->_v2)
     _ext->makeBlockRCsegs_v2(options.net, options.ext_model_file);
   else
@@ -238,6 +253,7 @@ void Ext::extract(ExtractOptions options)
                           options.coupling_threshold,
                           options.context_depth,
                           options.ext_model_file);
+  _ext->endIncremental();
 }
 
 void Ext::adjust_rc(float res_factor, float cc_factor, float gndc_factor)
@@ -245,6 +261,12 @@ void Ext::adjust_rc(float res_factor, float cc_factor, float gndc_factor)
   _ext->adjustRC(res_factor, cc_factor, gndc_factor);
 }
 
+void Ext::compact_parasitics(bool half_precision, bool release_db)
+{
+  _ext->setBlockFromChip();
+  _ext->compactParasitics(half_precision, release_db);
+}
+
 void Ext::write_spef_nets(odb::dbObject* block,
                           bool flatten,
                           bool parallel,
@@ -294,7 +316,8 @@ void Ext::write_spef(const SpefOptions& options)
                   options.corner,
                   name,
                   spef_version_,
-                  options.parallel);
+                  options.parallel,
+                  options.threads);
 }
 
 void Ext::read_spef(ReadSpefOpts& opt)
@@ -343,7 +366,8 @@ void Ext::read_spef(ReadSpefOpts& opt)
                  opt.more_to_read,
                  false /*diff*/,
                  false /*calibrate*/,
-                 opt.app_print_limit);
+                 opt.app_print_limit,
+                 opt.threads);
 
   for (int ii = 1; ii < parser.getWordCnt(); ii++) {
     _ext->readSPEFincr(parser.get(ii));
@@ -428,7 +452,8 @@ bool Ext::gen_rcx_model(const std::string& spef_file_list,
                         const std::string& out_file,
                         const std::string& comment,
                         const std::string& version,
-                        int pattern)
+                        int pattern,
+                        int threads)
 {
   _ext->setBlockFromChip();
 
@@ -461,7 +486,8 @@ bool Ext::gen_rcx_model(const std::string& spef_file_list,
                     out_file.c_str(),
                     comment.c_str(),
                     version.c_str(),
-                    pattern);
+                    pattern,
+                    threads);
   return true;
 }
 bool Ext::define_rcx_corners(const std::string& corner_list)
@@ -47,7 +47,10 @@ extract(const char* ext_model_file,
         bool skip_over_cell,
         float version,
         int corner,
-        int dbg
+        int dbg,
+        int tiles,
+        bool incremental,
+        bool track_changes
         )
 {
   Ext* ext = getOpenRCX();
@@ -72,6 +75,10 @@ extract(const char* ext_model_file,
   opts._version= version;
 
   opts._dbg= dbg;
+  opts.tiles = tiles;
+  opts.threads = ord::getOpenRoad()->getThreadCount();
+  opts.incremental = incremental;
+  opts.track_changes = track_changes;
   
   ext->extract(opts);
 }
@@ -80,7 +87,8 @@ void
 write_spef(const char* file,
            const char* nets,
            int net_id,
-           bool coordinates)
+           bool coordinates,
+           bool gzip)
 {
   Ext* ext = getOpenRCX();
 
@@ -91,6 +99,8 @@ write_spef(const char* file,
   opts.nets = nets;
   opts.net_id = net_id;
   opts.coordinates= coordinates;
+  opts.gz = gzip;
+  opts.threads = ord::getOpenRoad()->getThreadCount();
   
   ext->write_spef(opts);
 }
@@ -104,6 +114,13 @@ adjust_rc(double res_factor,
   ext->adjust_rc(res_factor, cc_factor, gndc_factor);
 }
 
+void
+compact_parasitics(bool half_precision, bool release_db)
+{
+  Ext* ext = getOpenRCX();
+  ext->compact_parasitics(half_precision, release_db);
+}
+
 void
 diff_spef(const char* file,
           bool r_conn,
@@ -180,6 +197,13 @@ write_rules(const char* file,
   ext->write_rules(name, file);
 }
 
+void
+compile_rules(const char* rules_file, const char* file)
+{
+  Ext* ext = getOpenRCX();
+  ext->compile_rules(rules_file, file);
+}
+
 void
 gen_rcx_model( const char *spef_file_list,
                     const char *corner_list,
@@ -190,7 +214,8 @@ gen_rcx_model( const char *spef_file_list,
 {
   Ext* ext = getOpenRCX();
   
-  ext->gen_rcx_model(spef_file_list, corner_list, out_file, comment, version, pattern);
+  ext->gen_rcx_model(spef_file_list, corner_list, out_file, comment, version, pattern,
+                     ord::getOpenRoad()->getThreadCount());
 }
 void
 define_rcx_corners(const char *corner_list)
@@ -220,6 +245,7 @@ read_spef(const char* file)
   
   ReadSpefOpts opts;
   opts.file = file;
+  opts.threads = ord::getOpenRoad()->getThreadCount();
   
   ext->read_spef(opts);
 }
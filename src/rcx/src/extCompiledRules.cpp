@@ -0,0 +1,331 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#include "extCompiledRules.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "parse.h"
+#include "rcx/extRCap.h"
+#include "utl/Logger.h"
+
+namespace rcx {
+
+using utl::RCX;
+
+static constexpr char kMagic[8] = {'R', 'C', 'X', 'R', 'U', 'L', 'E', 'S'};
+static constexpr uint32_t kVersion = 1;
+
+struct CompiledHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t sections;
+  uint32_t modelCnt;
+  uint32_t reserved;
+  uint64_t recordsSize;
+};
+
+template <typename T>
+static void put(std::string& out, const T& value)
+{
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static T take(const char*& pos)
+{
+  T value;
+  std::memcpy(&value, pos, sizeof(T));
+  pos += sizeof(T);
+  return value;
+}
+
+extCompiledRules::~extCompiledRules()
+{
+  if (_addr != nullptr) {
+    munmap(_addr, _size);
+  }
+}
+
+bool extCompiledRules::isCompiled(const char* name)
+{
+  FILE* fp = fopen(name, "rb");
+  if (fp == nullptr) {
+    return false;
+  }
+  char magic[sizeof(kMagic)];
+  const bool compiled = fread(magic, 1, sizeof(magic), fp) == sizeof(magic)
+                        && std::memcmp(magic, kMagic, sizeof(magic)) == 0;
+  fclose(fp);
+  return compiled;
+}
+
+bool extCompiledRules::compile(const char* rulesFile,
+                               const char* compiledFile,
+                               const uint32_t sections,
+                               utl::Logger* logger)
+{
+  std::string records;
+  std::vector<Model> models;
+  uint64_t lineCnt = 0;
+
+  auto closeModel = [&](const uint64_t offset) {
+    if (!models.empty() && models.back().end == 0) {
+      models.back().end = offset;
+      if (models.back().tail == 0) {
+        models.back().tail = offset;
+      }
+    }
+  };
+
+  // Same separators as extRCModel::readRules.
+  Ath__parser parser(logger);
+  parser.addSeparator("\r");
+  parser.openFile(rulesFile);
+  while (parser.parseNextLine() > 0) {
+    const uint64_t offset = records.size();
+    const int wordCnt = parser.getWordCnt();
+    if (parser.isKeyword(0, "DensityModel")) {
+      closeModel(offset);
+      models.emplace_back();
+      models.back().id = parser.getInt(1);
+      models.back().begin = offset;
+    } else if (parser.isKeyword(0, "VIARES") && !models.empty()
+               && models.back().tail == 0) {
+      models.back().tail = offset;
+    }
+
+    put<uint8_t>(records, wordCnt);
+    for (int ii = 0; ii < wordCnt; ii++) {
+      const char* word = parser.get(ii);
+      const uint16_t len = strlen(word);
+      char* numEnd = nullptr;
+      const double value = strtod(word, &numEnd);
+      const bool isNumber = len > 0 && *numEnd == '\0';
+      put<uint8_t>(records, isNumber);
+      put<uint16_t>(records, len);
+      records.append(word, len + 1);
+      if (isNumber) {
+        put<double>(records, value);
+      }
+    }
+    lineCnt++;
+  }
+  closeModel(records.size());
+
+  std::string head;
+  CompiledHeader header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.sections = sections;
+  header.modelCnt = models.size();
+  header.reserved = 0;
+  header.recordsSize = records.size();
+  put(head, header);
+  for (const Model& model : models) {
+    put<int64_t>(head, model.id);
+    put<uint64_t>(head, model.begin);
+    put<uint64_t>(head, model.tail);
+    put<uint64_t>(head, model.end);
+  }
+
+  std::ofstream out(compiledFile, std::ios::binary);
+  if (!out) {
+    logger->warn(RCX, 533, "Cannot open file {} for writing.", compiledFile);
+    return false;
+  }
+  out.write(head.data(), head.size());
+  out.write(records.data(), records.size());
+  logger->info(RCX,
+               534,
+               "Compiled {} lines and {} models of {} into {}.",
+               lineCnt,
+               models.size(),
+               rulesFile,
+               compiledFile);
+  return true;
+}
+
+bool extCompiledRules::open(const char* name, utl::Logger* logger)
+{
+  const int fd = ::open(name, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(CompiledHeader)) {
+    close(fd);
+    return false;
+  }
+  _size = st.st_size;
+  _addr = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (_addr == MAP_FAILED) {
+    _addr = nullptr;
+    return false;
+  }
+
+  const char* pos = static_cast<const char*>(_addr);
+  const char* fileEnd = pos + _size;
+  const CompiledHeader header = take<CompiledHeader>(pos);
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    return false;
+  }
+  if (header.version != kVersion) {
+    logger->warn(RCX,
+                 535,
+                 "Compiled rules file {} has version {}, expected {}. "
+                 "Compile it again with compile_rules.",
+                 name,
+                 header.version,
+                 kVersion);
+    return false;
+  }
+  const size_t modelSize = 4 * sizeof(uint64_t);
+  if ((size_t) (fileEnd - pos)
+      < header.modelCnt * modelSize + header.recordsSize) {
+    return false;
+  }
+  _sections = header.sections;
+  _models.resize(header.modelCnt);
+  for (Model& model : _models) {
+    model.id = take<int64_t>(pos);
+    model.begin = take<uint64_t>(pos);
+    model.tail = take<uint64_t>(pos);
+    model.end = take<uint64_t>(pos);
+  }
+  _records = pos;
+  _recordsSize = header.recordsSize;
+  return true;
+}
+
+const extCompiledRules::Model* extCompiledRules::findModel(const int id) const
+{
+  for (const Model& model : _models) {
+    if (model.id == id) {
+      return &model;
+    }
+  }
+  return nullptr;
+}
+
+const char* extCompiledRules::readRecord(const char* pos,
+                                         Word* words,
+                                         const int maxWordCnt,
+                                         int& wordCnt)
+{
+  wordCnt = take<uint8_t>(pos);
+  for (int ii = 0; ii < wordCnt; ii++) {
+    Word word;
+    word.isNumber = take<uint8_t>(pos);
+    word.len = take<uint16_t>(pos);
+    word.str = pos;
+    pos += word.len + 1;
+    word.value = word.isNumber ? take<double>(pos) : 0.0;
+    if (ii < maxWordCnt) {
+      words[ii] = word;
+    }
+  }
+  wordCnt = std::min(wordCnt, maxWordCnt);
+  return pos;
+}
+
+bool extRCModel::compileRules(const char* rulesFile, const char* compiledFile)
+{
+  bool res_over = false;
+  bool over = false;
+  bool under = false;
+  bool overUnder = false;
+  bool diag_under = false;
+  bool over0 = false;
+  bool over1 = false;
+  bool under0 = false;
+  bool under1 = false;
+  bool overunder0 = false;
+  bool overunder1 = false;
+  bool via_res = false;
+  spotModelsInRules((char*) rulesFile,
+                    false,
+                    res_over,
+                    over,
+                    under,
+                    overUnder,
+                    diag_under,
+                    over0,
+                    over1,
+                    under0,
+                    under1,
+                    overunder0,
+                    overunder1,
+                    via_res);
+
+  uint32_t sections = 0;
+  const std::pair<bool, extRulesSection> spotted[]
+      = {{res_over, kRulesResOver},
+         {over, kRulesOver},
+         {under, kRulesUnder},
+         {overUnder, kRulesOverUnder},
+         {diag_under, kRulesDiagUnder},
+         {over0, kRulesOver0},
+         {over1, kRulesOver1},
+         {under0, kRulesUnder0},
+         {under1, kRulesUnder1},
+         {overunder0, kRulesOverUnder0},
+         {overunder1, kRulesOverUnder1},
+         {via_res, kRulesViaRes}};
+  for (const auto& [found, section] : spotted) {
+    if (found) {
+      sections |= section;
+    }
+  }
+  return extCompiledRules::compile(
+      rulesFile, compiledFile, sections, logger_);
+}
+
+bool extRCModel::skipCompiledModel(Ath__parser* parser, const uint model)
+{
+  const extCompiledRules* rules = parser->getCompiledRules();
+  if (rules == nullptr || _loadModels.empty()
+      || std::find(_loadModels.begin(), _loadModels.end(), model)
+             != _loadModels.end()) {
+    return false;
+  }
+  const extCompiledRules::Model* section = rules->findModel(model);
+  if (section == nullptr) {
+    return false;
+  }
+  parser->seekRecord(section->end);
+  return true;
+}
+
+bool extRCModel::skipCompiledLayers(Ath__parser* parser,
+                                    const uint model,
+                                    const uint met)
+{
+  const extCompiledRules* rules = parser->getCompiledRules();
+  if (rules == nullptr || _loadLayerCnt == 0 || met < _loadLayerCnt) {
+    return false;
+  }
+  const extCompiledRules::Model* section = rules->findModel(model);
+  if (section == nullptr) {
+    return false;
+  }
+  parser->seekRecord(section->tail);
+  return true;
+}
+
+}  // namespace rcx
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "utl/Logger.h"
+
+namespace rcx {
+
+// Sections spotted in a rules file by extRCModel::spotModelsInRules.
+enum extRulesSection : uint32_t
+{
+  kRulesResOver = 1 << 0,
+  kRulesOver = 1 << 1,
+  kRulesUnder = 1 << 2,
+  kRulesOverUnder = 1 << 3,
+  kRulesDiagUnder = 1 << 4,
+  kRulesOver0 = 1 << 5,
+  kRulesOver1 = 1 << 6,
+  kRulesUnder0 = 1 << 7,
+  kRulesUnder1 = 1 << 8,
+  kRulesOverUnder0 = 1 << 9,
+  kRulesOverUnder1 = 1 << 10,
+  kRulesViaRes = 1 << 11
+};
+
+// A text rules file compiled by compile_rules. Every non empty line is a
+// record of its words as Ath__parser splits them, numbers already
+// converted. The offsets of the DensityModel sections and of the end of
+// their Metal sections let the readers jump over the corners and the top
+// layers that are not extracted. The file is mapped, so only the records
+// read are paged in. Records use the byte order of the machine that wrote
+// them.
+class extCompiledRules
+{
+ public:
+  struct Word
+  {
+    const char* str;
+    uint32_t len;
+    bool isNumber;
+    double value;
+  };
+
+  struct Model
+  {
+    int id = -1;
+    // Record offsets of the DensityModel line, of the first line after
+    // its Metal sections and of the next DensityModel line.
+    uint64_t begin = 0;
+    uint64_t tail = 0;
+    uint64_t end = 0;
+  };
+
+  ~extCompiledRules();
+
+  static bool isCompiled(const char* name);
+  static bool compile(const char* rulesFile,
+                      const char* compiledFile,
+                      uint32_t sections,
+                      utl::Logger* logger);
+
+  bool open(const char* name, utl::Logger* logger);
+  const char* begin() const { return _records; }
+  const char* end() const { return _records + _recordsSize; }
+  uint32_t getSections() const { return _sections; }
+  const Model* findModel(int id) const;
+
+  // Decodes the record at pos into words and returns the next record.
+  static const char* readRecord(const char* pos,
+                                Word* words,
+                                int maxWordCnt,
+                                int& wordCnt);
+
+ private:
+  void* _addr = nullptr;
+  size_t _size = 0;
+  const char* _records = nullptr;
+  uint64_t _recordsSize = 0;
+  uint32_t _sections = 0;
+  std::vector<Model> _models;
+};
+
+}  // namespace rcx
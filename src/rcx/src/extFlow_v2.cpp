@@ -1,9 +1,11 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright (c) 2024-2025, The OpenROAD Authors
 
+#include <algorithm>
 #include <map>
 #include <vector>
 
+#include "extCompiledRules.h"
 #include "grids.h"
 #include "gseq.h"
 #include "parse.h"
@@ -247,6 +249,203 @@ uint extMain::couplingFlow_v2(Rect& extRect, uint ccDist, extMeasure* m1)
 
   return 0;
 }
+thread_local extTileParasitics* extMain::_tileParasitics = nullptr;
+
+// One band of couplingFlow_v2_tiles. Wires whose base is in [lo, hi) are
+// extracted; the halo around the band only provides their context.
+struct extTile
+{
+  int lo = 0;
+  int hi = 0;
+  extMeasureRC* mrc = nullptr;
+  GridTable* search = nullptr;
+  gs* geomSeq = nullptr;
+  extTileParasitics parasitics;
+  uint wireCnt = 0;
+};
+
+void extMain::setupTile(uint dir,
+                        uint ccDist,
+                        int layerCnt,
+                        LayerDimensionData& tables,
+                        Rect& extRect,
+                        extTile& tile)
+{
+  const int maxPitch = tables.pitchTable[layerCnt - 1];
+  const int halo = std::max(ccDist, 10u) * maxPitch;
+
+  BoundaryData bounds;
+  setupBoundaries(bounds, extRect);
+  updateBoundaries(bounds, dir, ccDist, maxPitch);
+  bounds.lo_gs[dir] = std::max(bounds.ll[dir], tile.lo - halo);
+  bounds.hi_gs[dir] = std::min(bounds.hi_gs[dir], tile.hi + halo);
+  bounds.lo_search[dir] = bounds.lo_gs[dir];
+  bounds.hi_search[dir] = bounds.hi_gs[dir];
+
+  extMeasureRC* mrc = new extMeasureRC(logger_);
+  initRunEnv(*mrc);
+  mrc->_seqmentPool = new AthPool<extSegment>(1024);
+  mrc->_tiled = true;
+  mrc->_tileLo = tile.lo;
+  mrc->_tileHi = tile.hi;
+
+  // The search grids and pixel planes are built through _search and
+  // _geomSeq, and fill_gs4 marks the over-cell instances with the dbInst
+  // user flag, so this part is serial; the tile keeps them afterwards.
+  _seqPool = mrc->_seqPool;
+  initSearchForNets(tables.baseX,
+                    tables.baseY,
+                    tables.pitchTable,
+                    tables.widthTable,
+                    tables.dirTable,
+                    extRect,
+                    true);
+  _search->setV2(_v2);
+  setExtControl_v2(_seqPool);
+  _search->initCouplingCapLoops_v2(dir, ccDist);
+
+  fill_gs4(dir,
+           bounds.ll,
+           bounds.ur,
+           bounds.lo_gs,
+           bounds.hi_gs,
+           layerCnt,
+           tables.dirTable,
+           tables.pitchTable,
+           tables.widthTable);
+  addPowerNets(dir, bounds.lo_search, bounds.hi_search, 11);
+  addSignalNets(dir, bounds.lo_search, bounds.hi_search, 9);
+
+  mrc->_rotatedGs = getRotatedFlag();
+  mrc->_pixelTable = _geomSeq;
+  mrc->_search = _search;
+
+  tile.mrc = mrc;
+  tile.search = _search;
+  tile.geomSeq = _geomSeq;
+  _search = nullptr;
+  _geomSeq = nullptr;
+  _seqPool = nullptr;
+}
+
+void extMain::measureTile(uint dir, extTile& tile)
+{
+  _tileParasitics = &tile.parasitics;
+
+  extMeasureRC* mrc = tile.mrc;
+  mrc->ConnectWires(dir);
+  mrc->FindCouplingNeighbors(dir, 10, 5);
+  float previous_percent_extracted = 0.0;
+  mrc->CouplingFlow(dir, 10, 5, 0, tile.wireCnt, previous_percent_extracted);
+
+  _tileParasitics = nullptr;
+}
+
+void extMain::writeTileParasitics(const extTileParasitics& parasitics)
+{
+  for (const extTileParasitics::Value& cap : parasitics.caps) {
+    updateTotalCap(dbRSeg::getRSeg(_block, cap.rseg), cap.value, cap.model);
+  }
+  for (const extTileParasitics::Value& res : parasitics.res) {
+    updateRes(dbRSeg::getRSeg(_block, res.rseg), res.value, res.model);
+  }
+  // The corners of a coupling are buffered together; they share the
+  // search for the merged ccseg.
+  const extTileParasitics::Coupling* prev = nullptr;
+  dbCCSeg* ccap = nullptr;
+  for (const extTileParasitics::Coupling& cc : parasitics.couplings) {
+    if (prev == nullptr || prev->rseg1 != cc.rseg1 || prev->rseg2 != cc.rseg2) {
+      ccap = addCouplingCap(dbRSeg::getRSeg(_block, cc.rseg1),
+                            dbRSeg::getRSeg(_block, cc.rseg2),
+                            cc.value,
+                            cc.model);
+    } else {
+      ccap->addCapacitance(cc.value, cc.model);
+    }
+    prev = &cc;
+  }
+}
+
+uint extMain::couplingFlow_v2_tiles(Rect& extRect, uint ccDist)
+{
+  if (_ccContextDepth) {
+    initContextArray();
+  }
+  // Shared by the tiles; the v2 flow only reads them
+  initDgContextArray();
+
+  LayerDimensionData tables;
+  initializeLayerTables(tables);
+
+  uint totWireCnt;
+  const int layerCnt = initSearch(tables, extRect, totWireCnt);
+  // Every tile gets its own search grid
+  delete _search;
+  _search = nullptr;
+
+  const int maxPitch = tables.pitchTable[layerCnt - 1];
+  const int threads = std::max(_threads, 1);
+  logger_->info(RCX,
+                514,
+                "Extracting coupling in {} tiles per direction on {} "
+                "threads.",
+                _tiles,
+                threads);
+
+  uint totalWiresExtracted = 0;
+  float previous_percent_extracted = 0.0;
+  for (int dir = 1; dir >= 0; dir--) {  // dir==1 Horizontal wires
+    if (dir == 0) {
+      enableRotatedFlag();
+    }
+    // Same wires as updateBoundaries selects for the whole die
+    BoundaryData bounds;
+    setupBoundaries(bounds, extRect);
+    const int lo = bounds.ll[dir];
+    const int hi = bounds.ur[dir] + 5 * ccDist * maxPitch;
+    const int step = (hi - lo + _tiles - 1) / _tiles;
+
+    // Tiles are set up and measured a batch at a time to bound memory.
+    // Only the measurement is parallel: setupTile goes through extMain
+    // members and db flags. Each setup still walks all the nets of the
+    // block to keep the shapes of its band and halo, so the serial part
+    // grows with the number of tiles.
+    for (int first = 0; first < _tiles; first += threads) {
+      const int tileCnt = std::min(threads, _tiles - first);
+      std::vector<extTile> tiles(tileCnt);
+      for (int ii = 0; ii < tileCnt; ii++) {
+        extTile& tile = tiles[ii];
+        tile.lo = lo + (first + ii) * step;
+        tile.hi = first + ii == _tiles - 1 ? hi : tile.lo + step;
+        setupTile(dir, ccDist, layerCnt, tables, extRect, tile);
+      }
+
+#pragma omp parallel for num_threads(threads) schedule(dynamic)
+      for (int ii = 0; ii < tileCnt; ii++) {
+        measureTile(dir, tiles[ii]);
+      }
+
+      // Written in tile order so the parasitics do not depend on the
+      // thread count.
+      for (extTile& tile : tiles) {
+        writeTileParasitics(tile.parasitics);
+        totalWiresExtracted += tile.wireCnt;
+
+        delete tile.geomSeq;
+        delete tile.search;
+        delete tile.mrc->_seqmentPool;
+        tile.mrc->_seqmentPool = nullptr;
+        delete tile.mrc;
+      }
+      extMeasureRC::printProgress(
+          totalWiresExtracted, totWireCnt, previous_percent_extracted);
+    }
+  }
+  // delete wire tables  used during diagonal coupling in v1 modeling
+  removeDgContextArray();
+
+  return 0;
+}
 uint extMain::couplingFlow_v2_opt(Rect& extRect, uint ccDist, extMeasure* m1)
 {
   ccDist
@@ -689,6 +888,22 @@ bool extRCModel::spotModelsInRules(char* name,
   // parser.setDbg(1);
   parser.addSeparator("\r");
   parser.openFile(name);
+  if (const extCompiledRules* rules = parser.getCompiledRules()) {
+    const uint32_t sections = rules->getSections();
+    res_over = sections & kRulesResOver;
+    over = sections & kRulesOver;
+    under = sections & kRulesUnder;
+    overUnder = sections & kRulesOverUnder;
+    diag_under = sections & kRulesDiagUnder;
+    over0 = sections & kRulesOver0;
+    over1 = sections & kRulesOver1;
+    under0 = sections & kRulesUnder0;
+    under1 = sections & kRulesUnder1;
+    overunder0 = sections & kRulesOverUnder0;
+    overunder1 = sections & kRulesOverUnder1;
+    via_res = sections & kRulesViaRes;
+    return true;
+  }
   while (parser.parseNextLine() > 0) {
     if (parser.getWordCnt() == 3 && parser.isKeyword(0, "Metal")) {
       // DBG int met= parser.getInt(1);
@@ -762,6 +977,16 @@ bool extRCModel::readRules(char* name,
                     overunder1,
                     via_res);
 
+  if (cornerCnt > 0) {
+    // Corners are looked up by their model and by their position.
+    std::vector<uint> models{0};
+    for (uint jj = 0; jj < cornerCnt; jj++) {
+      models.push_back(cornerTable[jj]);
+      models.push_back(jj);
+    }
+    setLoadModels(models);
+  }
+
   diag = false;
   uint cnt = 0;
   _ruleFileName = strdup(name);
@@ -835,6 +1060,9 @@ bool extRCModel::readRules(char* name,
     if (parser.isKeyword(0, "DensityModel")) {
       uint m = parser.getInt(1);
       uint modelIndex = m;
+      if (skipCompiledModel(&parser, modelIndex)) {
+        continue;
+      }
       bool skipModel = false;
       /*
       if (cornerCnt > 0) {
@@ -859,6 +1087,9 @@ bool extRCModel::readRules(char* name,
       bool res_skipModel = false;
 
       for (uint ii = 1; ii < _layerCnt; ii++) {
+        if (skipCompiledLayers(&parser, modelIndex, ii)) {
+          break;
+        }
         if (res_over) {
           cnt += readRules_v2(&parser,
                               modelIndex,
@@ -1091,11 +1322,17 @@ bool extRCModel::readRules_v2(char* name,
     if (parser.isKeyword(0, "DensityModel")) {
       uint m = parser.getInt(1);
       uint modelIndex = m;
+      if (skipCompiledModel(&parser, modelIndex)) {
+        continue;
+      }
       bool skipModel = false;
       bool res_skipModel = false;
 
       // Loop to read all sections of the Model file per Metal Level
       for (uint ii = 1; ii < _layerCnt; ii++) {
+        if (skipCompiledLayers(&parser, modelIndex, ii)) {
+          break;
+        }
         if (res_over) {
           cnt += readRules_v2(&parser,
                               modelIndex,
@@ -0,0 +1,526 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#include "extIncremental.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "odb/db.h"
+#include "odb/dbWireGeometry.h"
+#include "odb/geom.h"
+#include "rcx/extRCap.h"
+#include "util.h"
+#include "utl/Logger.h"
+
+namespace rcx {
+
+using odb::dbBlock;
+using odb::dbBTerm;
+using odb::dbCCSeg;
+using odb::dbITerm;
+using odb::dbNet;
+using odb::dbRSeg;
+using odb::dbTechLayer;
+using odb::dbWire;
+using odb::dbWireGeometry;
+using odb::dbWireRects;
+using odb::Rect;
+using utl::RCX;
+
+void extNetTracker::addNet(dbNet* net)
+{
+  if (net != nullptr && !net->getSigType().isSupply()) {
+    _netIds.insert(net->getId());
+  }
+}
+
+void extNetTracker::inDbNetDestroy(dbNet* net)
+{
+  // The nets it coupled to lose their coupling caps with it.
+  std::vector<dbNet*> nets{net};
+  std::vector<dbNet*> haloNets;
+  net->getBlock()->getCcHaloNets(nets, haloNets);
+  for (dbNet* haloNet : haloNets) {
+    addNet(haloNet);
+  }
+  _netIds.erase(net->getId());
+}
+
+void extNetTracker::inDbITermPostConnect(dbITerm* iterm)
+{
+  addNet(iterm->getNet());
+}
+
+void extNetTracker::inDbITermPostDisconnect(dbITerm* iterm, dbNet* net)
+{
+  addNet(net);
+}
+
+void extNetTracker::inDbBTermPostConnect(dbBTerm* bterm)
+{
+  addNet(bterm->getNet());
+}
+
+void extNetTracker::inDbBTermPostDisConnect(dbBTerm* bterm, dbNet* net)
+{
+  addNet(net);
+}
+
+void extNetTracker::inDbWireCreate(dbWire* wire)
+{
+  addNet(wire->getNet());
+}
+
+void extNetTracker::inDbWireDestroy(dbWire* wire)
+{
+  addNet(wire->getNet());
+}
+
+void extNetTracker::inDbWirePostModify(dbWire* wire)
+{
+  addNet(wire->getNet());
+}
+
+void extNetTracker::inDbWirePostAttach(dbWire* wire)
+{
+  addNet(wire->getNet());
+}
+
+void extNetTracker::inDbWirePreDetach(dbWire* wire)
+{
+  addNet(wire->getNet());
+}
+
+void extNetTracker::attach(dbBlock* block)
+{
+  addOwner(block);
+  _block = block;
+  _netIds.clear();
+}
+
+void extNetTracker::getNets(dbBlock* block, std::vector<dbNet*>& nets) const
+{
+  for (const uint id : _netIds) {
+    dbNet* net = dbNet::getValidNet(block, id);
+    if (net != nullptr) {
+      nets.push_back(net);
+    }
+  }
+}
+
+uint64_t extContextParasitics::ccKey(dbCCSeg* cc)
+{
+  return ((uint64_t) cc->getSourceCapNode()->getId() << 32)
+         | cc->getTargetCapNode()->getId();
+}
+
+void extContextParasitics::clear()
+{
+  *this = extContextParasitics();
+}
+
+void extContextParasitics::save(const std::vector<dbNet*>& nets,
+                                const uint cornerCnt)
+{
+  clear();
+  _cornerCnt = cornerCnt;
+  for (dbNet* net : nets) {
+    _netIds.push_back(net->getId());
+    _netSet.insert(net->getId());
+  }
+  std::vector<dbCCSeg*> segs;
+  for (dbNet* net : nets) {
+    for (dbRSeg* rc : net->getRSegs()) {
+      _rsegIds.push_back(rc->getId());
+      for (uint ii = 0; ii < _cornerCnt; ii++) {
+        _rsegCaps.push_back(rc->getCapacitance(ii));
+      }
+    }
+    segs.clear();
+    net->getSrcCCSegs(segs);
+    for (dbCCSeg* cc : segs) {
+      if (_netSet.count(cc->getTargetNet()->getId()) == 0) {
+        continue;
+      }
+      _ccRows[ccKey(cc)] = _ccCaps.size() / std::max(_cornerCnt, 1u);
+      for (uint ii = 0; ii < _cornerCnt; ii++) {
+        _ccCaps.push_back(cc->getCapacitance(ii));
+      }
+    }
+  }
+}
+
+void extContextParasitics::restore(dbBlock* block)
+{
+  for (uint jj = 0; jj < _rsegIds.size(); jj++) {
+    dbRSeg* rc = dbRSeg::getRSeg(block, _rsegIds[jj]);
+    for (uint ii = 0; ii < _cornerCnt; ii++) {
+      rc->setCapacitance(_rsegCaps[jj * _cornerCnt + ii], ii);
+    }
+  }
+
+  // Coupling caps created between two context nets are dropped, the
+  // pre-existing ones get their values back.
+  std::vector<bool> restored(_ccRows.size(), false);
+  std::vector<dbCCSeg*> segs;
+  std::vector<dbCCSeg*> stale;
+  for (const uint netId : _netIds) {
+    segs.clear();
+    dbNet::getNet(block, netId)->getSrcCCSegs(segs);
+    for (dbCCSeg* cc : segs) {
+      if (_netSet.count(cc->getTargetNet()->getId()) == 0) {
+        continue;
+      }
+      auto row = _ccRows.find(ccKey(cc));
+      if (row == _ccRows.end() || restored[row->second]) {
+        stale.push_back(cc);
+        continue;
+      }
+      restored[row->second] = true;
+      for (uint ii = 0; ii < _cornerCnt; ii++) {
+        cc->setCapacitance(_ccCaps[row->second * _cornerCnt + ii], ii);
+      }
+    }
+  }
+  for (dbCCSeg* cc : stale) {
+    dbCCSeg::destroy(cc);
+  }
+}
+
+namespace {
+
+// Uniform grid of rectangles over the die, for finding the wires within
+// coupling distance of the changed ones. The bins are allocated with the
+// first rectangle.
+
+class RectBins
+{
+ public:
+  RectBins(const Rect& die, const int binSize)
+      : _die(die),
+        _binSize(std::max(binSize, 1)),
+        _nx(std::min(die.dx() / _binSize + 1, kMaxBins)),
+        _ny(std::min(die.dy() / _binSize + 1, kMaxBins))
+  {
+  }
+
+  void add(const Rect& rect)
+  {
+    if (_bins.empty()) {
+      _bins.resize(_nx * _ny);
+    }
+    const uint idx = _rects.size();
+    _rects.push_back(rect);
+    forBins(rect, [&](std::vector<uint>& bin) { bin.push_back(idx); });
+  }
+
+  bool empty() const { return _rects.empty(); }
+
+  bool overlaps(const Rect& rect)
+  {
+    bool found = false;
+    if (_rects.empty()) {
+      return found;
+    }
+    forBins(rect, [&](std::vector<uint>& bin) {
+      for (uint idx : bin) {
+        if (!found && _rects[idx].intersects(rect)) {
+          found = true;
+        }
+      }
+    });
+    return found;
+  }
+
+ private:
+  static constexpr int kMaxBins = 256;
+
+  int binX(const int x) const
+  {
+    const int col = (x - _die.xMin()) / (_die.dx() / _nx + 1);
+    return std::clamp(col, 0, _nx - 1);
+  }
+
+  int binY(const int y) const
+  {
+    const int row = (y - _die.yMin()) / (_die.dy() / _ny + 1);
+    return std::clamp(row, 0, _ny - 1);
+  }
+
+  template <typename Visit>
+  void forBins(const Rect& rect, Visit visit)
+  {
+    for (int row = binY(rect.yMin()); row <= binY(rect.yMax()); row++) {
+      for (int col = binX(rect.xMin()); col <= binX(rect.xMax()); col++) {
+        visit(_bins[row * _nx + col]);
+      }
+    }
+  }
+
+  const Rect _die;
+  const int _binSize;
+  const int _nx;
+  const int _ny;
+  std::vector<std::vector<uint>> _bins;
+  std::vector<Rect> _rects;
+};
+
+Rect segmentRect(const dbWireRects& rects, const uint ii)
+{
+  return Rect(rects.xlo[ii], rects.ylo[ii], rects.xhi[ii], rects.yhi[ii]);
+}
+
+}  // namespace
+
+void extMain::trackNetChanges()
+{
+  if (!_trackNetChanges) {
+    delete _netTracker;
+    _netTracker = nullptr;
+    return;
+  }
+  if (_netTracker == nullptr) {
+    _netTracker = new extNetTracker();
+  }
+  _netTracker->attach(_block);
+}
+
+void extMain::deleteNetTracker()
+{
+  delete _netTracker;
+  _netTracker = nullptr;
+  delete _contextParasitics;
+  _contextParasitics = nullptr;
+}
+
+void extMain::findCouplingNeighbors(const uint ccDist,
+                                    std::vector<dbNet*>& nets)
+{
+  const dbWireGeometry& geom = _block->getWireGeometry(_threads);
+  const Rect die = _block->getDieArea();
+
+  // Routing layers of the geometry by routing level.
+  std::vector<int> levels;
+  int maxPitch = 0;
+  for (uint ii = 0; ii < geom.layers.size(); ii++) {
+    dbTechLayer* layer = geom.layers[ii].layer;
+    if (layer == nullptr || layer->getRoutingLevel() == 0) {
+      continue;
+    }
+    const uint level = layer->getRoutingLevel();
+    if (level >= levels.size()) {
+      levels.resize(level + 1, -1);
+    }
+    levels[level] = ii;
+    maxPitch = std::max(maxPitch, layer->getPitch());
+  }
+
+  // The changed wires of each level and the ones above and below it,
+  // grown by the coupling distance of the level.
+  std::vector<RectBins> bins;
+  for (uint level = 0; level < levels.size(); level++) {
+    bins.emplace_back(die, 4 * ccDist * maxPitch);
+  }
+  for (uint level = 1; level < levels.size(); level++) {
+    if (levels[level] < 0) {
+      continue;
+    }
+    const dbWireRects& segs = geom.layers[levels[level]].segments;
+    for (uint ii = 0; ii < segs.size(); ii++) {
+      if (!dbNet::getNet(_block, segs.net_ids[ii])->isMarked()) {
+        continue;
+      }
+      const Rect rect = segmentRect(segs, ii);
+      for (uint lvl = level - 1; lvl <= level + 1; lvl++) {
+        if (lvl == 0 || lvl >= levels.size() || levels[lvl] < 0) {
+          continue;
+        }
+        const int dist = ccDist * geom.layers[levels[lvl]].layer->getPitch();
+        Rect halo = rect;
+        halo.bloat(dist, halo);
+        bins[lvl].add(halo);
+      }
+    }
+  }
+
+  std::vector<dbNet*> neighbors;
+  for (uint level = 1; level < levels.size(); level++) {
+    if (levels[level] < 0 || bins[level].empty()) {
+      continue;
+    }
+    const dbWireRects& segs = geom.layers[levels[level]].segments;
+    for (uint ii = 0; ii < segs.size(); ii++) {
+      dbNet* net = dbNet::getNet(_block, segs.net_ids[ii]);
+      if (net->isMarked() || net->getSigType().isSupply()) {
+        continue;
+      }
+      if (bins[level].overlaps(segmentRect(segs, ii))) {
+        net->setMark(true);
+        neighbors.push_back(net);
+      }
+    }
+  }
+  nets.insert(nets.end(), neighbors.begin(), neighbors.end());
+}
+
+bool extMain::beginIncremental(const uint ccDist)
+{
+  if (_parasiticsReleased) {
+    logger_->error(RCX,
+                   542,
+                   "Cannot update the parasitics released from the db by "
+                   "compact_parasitics -release_db incrementally.");
+  }
+  if (_netTracker == nullptr || !_netTracker->isTracking(_block)) {
+    logger_->warn(RCX,
+                  530,
+                  "No changes of block {} were tracked since its last "
+                  "extraction (-track_changes), extracting all nets.",
+                  _block->getName());
+    return true;
+  }
+  std::vector<dbNet*> changed;
+  _netTracker->getNets(_block, changed);
+  if (changed.empty()) {
+    logger_->info(RCX, 531, "No nets changed since the last extraction.");
+    return false;
+  }
+
+  // Nets coupled to the changed ones before and after the change.
+  std::vector<dbNet*> haloNets;
+  _block->getCcHaloNets(changed, haloNets);
+  std::vector<dbNet*> nets = changed;
+  for (dbNet* net : nets) {
+    net->setMark(true);
+  }
+  findCouplingNeighbors(ccDist, nets);
+  for (dbNet* net : haloNets) {
+    if (!net->isMarked()) {
+      net->setMark(true);
+      nets.push_back(net);
+    }
+  }
+
+  // Windows holding the re-extracted wires and their coupling context, one
+  // per cluster of wires whose grown boxes overlap.
+  const dbWireGeometry& geom = _block->getWireGeometry(_threads);
+  const Rect die = _block->getDieArea();
+  int maxPitch = 0;
+  for (const odb::dbWireLayerGeometry& layer : geom.layers) {
+    if (layer.layer != nullptr && layer.layer->getRoutingLevel() > 0) {
+      maxPitch = std::max(maxPitch, layer.layer->getPitch());
+    }
+  }
+  const int margin = ccDist * maxPitch;
+  std::vector<Rect> windows;
+  for (const odb::dbWireLayerGeometry& layer : geom.layers) {
+    if (layer.layer == nullptr || layer.layer->getRoutingLevel() == 0) {
+      continue;
+    }
+    for (uint ii = 0; ii < layer.segments.size(); ii++) {
+      if (!dbNet::getNet(_block, layer.segments.net_ids[ii])->isMarked()) {
+        continue;
+      }
+      Rect window = segmentRect(layer.segments, ii);
+      window.bloat(margin, window);
+      // Absorb the windows it overlaps until it overlaps none.
+      for (uint jj = 0; jj < windows.size();) {
+        if (windows[jj].intersects(window)) {
+          window.merge(windows[jj]);
+          windows[jj] = windows.back();
+          windows.pop_back();
+          jj = 0;
+        } else {
+          jj++;
+        }
+      }
+      windows.push_back(window);
+    }
+  }
+  RectBins windowBins(die, 4 * margin);
+  for (Rect& window : windows) {
+    window = window.intersect(die);
+    windowBins.add(window);
+  }
+  if (windows.empty()) {
+    windows.push_back(die);
+    windowBins.add(die);
+  }
+
+  // Nets measured in the windows that keep their parasitics.
+  std::vector<dbNet*> context;
+  for (const odb::dbWireLayerGeometry& layer : geom.layers) {
+    for (uint ii = 0; ii < layer.segments.size(); ii++) {
+      dbNet* net = dbNet::getNet(_block, layer.segments.net_ids[ii]);
+      if (!net->isMarked() && !net->getSigType().isSupply()
+          && windowBins.overlaps(segmentRect(layer.segments, ii))) {
+        net->setMark(true);
+        context.push_back(net);
+      }
+    }
+  }
+  for (dbNet* net : context) {
+    net->setMark(false);
+  }
+  for (dbNet* net : nets) {
+    net->setMark(false);
+  }
+
+  if (_contextParasitics == nullptr) {
+    _contextParasitics = new extContextParasitics();
+  }
+  _contextParasitics->save(context, _block->getCornerCount());
+  _block->destroyParasitics(nets);
+
+  logger_->info(RCX,
+                532,
+                "Re-extracting {} changed and {} neighboring nets in {} "
+                "windows, {} context nets.",
+                changed.size(),
+                nets.size() - changed.size(),
+                windows.size(),
+                context.size());
+
+  _incremental = true;
+  _incrNets = std::move(nets);
+  _incrWindows = std::move(windows);
+  return true;
+}
+
+void extMain::endIncremental()
+{
+  if (!_incremental) {
+    return;
+  }
+  _contextParasitics->restore(_block);
+  _contextParasitics->clear();
+  for (dbNet* net : _incrNets) {
+    net->setMark(false);
+  }
+  _incremental = false;
+  _incrNets.clear();
+  _incrWindows.clear();
+}
+
+bool extMain::findNetsToExtract(const char* netNames,
+                                std::vector<dbNet*>& nets)
+{
+  if (!_incremental) {
+    return findSomeNet(_block, netNames, nets, logger_);
+  }
+  nets = _incrNets;
+  return true;
+}
+
+std::vector<Rect> extMain::getExtractionWindows()
+{
+  if (_incremental) {
+    return _incrWindows;
+  }
+  return {_block->getDieArea()};
+}
+
+}  // namespace rcx
@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "odb/dbBlockCallBackObj.h"
+#include "odb/odb.h"
+
+namespace odb {
+class dbBlock;
+class dbCCSeg;
+class dbNet;
+}  // namespace odb
+
+namespace rcx {
+
+using odb::uint;
+
+// Collects the signal nets whose wires or terminals changed since the
+// last extraction of the block it is attached to.
+class extNetTracker : public odb::dbBlockCallBackObj
+{
+ public:
+  void inDbNetDestroy(odb::dbNet* net) override;
+  void inDbITermPostConnect(odb::dbITerm* iterm) override;
+  void inDbITermPostDisconnect(odb::dbITerm* iterm, odb::dbNet* net) override;
+  void inDbBTermPostConnect(odb::dbBTerm* bterm) override;
+  void inDbBTermPostDisConnect(odb::dbBTerm* bterm, odb::dbNet* net) override;
+  void inDbWireCreate(odb::dbWire* wire) override;
+  void inDbWireDestroy(odb::dbWire* wire) override;
+  void inDbWirePostModify(odb::dbWire* wire) override;
+  void inDbWirePostAttach(odb::dbWire* wire) override;
+  void inDbWirePreDetach(odb::dbWire* wire) override;
+
+  // Starts over collecting the changes of block.
+  void attach(odb::dbBlock* block);
+  bool isTracking(odb::dbBlock* block) const
+  {
+    return hasOwner() && _block == block;
+  }
+  // Changed nets that still exist, in id order.
+  void getNets(odb::dbBlock* block, std::vector<odb::dbNet*>& nets) const;
+
+ private:
+  void addNet(odb::dbNet* net);
+
+  odb::dbBlock* _block = nullptr;
+  std::set<uint> _netIds;
+};
+
+// Rseg caps and coupling caps of the nets around an incremental
+// extraction window that are not re-extracted. The coupling flow also
+// adds to them while measuring the re-extracted nets, so they are put
+// back afterwards.
+class extContextParasitics
+{
+ public:
+  void save(const std::vector<odb::dbNet*>& nets, uint cornerCnt);
+  void restore(odb::dbBlock* block);
+  void clear();
+  uint getNetCount() const { return _netIds.size(); }
+
+ private:
+  static uint64_t ccKey(odb::dbCCSeg* cc);
+
+  uint _cornerCnt = 0;
+  std::vector<uint> _netIds;
+  std::unordered_set<uint> _netSet;
+  // Caps of every corner, per rseg.
+  std::vector<uint> _rsegIds;
+  std::vector<double> _rsegCaps;
+  // Coupling caps between two context nets keyed by their capnodes, as
+  // the ids of the destroyed ccsegs of the re-extracted nets get reused.
+  std::unordered_map<uint64_t, uint> _ccRows;
+  std::vector<double> _ccCaps;
+};
+
+}  // namespace rcx
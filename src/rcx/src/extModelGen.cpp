@@ -3,6 +3,8 @@
 
 #include "rcx/extModelGen.h"
 
+#include <algorithm>
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -37,8 +39,11 @@ uint extMain::GenExtModel(std::list<std::string> spef_file_list,
                           const char* out_file,
                           const char* comment,
                           const char* version,
-                          int pattern)
+                          int pattern,
+                          int threads)
 {
+  const auto start = std::chrono::steady_clock::now();
+
   std::vector<std::string> corner_name;
 
   std::list<std::string>::iterator it1;
@@ -53,6 +58,9 @@ uint extMain::GenExtModel(std::list<std::string> spef_file_list,
   bool binary = false;
   uint fileCnt = spef_file_list.size();
   uint cnt = 0;
+  // The solver results of each corner go through the same block, so the
+  // pattern totals are read out of it before the next SPEF file.
+  std::vector<std::vector<extPatternRC>> patterns(fileCnt);
   std::list<std::string>::iterator it;
   for (it = spef_file_list.begin(); it != spef_file_list.end(); ++it) {
     std::string str = *it;
@@ -90,22 +98,49 @@ uint extMain::GenExtModel(std::list<std::string> spef_file_list,
              false /*calibrate*/,
              0);
 
-    extModelGen* extRulesModel = new extModelGen(layerCnt, "TYPICAL", logger_);
-    extRulesModel->setExtMain(this);
+    extModelGen::ReadPatternRCs(this, _block, threads, patterns[cnt]);
+    cnt++;
+  }
+
+  // The models of the corners only read their own pattern totals. From
+  // the shared extMain, BuildRCDB only reads the block's dbu per micron
+  // (GetDBcoords2), and the logger sinks are thread safe. The log files
+  // carry the corner index since corner names need not be unique.
+  std::vector<extModelGen*> models(fileCnt);
+#pragma omp parallel for num_threads(threads) schedule(dynamic)
+  for (uint ii = 0; ii < fileCnt; ii++) {
+    models[ii] = new extModelGen(layerCnt, "TYPICAL", logger_);
+    models[ii]->setExtMain(this);
 
     uint diagOption = 1;
-    char* out = (char*) corner_name[cnt].c_str();
-    // if (cnt == 1)
-    //    out = "2.model";
-    extRulesModel->ReadRCDB(_block, widthCnt, diagOption, out);
+    const std::string logFilePrefix
+        = corner_name[ii] + "." + std::to_string(ii);
+    models[ii]->BuildRCDB(
+        patterns[ii], widthCnt, diagOption, logFilePrefix.c_str());
+  }
+
+  for (uint ii = 0; ii < fileCnt; ii++) {
+    extModelGen* extRulesModel = models[ii];
     if (outFP == nullptr)
       outFP = extRulesModel->InitWriteRules(
           out_file, corner_list, comment, binary, fileCnt);
 
-    extRulesModel->writeRules(outFP, binary, cnt);  // always first model
-    cnt++;
+    extRulesModel->writeRules(outFP, binary, ii);  // always first model
+    delete extRulesModel;
   }
   fclose(outFP);
+
+  const std::chrono::duration<double> elapsed
+      = std::chrono::steady_clock::now() - start;
+  const size_t patternCnt = fileCnt > 0 ? patterns[0].size() : 0;
+  logger_->info(RCX,
+                540,
+                "Generated the models of {} patterns for {} corners in "
+                "{:.2f} seconds, {:.0f} patterns per second.",
+                patternCnt,
+                fileCnt,
+                elapsed.count(),
+                patternCnt * fileCnt / std::max(elapsed.count(), 1e-9));
   return 0;
 }
 void extModelGen::writeRules(FILE* fp, bool binary, uint mIndex, int corner)
@@ -470,10 +505,56 @@ FILE* extModelGen::InitWriteRules(const char* name,
 
   return fp;
 }
+void extModelGen::ReadPatternRCs(extMain* extMain,
+                                 dbBlock* block,
+                                 const int threads,
+                                 std::vector<extPatternRC>& patterns)
+{
+  std::vector<dbNet*> nets;
+  for (dbNet* net : block->getNets()) {
+    nets.push_back(net);
+  }
+  patterns.resize(nets.size());
+
+  // The nets are only read here
+#pragma omp parallel for num_threads(threads) schedule(dynamic, 64)
+  for (size_t ii = 0; ii < nets.size(); ii++) {
+    dbNet* net = nets[ii];
+    extPatternRC& pattern = patterns[ii];
+
+    uint wireCnt = 0;
+    uint viaCnt = 0;
+    uint layerCnt = 0;
+    uint layerTable[20];
+    pattern.net = net;
+    pattern.len = 0;
+    net->getNetStats(wireCnt, viaCnt, pattern.len, layerCnt, layerTable);
+    pattern.totCC = net->getTotalCouplingCap();
+    pattern.totGnd = net->getTotalCapacitance();
+    pattern.res = net->getTotalResistance();
+  }
+
+  // Kept out of the parallel loop, which only calls dbNet accessors
+  for (size_t ii = 0; ii < nets.size(); ii++) {
+    patterns[ii].contextCoupling
+        = extMain->getTotalCouplingCap(nets[ii], "cntxM", 0);
+  }
+}
+
 uint extModelGen::ReadRCDB(dbBlock* block,
                            uint widthCnt,
                            uint diagOption,
                            char* logFilePrefix)
+{
+  std::vector<extPatternRC> patterns;
+  ReadPatternRCs(get_extMain(), block, 1, patterns);
+  return BuildRCDB(patterns, widthCnt, diagOption, logFilePrefix);
+}
+
+uint extModelGen::BuildRCDB(const std::vector<extPatternRC>& patterns,
+                            uint widthCnt,
+                            uint diagOption,
+                            const char* logFilePrefix)
 {
   extMain* extMain = get_extMain();
   // ORIG: setDiagModel(1);
@@ -500,25 +581,17 @@ uint extModelGen::ReadRCDB(dbBlock* block,
 
   int prev_sep = 0;
   int prev_width = 0;
-  odb::dbSet<dbNet> nets = block->getNets();
-  odb::dbSet<dbNet>::iterator itr;
-  for (itr = nets.begin(); itr != nets.end(); ++itr) {
-    dbNet* net = *itr;
+  for (const extPatternRC& pattern : patterns) {
+    dbNet* net = pattern.net;
     const char* netName = net->getConstName();
 
-    uint wireCnt = 0;
-    uint viaCnt = 0;
-    uint len = 0;
-    uint layerCnt = 0;
-    uint layerTable[20];
-
-    net->getNetStats(wireCnt, viaCnt, len, layerCnt, layerTable);
+    const uint len = pattern.len;
     uint wcnt = p->mkWords(netName, "_");
 
     // Read Via patterns - dkf 12262023
     // via pattern: V2.W2.M5.M6.DX520.DY1320.C2.V56_1x2_VH_S
     if (p->getFirstChar() == 'V') {
-      if (!rcModel->GetViaRes(p, w, net, logFP))
+      if (!rcModel->GetViaRes(p, w, netName, pattern.res, logFP))
         break;
       continue;
     }
@@ -629,11 +702,11 @@ uint extModelGen::ReadRCDB(dbBlock* block,
     m._s2_nm = ceil(m._s2_m * 1000);
 
     double wLen = extMain->GetDBcoords2(len) * 1.0;
-    double totCC = net->getTotalCouplingCap();
-    double totGnd = net->getTotalCapacitance();
-    double res = net->getTotalResistance();
+    double totCC = pattern.totCC;
+    double totGnd = pattern.totGnd;
+    double res = pattern.res;
 
-    double contextCoupling = extMain->getTotalCouplingCap(net, "cntxM", 0);
+    double contextCoupling = pattern.contextCoupling;
     if (contextCoupling > 0) {
       totGnd += contextCoupling;
       totCC -= contextCoupling;
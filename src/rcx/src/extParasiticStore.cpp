@@ -0,0 +1,333 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#include "rcx/extParasiticStore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "odb/db.h"
+#include "rcx/extSpef.h"
+#include "utl/Logger.h"
+
+namespace rcx {
+
+using odb::dbBlock;
+using odb::dbCapNode;
+using odb::dbCCSeg;
+using odb::dbNet;
+using odb::dbRSeg;
+using odb::dbStringProperty;
+using utl::RCX;
+
+// Largest half precision value and smallest normal one.
+static constexpr float kHalfMax = 65504.0f;
+static constexpr float kHalfMinNormal = 6.103515625e-05f;
+
+static uint16_t floatToHalf(const float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint16_t sign = (bits >> 16) & 0x8000;
+  const uint32_t abs_bits = bits & 0x7fffffff;
+  if (abs_bits < 0x38800000) {  // below kHalfMinNormal
+    return sign;
+  }
+  // Rebias the exponent from 127 to 15 and round the mantissa to nearest
+  // even; a carry out of the mantissa correctly bumps the exponent.
+  const uint32_t rebiased = abs_bits - (112u << 23);
+  return sign | ((rebiased + 0xfff + ((abs_bits >> 13) & 1)) >> 13);
+}
+
+static float halfToFloat(const uint16_t half)
+{
+  const uint32_t sign = (uint32_t) (half & 0x8000) << 16;
+  const uint32_t exp = (half >> 10) & 0x1f;
+  const uint32_t mant = half & 0x3ff;
+  uint32_t bits = sign;
+  if (exp != 0) {
+    bits |= ((exp + 112) << 23) | (mant << 13);
+  }
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+void extPackedValues::init(const uint cornerCnt)
+{
+  _cornerCnt = cornerCnt;
+  _isHalf = false;
+  _float.clear();
+  _half.clear();
+}
+
+void extPackedValues::add(const double* values)
+{
+  for (uint ii = 0; ii < _cornerCnt; ii++) {
+    _float.push_back(values[ii]);
+  }
+}
+
+void extPackedValues::pack(const bool half)
+{
+  if (half) {
+    _isHalf = std::all_of(_float.begin(), _float.end(), [](float v) {
+      const float a = std::fabs(v);
+      return a == 0.0f || (a >= kHalfMinNormal && a <= kHalfMax);
+    });
+  }
+  if (_isHalf) {
+    _half.resize(_float.size());
+    std::transform(_float.begin(), _float.end(), _half.begin(), floatToHalf);
+    std::vector<float>().swap(_float);
+  } else {
+    _float.shrink_to_fit();
+  }
+}
+
+void extPackedValues::get(const uint row, double* values) const
+{
+  for (uint ii = 0; ii < _cornerCnt; ii++) {
+    values[ii] = get(row, ii);
+  }
+}
+
+double extPackedValues::get(const uint row, const uint corner) const
+{
+  const size_t idx = (size_t) row * _cornerCnt + corner;
+  return _isHalf ? halfToFloat(_half[idx]) : _float[idx];
+}
+
+size_t extPackedValues::getMemory() const
+{
+  return _float.capacity() * sizeof(float)
+         + _half.capacity() * sizeof(uint16_t);
+}
+
+void extParasiticStore::clear()
+{
+  *this = extParasiticStore();
+}
+
+int extParasiticStore::getNetIndex(const uint netId) const
+{
+  return netId < _netIndex.size() ? _netIndex[netId] : -1;
+}
+
+const std::string& extParasiticStore::getNodeName(const uint node) const
+{
+  return _names[_nodeObject[node]];
+}
+
+uint extParasiticStore::getNodeNet(const uint node) const
+{
+  auto it = std::upper_bound(_nodeBegin.begin(), _nodeBegin.end(), node);
+  return it - _nodeBegin.begin() - 1;
+}
+
+void extParasiticStore::build(dbBlock* block,
+                              const uint cornerCnt,
+                              const bool preserveCapValues,
+                              const bool half,
+                              Logger* logger)
+{
+  clear();
+  _cornerCnt = cornerCnt;
+  _preserveCapValues = preserveCapValues;
+  _netCap.init(cornerCnt);
+  _nodeCap.init(cornerCnt);
+  _res.init(cornerCnt);
+  _ccCap.init(cornerCnt);
+
+  // dbCapNode id to global node row.
+  std::unordered_map<uint, uint> nodeRows;
+  std::vector<double> nodeCaps;
+  double cap[ADS_MAX_CORNER];
+  double res[ADS_MAX_CORNER];
+
+  _nodeBegin.push_back(0);
+  _resBegin.push_back(0);
+  for (dbNet* net : block->getNets()) {
+    odb::dbSet<dbCapNode> capNodes = net->getCapNodes();
+    if (capNodes.empty()) {
+      continue;
+    }
+    const uint netId = net->getId();
+    if (netId >= _netIndex.size()) {
+      _netIndex.resize(netId + 1, -1);
+    }
+    _netIndex[netId] = _netIds.size();
+    _netIds.push_back(netId);
+
+    const uint firstNode = _nodeType.size();
+    nodeCaps.clear();
+    for (dbCapNode* node : capNodes) {
+      nodeRows[node->getId()] = _nodeType.size();
+      if (node->isITerm()) {
+        _nodeType.push_back(ITERM);
+        _nodeObject.push_back(node->getNode());
+      } else if (node->isBTerm()) {
+        _nodeType.push_back(BTERM);
+        _nodeObject.push_back(node->getNode());
+      } else if (node->isName()) {
+        dbStringProperty* p = dbStringProperty::find(node, "_inode");
+        _nodeType.push_back(NAME);
+        _nodeObject.push_back(_names.size());
+        _names.push_back(p ? p->getValue() : "");
+      } else {
+        _nodeType.push_back(INTERNAL);
+        _nodeObject.push_back(node->getNode());
+      }
+      for (uint ii = 0; ii < cornerCnt; ii++) {
+        nodeCaps.push_back(preserveCapValues ? node->getCapacitance(ii)
+                                             : 0.0);
+      }
+    }
+
+    for (dbRSeg* rc : net->getRSegs()) {
+      auto src = nodeRows.find(rc->getSourceNode());
+      auto tgt = nodeRows.find(rc->getTargetNode());
+      if (src == nodeRows.end() || tgt == nodeRows.end()) {
+        continue;
+      }
+      if (!preserveCapValues) {
+        rc->getCapTable(cap);
+        const uint srcCap = (src->second - firstNode) * cornerCnt;
+        const uint tgtCap = (tgt->second - firstNode) * cornerCnt;
+        for (uint ii = 0; ii < cornerCnt; ii++) {
+          nodeCaps[srcCap + ii] += cap[ii] / 2;
+          nodeCaps[tgtCap + ii] += cap[ii] / 2;
+        }
+      }
+      for (uint ii = 0; ii < cornerCnt; ii++) {
+        res[ii] = rc->getResistance(ii);
+      }
+      _resSource.push_back(src->second);
+      _resTarget.push_back(tgt->second);
+      _res.add(res);
+    }
+
+    for (uint ii = 0; ii < cornerCnt; ii++) {
+      cap[ii] = net->getTotalCouplingCap(ii);
+    }
+    for (uint node = 0; node < _nodeType.size() - firstNode; node++) {
+      _nodeCap.add(&nodeCaps[node * cornerCnt]);
+      for (uint ii = 0; ii < cornerCnt; ii++) {
+        cap[ii] += nodeCaps[node * cornerCnt + ii];
+      }
+    }
+    _netCap.add(cap);
+
+    _nodeBegin.push_back(_nodeType.size());
+    _resBegin.push_back(_resSource.size());
+  }
+
+  // Coupling caps are visited once from each of their two nets.
+  std::unordered_map<uint, uint> ccRows;
+  std::vector<dbCCSeg*> segs;
+  _ccRefBegin.push_back(0);
+  for (uint netId : _netIds) {
+    dbNet* net = dbNet::getNet(block, netId);
+    for (const bool source : {true, false}) {
+      segs.clear();
+      if (source) {
+        net->getSrcCCSegs(segs);
+      } else {
+        net->getTgtCCSegs(segs);
+      }
+      if (!preserveCapValues) {
+        extSpef::sortCCSegs(segs);
+      }
+      for (dbCCSeg* cc : segs) {
+        auto row = ccRows.find(cc->getId());
+        if (row == ccRows.end()) {
+          auto src = nodeRows.find(cc->getSourceCapNode()->getId());
+          auto tgt = nodeRows.find(cc->getTargetCapNode()->getId());
+          if (src == nodeRows.end() || tgt == nodeRows.end()) {
+            continue;
+          }
+          for (uint ii = 0; ii < cornerCnt; ii++) {
+            cap[ii] = cc->getCapacitance(ii);
+          }
+          row = ccRows.emplace(cc->getId(), _ccSource.size()).first;
+          _ccSource.push_back(src->second);
+          _ccTarget.push_back(tgt->second);
+          _ccCap.add(cap);
+        }
+        _ccRef.push_back(row->second);
+      }
+    }
+    _ccRefBegin.push_back(_ccRef.size());
+  }
+
+  _netCap.pack(half);
+  _nodeCap.pack(half);
+  _res.pack(half);
+  _ccCap.pack(half);
+  _netIds.shrink_to_fit();
+  _nodeBegin.shrink_to_fit();
+  _nodeType.shrink_to_fit();
+  _nodeObject.shrink_to_fit();
+  _resBegin.shrink_to_fit();
+  _resSource.shrink_to_fit();
+  _resTarget.shrink_to_fit();
+  _ccRefBegin.shrink_to_fit();
+  _ccRef.shrink_to_fit();
+  _ccSource.shrink_to_fit();
+  _ccTarget.shrink_to_fit();
+
+  logger->info(RCX,
+               516,
+               "Parasitic store: {} nets, {} nodes, {} resistors, {} coupling "
+               "caps, {:.1f} MB.",
+               _netIds.size(),
+               _nodeType.size(),
+               _resSource.size(),
+               _ccSource.size(),
+               getMemory() / 1e6);
+  if (!half) {
+    return;
+  }
+  std::string kept;
+  const std::pair<const extPackedValues*, const char*> columns[]
+      = {{&_netCap, "net caps"},
+         {&_nodeCap, "node caps"},
+         {&_res, "resistors"},
+         {&_ccCap, "coupling caps"}};
+  for (const auto& [values, name] : columns) {
+    if (!values->isHalf()) {
+      kept += kept.empty() ? name : std::string(", ") + name;
+    }
+  }
+  if (!kept.empty()) {
+    logger->info(RCX,
+                 517,
+                 "Values out of half precision range, kept {} as float.",
+                 kept);
+  }
+}
+
+size_t extParasiticStore::getMemory() const
+{
+  size_t bytes = _netCap.getMemory() + _nodeCap.getMemory() + _res.getMemory()
+                 + _ccCap.getMemory();
+  bytes += (_netIds.capacity() + _nodeBegin.capacity()
+            + _nodeObject.capacity() + _resBegin.capacity()
+            + _resSource.capacity() + _resTarget.capacity()
+            + _ccRefBegin.capacity() + _ccRef.capacity()
+            + _ccSource.capacity() + _ccTarget.capacity())
+           * sizeof(uint);
+  bytes += _netIndex.capacity() * sizeof(int) + _nodeType.capacity();
+  for (const std::string& name : _names) {
+    bytes += sizeof(std::string) + name.capacity();
+  }
+  return bytes;
+}
+
+}  // namespace rcx
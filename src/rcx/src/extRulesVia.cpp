@@ -92,10 +92,18 @@ bool extMetRCTable::GetViaRes(Ath__parser* p,
                               Ath__parser* w,
                               dbNet* net,
                               FILE* logFP)
+{
+  return GetViaRes(
+      p, w, net->getConstName(), net->getTotalResistance(), logFP);
+}
+bool extMetRCTable::GetViaRes(Ath__parser* p,
+                              Ath__parser* w,
+                              const char* netName,
+                              const double via_res,
+                              FILE* logFP)
 {
   // via pattern: V2.W2.M5.M6.DX520.DY1320.C2.V56_1x2_VH_S
 
-  const char* netName = net->getConstName();
   int vCnt = w->mkWords(netName, ".-");
   // if (vCnt<=1)
   //  vCnt = w->mkWords(netName, "-");
@@ -108,7 +116,6 @@ bool extMetRCTable::GetViaRes(Ath__parser* p,
   int cutCnt = w->getInt(5, 1);
 
   const char* viaName = w->get(vCnt - 2);
-  double via_res = net->getTotalResistance();
 
   if (viaWireNum == 1) {
     fprintf(logFP, "WV %g  %s %s\n", via_res, viaName, netName);
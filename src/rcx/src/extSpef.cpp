@@ -3,13 +3,23 @@
 
 #include "rcx/extSpef.h"
 
+#include <omp.h>
+
 #include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "name.h"
 #include "odb/dbExtControl.h"
 #include "parse.h"
+#include "rcx/extParasiticStore.h"
 #include "rcx/extRCap.h"
 #include "utl/Logger.h"
 
@@ -891,6 +901,12 @@ class compareCC
     }
   }
 };
+
+void extSpef::sortCCSegs(std::vector<dbCCSeg*>& segs)
+{
+  std::sort(segs.begin(), segs.end(), compareCC());
+}
+
 void extSpef::writeCouplingCapsNoSort(dbSet<dbCCSeg>& capSet, const uint netId)
 {
   for (dbCCSeg* cc : capSet) {
@@ -918,7 +934,7 @@ void extSpef::writeCouplingCaps(dbSet<dbCCSeg>& capSet, const uint netId)
   }
 
   std::vector<dbCCSeg*> vec_cc(capSet.begin(), capSet.end());
-  std::sort(vec_cc.begin(), vec_cc.end(), compareCC());
+  sortCCSegs(vec_cc);
   for (dbCCSeg* cc : vec_cc) {
     writeCNodeNumber();
 
@@ -943,7 +959,7 @@ void extSpef::writeTgtCouplingCaps(dbNet* net, const uint netId)
   net->getTgtCCSegs(vec_cc);
 
   if (!_preserveCapValues) {
-    std::sort(vec_cc.begin(), vec_cc.end(), compareCC());
+    sortCCSegs(vec_cc);
   }
 
   writeCouplingCaps(vec_cc, netId);
@@ -955,7 +971,7 @@ void extSpef::writeSrcCouplingCaps(dbNet* net, const uint netId)
   net->getSrcCCSegs(vec_cc);
 
   if (!_preserveCapValues) {
-    std::sort(vec_cc.begin(), vec_cc.end(), compareCC());
+    sortCCSegs(vec_cc);
   }
 
   writeCouplingCaps(vec_cc, netId);
@@ -1087,6 +1103,14 @@ void extSpef::writeNet(dbNet* net, const double resBound, const uint debug)
   _d_net = net;
   const uint netId = net->getId();
 
+  if (_store) {
+    const int index = _store->getNetIndex(netId);
+    if (index >= 0) {
+      writeStoredNet(net, index);
+      return;
+    }
+  }
+
   if (_cornerBlock && _cornerBlock != _block) {
     net = dbNet::getNet(_cornerBlock, netId);
   }
@@ -1177,6 +1201,157 @@ void extSpef::writeNet(dbNet* net, const double resBound, const uint debug)
   }
 }
 
+void extSpef::writeStoredNode(const uint node)
+{
+  const uint object = _store->getNodeObject(node);
+  switch (_store->getNodeType(node)) {
+    case extParasiticStore::ITERM:
+      writeITermNode(object);
+      break;
+    case extParasiticStore::BTERM:
+      writeBTerm(object);
+      break;
+    case extParasiticStore::INTERNAL: {
+      uint netId = _store->getNetId(_store->getNodeNet(node));
+      if (_childBlockNetBaseMap > 0) {
+        netId += _childBlockNetBaseMap;
+      }
+      writeNode(netId, object);
+      break;
+    }
+    case extParasiticStore::NAME:
+      fprintf(_outFP, "%s ", _store->getNodeName(node).c_str());
+      break;
+  }
+}
+
+bool extSpef::isStoredNodeExcluded(const uint node)
+{
+  if (_store->getNodeType(node) != extParasiticStore::ITERM) {
+    return false;
+  }
+  dbITerm* iterm = dbITerm::getITerm(_block, _store->getNodeObject(node));
+  return iterm->getInst()->getMaster()->isMarked();
+}
+
+// Same output as writeNet, read from the parasitic store.
+void extSpef::writeStoredNet(dbNet* net, const uint index)
+{
+  const uint netId = net->getId();
+  const uint nodeBegin = _store->nodeBegin(index);
+  const uint nodeEnd = _store->nodeEnd(index);
+  double values[ADS_MAX_CORNER];
+  _cCnt = 1;
+
+  _store->getNetCaps(index, values);
+  writeDnet(netId, values);
+
+  if (_wConn) {
+    writeKeyword("*CONN");
+    for (uint node = nodeBegin; node < nodeEnd; node++) {
+      if (_store->getNodeType(node) == extParasiticStore::BTERM) {
+        writePort(_store->getNodeObject(node));
+      }
+    }
+    for (uint node = nodeBegin; node < nodeEnd; node++) {
+      if (_store->getNodeType(node) == extParasiticStore::ITERM) {
+        writeITerm(_store->getNodeObject(node));
+      } else if (_store->getNodeType(node) == extParasiticStore::NAME) {
+        fprintf(_outFP, "*I %s \n", _store->getNodeName(node).c_str());
+      }
+    }
+  }
+
+  if (_wCap || _wOnlyCCcap) {
+    writeKeyword("*CAP");
+  }
+  if (_wCap && !_wOnlyCCcap) {
+    auto writeNodeCaps = [&](auto isWritten) {
+      for (uint node = nodeBegin; node < nodeEnd; node++) {
+        if (!isWritten(_store->getNodeType(node))
+            || isStoredNodeExcluded(node)) {
+          continue;
+        }
+        writeCNodeNumber();
+        writeStoredNode(node);
+        _store->getNodeCaps(node, values);
+        writeRCvalue(values, _cap_unit);
+        fprintf(_outFP, "\n");
+      }
+    };
+    // SPEF read in keeps its name nodes out of the *CAP section.
+    writeNodeCaps([](auto type) { return type == extParasiticStore::BTERM; });
+    writeNodeCaps([this](auto type) {
+      return type == extParasiticStore::ITERM
+             || (type == extParasiticStore::NAME
+                 && !_store->preserveCapValues());
+    });
+    writeNodeCaps(
+        [](auto type) { return type == extParasiticStore::INTERNAL; });
+  }
+  if (_wCap || _wOnlyCCcap) {
+    for (uint ref = _store->ccBegin(index); ref < _store->ccEnd(index);
+         ref++) {
+      const uint cc = _store->getCC(ref);
+      const uint source = _store->getCCSource(cc);
+      const uint target = _store->getCCTarget(cc);
+      writeCNodeNumber();
+      if (_store->getNodeNet(source) == _store->getNodeNet(target)) {
+        continue;
+      }
+      writeStoredNode(source);
+      writeStoredNode(target);
+      _store->getCCCaps(cc, values);
+      writeRCvalue(values, _cap_unit);
+      fprintf(_outFP, "\n");
+    }
+  }
+
+  if (_wRes) {
+    uint cnt = 1;
+    for (uint res = _store->resBegin(index); res < _store->resEnd(index);
+         res++) {
+      if (cnt == 1) {
+        writeKeyword("*RES");
+      }
+      const uint source = _store->getResSource(res);
+      const uint target = _store->getResTarget(res);
+      if (isStoredNodeExcluded(source) || isStoredNodeExcluded(target)) {
+        continue;
+      }
+      fprintf(_outFP, "%d ", cnt++);
+      writeStoredNode(source);
+      writeStoredNode(target);
+      _store->getRes(res, values);
+      writeRCvalue(values, _res_unit);
+      fprintf(_outFP, " \n");
+    }
+  }
+  writeKeyword("*END");
+}
+
+void extSpef::markStoredNet(const uint index)
+{
+  for (uint ref = _store->ccBegin(index); ref < _store->ccEnd(index); ref++) {
+    const uint cc = _store->getCC(ref);
+    for (const uint node : {_store->getCCSource(cc), _store->getCCTarget(cc)}) {
+      const uint object = _store->getNodeObject(node);
+      switch (_store->getNodeType(node)) {
+        case extParasiticStore::ITERM:
+          dbITerm::getITerm(_block, object)->getInst()->setUserFlag1();
+          break;
+        case extParasiticStore::BTERM:
+          dbBTerm::getBTerm(_block, object)->setMark(1);
+          break;
+        default:
+          dbNet::getNet(_block, _store->getNetId(_store->getNodeNet(node)))
+              ->setMark_1(true);
+          break;
+      }
+    }
+  }
+}
+
 bool extSpef::setInSpef(const char* filename, const bool onlyOpen)
 {
   if (filename == nullptr) {
@@ -1336,6 +1511,11 @@ void extSpef::writeNetMap(dbSet<dbNet>& nets)
       _btermFound = true;
       bterm->setMark(1);
     }
+    const int index = _store ? _store->getNetIndex(net->getId()) : -1;
+    if (index >= 0) {
+      markStoredNet(index);
+      continue;
+    }
     for (dbCapNode* capn : net->getCapNodes()) {
       for (dbCCSeg* cc : capn->getCCSegs()) {
         dbCapNode* tcap = cc->getSourceCapNode();
@@ -1466,6 +1646,12 @@ void extSpef::writeBlock(const char* nodeCoord,
   _writingNodeCoords = C_NONE;
   if (nodeCoord && nodeCoord[0] != '\0') {
     _writingNodeCoords = C_ON;
+    if (_store) {
+      logger_->warn(RCX,
+                    518,
+                    "Nets in the parasitic store are written without node "
+                    "coordinates.");
+    }
   }
   if (!wConn && !wCap && !wOnlyCCcap && !wRes) {
     _wConn = _wCap = _wRes = true;
@@ -1525,8 +1711,7 @@ void extSpef::writeBlock(const char* nodeCoord,
   _cornersPerBlock = _cornerCnt;
   _cornerBlock = _block;
 
-  uint cnt = 0;
-
+  std::vector<dbNet*> nets;
   for (dbNet* net : _block->getNets()) {
     if (!tnets.empty() && !net->isMarked()) {
       if (!_incrPlusCcNets || net->getCcCount() == 0) {
@@ -1540,22 +1725,137 @@ void extSpef::writeBlock(const char* nodeCoord,
     if (_wOnlyClock && type != dbSigType::CLOCK) {
       continue;
     }
-    writeNet(net, 0.0, 0);
-    ++cnt;
-
-    constexpr uint repChunk = 100000;
-    if (cnt % repChunk == 0) {
-      logger_->info(RCX, 42, "{} nets finished", cnt);
-    }
+    nets.push_back(net);
   }
+  writeNets(nets);
+
   for (dbNet* net : tnets) {
     net->setMark(false);
   }
-  logger_->info(RCX, 443, "{} nets finished", cnt);
+  logger_->info(RCX, 443, "{} nets finished", nets.size());
 
   closeOutFile();
 }
 
+void extSpef::writeNets(const std::vector<dbNet*>& nets)
+{
+  constexpr uint repChunk = 100000;
+  if (_threads <= 1) {
+    for (uint ii = 0; ii < nets.size(); ii++) {
+      writeNet(nets[ii], 0.0, 0);
+      if ((ii + 1) % repChunk == 0) {
+        logger_->info(RCX, 42, "{} nets finished", ii + 1);
+      }
+    }
+    return;
+  }
+
+  // Every thread formats whole nets in memory with a writer of its own;
+  // the only db state written is the sort index of the net's cap nodes.
+  std::vector<std::unique_ptr<extSpef>> writers;
+  for (int ii = 0; ii < _threads; ii++) {
+    writers.push_back(makeWriter());
+  }
+
+  // Nets are formatted in batches so only one batch of text is held.
+  constexpr uint batchSize = 16384;
+  std::vector<std::string> text;
+  std::vector<char> formatted;
+  for (uint begin = 0; begin < nets.size(); begin += batchSize) {
+    const int end = std::min<uint>(nets.size(), begin + batchSize);
+    text.assign(end - begin, std::string());
+    formatted.assign(end - begin, true);
+#pragma omp parallel for num_threads(_threads) schedule(dynamic, 64)
+    for (int ii = begin; ii < end; ii++) {
+      formatted[ii - begin] = writers[omp_get_thread_num()]->formatNet(
+          nets[ii], text[ii - begin]);
+    }
+    for (int ii = begin; ii < end; ii++) {
+      if (!formatted[ii - begin]) {
+        closeOutFile();
+        _outFP = nullptr;
+        logger_->error(RCX,
+                       543,
+                       "Cannot format the SPEF of net {}.",
+                       nets[ii]->getName());
+      }
+      const std::string& net_text = text[ii - begin];
+      if (fwrite(net_text.data(), 1, net_text.size(), _outFP)
+          != net_text.size()) {
+        const int errnum = errno;
+        closeOutFile();
+        _outFP = nullptr;
+        logger_->error(RCX,
+                       544,
+                       "Error writing SPEF file {}: {}",
+                       _outFile,
+                       strerror(errnum));
+      }
+    }
+    if (end / repChunk != begin / repChunk) {
+      logger_->info(RCX, 42, "{} nets finished", end / repChunk * repChunk);
+    }
+  }
+}
+
+std::unique_ptr<extSpef> extSpef::makeWriter() const
+{
+  auto writer
+      = std::make_unique<extSpef>(_tech, _block, logger_, _version, _ext);
+  strcpy(writer->_delimiter, _delimiter);
+  strcpy(writer->_divider, _divider);
+  strcpy(writer->_bus_delimiter, _bus_delimiter);
+  writer->_cornerBlock = _cornerBlock;
+  writer->_cornerCnt = _cornerCnt;
+  writer->_cornersPerBlock = _cornersPerBlock;
+  writer->_active_corner_cnt = _active_corner_cnt;
+  std::copy(std::begin(_active_corner_number),
+            std::end(_active_corner_number),
+            writer->_active_corner_number);
+  writer->_cap_unit = _cap_unit;
+  writer->_res_unit = _res_unit;
+  writer->_writeNameMap = _writeNameMap;
+  writer->_baseNameMap = _baseNameMap;
+  writer->_childBlockInstBaseMap = _childBlockInstBaseMap;
+  writer->_childBlockNetBaseMap = _childBlockNetBaseMap;
+  writer->_noBackSlash = _noBackSlash;
+  writer->_noCnum = _noCnum;
+  writer->_foreign = _foreign;
+  writer->_preserveCapValues = _preserveCapValues;
+  writer->_symmetricCCcaps = _symmetricCCcaps;
+  writer->_singleP = _singleP;
+  writer->_termJxy = _termJxy;
+  writer->_writingNodeCoords = _writingNodeCoords;
+  writer->_wOnlyClock = _wOnlyClock;
+  writer->_wConn = _wConn;
+  writer->_wCap = _wCap;
+  writer->_wOnlyCCcap = _wOnlyCCcap;
+  writer->_wRes = _wRes;
+  writer->_store = _store;
+  if (!_preserveCapValues) {
+    writer->setupMappingForWrite();
+  }
+  return writer;
+}
+
+bool extSpef::formatNet(dbNet* net, std::string& text)
+{
+  char* buffer = nullptr;
+  size_t size = 0;
+  _outFP = open_memstream(&buffer, &size);
+  if (_outFP == nullptr) {
+    return false;
+  }
+  writeNet(net, 0.0, 0);
+  const bool ok = !ferror(_outFP);
+  fclose(_outFP);
+  _outFP = nullptr;
+
+  text.assign(buffer, size);
+  free(buffer);
+  return ok;
+}
+
 void extSpef::write_spef_nets(const bool flatten, const bool parallel)
 {
   _childBlockNetBaseMap = 0;
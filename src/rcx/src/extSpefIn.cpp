@@ -2523,31 +2523,36 @@ uint extSpef::readBlock(const uint debug,
     _multipleLoop = 0;
     _breakLoopNet = 0;
     bool doSortingRSeg = false;
-    do {
-      cnt++;
-      readDNet(debug);
+    if (canReadMapped() && readDNetsMapped(cnt)) {
+      doSortingRSeg = _doSortRSeg;
+    } else {
+      do {
+        cnt++;
+        readDNet(debug);
 
-      if (cnt % 100000 == 0) {
-        logger_->info(
-            RCX,
-            445,
-            "Have read {} D_NET nets, {} resistors, {} gnd caps {} coupling "
-            "caps",
-            cnt,
-            _resCnt,
-            _gndCapCnt,
-            _ccCapCnt);
-      }
-      const bool sortingRSeg = _d_net && !_keep_loaded_corner
-                               && (_doSortRSeg || _readingNodeCoords != C_NONE);
-      doSortingRSeg |= sortingRSeg;
-      if (sortingRSeg) {
-        sortRSegs();
-        for (dbCapNode* node : _d_corner_net->getCapNodes()) {
-          node->setSortIndex(0);
+        if (cnt % 100000 == 0) {
+          logger_->info(
+              RCX,
+              445,
+              "Have read {} D_NET nets, {} resistors, {} gnd caps {} coupling "
+              "caps",
+              cnt,
+              _resCnt,
+              _gndCapCnt,
+              _ccCapCnt);
         }
-      }
-    } while (_parser->parseNextLine() > 0);
+        const bool sortingRSeg
+            = _d_net && !_keep_loaded_corner
+              && (_doSortRSeg || _readingNodeCoords != C_NONE);
+        doSortingRSeg |= sortingRSeg;
+        if (sortingRSeg) {
+          sortRSegs();
+          for (dbCapNode* node : _d_corner_net->getCapNodes()) {
+            node->setSortIndex(0);
+          }
+        }
+      } while (_parser->parseNextLine() > 0);
+    }
     if (doSortingRSeg) {
       _cornerBlock->preExttreeMergeRC(0.0, 0);
     }
@@ -0,0 +1,661 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+// Multithreaded reading of the D_NET section of a SPEF file. The file is
+// mapped into memory and split at its *D_NET lines; nets are tokenized,
+// converted and resolved against the db in parallel, then annotated in
+// file order on the calling thread.
+
+#include <fcntl.h>
+#include <omp.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "rcx/extRCap.h"
+#include "rcx/extSpef.h"
+#include "utl/Logger.h"
+
+namespace rcx {
+
+using odb::dbBlock;
+using odb::dbBTerm;
+using odb::dbCapNode;
+using odb::dbCCSeg;
+using odb::dbInst;
+using odb::dbITerm;
+using odb::dbNet;
+using odb::dbObject;
+using odb::dbRSeg;
+using utl::RCX;
+
+// A node word of a *CAP or *RES line resolved against the db.
+struct extSpefMappedNode
+{
+  enum Type : uint8_t
+  {
+    INTERNAL,
+    ITERM,
+    BTERM
+  };
+
+  Type type = INTERNAL;
+  // Name map id of the net of internal nodes or of the instance of
+  // iterms, 0 for ports.
+  uint id = 0;
+  uint num = 0;  // internal node number
+  dbObject* object = nullptr;  // dbNet, dbITerm or dbBTerm
+  std::string_view word;
+};
+
+// One cap or resistor line; ground caps have no target.
+struct extSpefMappedElem
+{
+  extSpefMappedNode src;
+  extSpefMappedNode tgt;
+  bool coupling = false;
+  uint value = 0;
+  uint valueCnt = 0;
+};
+
+// A D_NET tokenized and converted, values already scaled by the units.
+struct extSpefMappedNet
+{
+  uint id = 0;
+  dbNet* net = nullptr;
+  std::vector<extSpefMappedElem> caps;
+  std::vector<extSpefMappedElem> res;
+  std::vector<double> values;
+  bool hasRes = false;
+  bool ended = false;
+  bool endedInConn = false;
+  const char* error = nullptr;
+};
+
+namespace {
+
+// Unmaps the file when reading ends, including when an error is thrown.
+class MappedFile
+{
+ public:
+  MappedFile(void* addr, size_t size) : addr_(addr), size_(size) {}
+  ~MappedFile() { munmap(addr_, size_); }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+ private:
+  void* addr_;
+  size_t size_;
+};
+
+struct MappedContext
+{
+  dbBlock* block;
+  const char* delimiter;
+  double capUnit;
+  double resUnit;
+  const std::vector<const char*>* names;
+  const std::vector<dbNet*>* nets;
+  const std::vector<dbInst*>* insts;
+};
+
+bool isBlank(const char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Splits a line into at most 5 words the way Ath__parser does: '#'
+// starts a comment anywhere on the line.
+uint splitLine(std::string_view line, std::string_view* words)
+{
+  const size_t comment = line.find('#');
+  if (comment != std::string_view::npos) {
+    line = line.substr(0, comment);
+  }
+  uint cnt = 0;
+  size_t pos = 0;
+  while (cnt < 5) {
+    while (pos < line.size() && isBlank(line[pos])) {
+      pos++;
+    }
+    if (pos == line.size()) {
+      break;
+    }
+    const size_t start = pos;
+    while (pos < line.size() && !isBlank(line[pos])) {
+      pos++;
+    }
+    words[cnt++] = line.substr(start, pos - start);
+  }
+  return cnt;
+}
+
+uint toUint(std::string_view word)
+{
+  uint value = 0;
+  for (const char c : word) {
+    if (c < '0' || c > '9') {
+      break;
+    }
+    value = value * 10 + (c - '0');
+  }
+  return value;
+}
+
+// Appends the delimiter separated values of a word, scaled by unit.
+uint addValues(std::string_view word,
+               const char* delimiter,
+               const double unit,
+               std::vector<double>& values)
+{
+  char buf[64];
+  uint cnt = 0;
+  while (!word.empty()) {
+    const size_t end = word.find_first_of(delimiter);
+    const std::string_view value = word.substr(0, end);
+    if (!value.empty()) {
+      const size_t len = std::min(value.size(), sizeof(buf) - 1);
+      memcpy(buf, value.data(), len);
+      buf[len] = '\0';
+      values.push_back(unit * atof(buf));
+      cnt++;
+    }
+    if (end == std::string_view::npos) {
+      break;
+    }
+    word.remove_prefix(end + 1);
+  }
+  return cnt;
+}
+
+extSpefMappedNode resolveNode(const std::string_view word,
+                              const MappedContext& ctx)
+{
+  extSpefMappedNode node;
+  node.word = word;
+  const size_t sep = word.find_first_of(ctx.delimiter);
+  if (sep == std::string_view::npos) {  // port
+    node.type = extSpefMappedNode::BTERM;
+    std::string name;
+    if (word[0] == '*') {
+      const uint id = toUint(word.substr(1));
+      if (id < ctx.names->size() && (*ctx.names)[id]) {
+        name = (*ctx.names)[id];
+      }
+    } else {
+      name = word;
+    }
+    node.object = ctx.block->findBTerm(name.c_str());
+    return node;
+  }
+  node.id = toUint(word.substr(1, sep - 1));
+  const std::string_view suffix = word.substr(sep + 1);
+  const bool known = node.id < ctx.nets->size();
+  if (!suffix.empty() && suffix[0] >= '0' && suffix[0] <= '9') {
+    node.type = extSpefMappedNode::INTERNAL;
+    node.num = toUint(suffix);
+    node.object = known ? (*ctx.nets)[node.id] : nullptr;
+    return node;
+  }
+  node.type = extSpefMappedNode::ITERM;
+  dbInst* inst = known ? (*ctx.insts)[node.id] : nullptr;
+  if (inst) {
+    node.object = inst->findITerm(std::string(suffix).c_str());
+  }
+  return node;
+}
+
+void parseNet(std::string_view text,
+              const MappedContext& ctx,
+              extSpefMappedNet& rec)
+{
+  enum Section
+  {
+    NONE,
+    CONN,
+    CAP,
+    RES
+  };
+
+  std::string_view words[5];
+  Section section = NONE;
+  bool header = true;
+  while (!text.empty()) {
+    const size_t eol = text.find('\n');
+    const std::string_view line = text.substr(0, eol);
+    text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+
+    const uint wCnt = splitLine(line, words);
+    if (wCnt == 0) {
+      continue;
+    }
+    if (header) {  // *D_NET *id totCap
+      header = false;
+      rec.id = wCnt > 1 ? toUint(words[1].substr(1)) : 0;
+      rec.net = rec.id < ctx.nets->size() ? (*ctx.nets)[rec.id] : nullptr;
+      continue;
+    }
+    if (words[0] == "*END") {
+      rec.ended = true;
+      rec.endedInConn = section == CONN;
+      return;
+    }
+    if (words[0] == "*CONN") {
+      section = CONN;
+      continue;
+    }
+    if (words[0] == "*CAP") {
+      section = CAP;
+      continue;
+    }
+    if (words[0] == "*RES") {
+      section = RES;
+      rec.hasRes = true;
+      continue;
+    }
+    if (section == CAP) {
+      if (wCnt < 3) {
+        rec.error = "Unexpected number of tokens";
+        return;
+      }
+      if (wCnt > 4) {
+        continue;
+      }
+      extSpefMappedElem elem;
+      elem.coupling = wCnt == 4;
+      elem.src = resolveNode(words[1], ctx);
+      if (elem.coupling) {
+        elem.tgt = resolveNode(words[2], ctx);
+      }
+      elem.value = rec.values.size();
+      elem.valueCnt = addValues(
+          words[wCnt - 1], ctx.delimiter, ctx.capUnit, rec.values);
+      rec.caps.push_back(elem);
+    } else if (section == RES) {
+      if (wCnt < 4) {
+        rec.error = "Unexpected number of tokens";
+        return;
+      }
+      extSpefMappedElem elem;
+      elem.src = resolveNode(words[1], ctx);
+      elem.tgt = resolveNode(words[2], ctx);
+      elem.value = rec.values.size();
+      elem.valueCnt
+          = addValues(words[3], ctx.delimiter, ctx.resUnit, rec.values);
+      rec.res.push_back(elem);
+    }
+  }
+}
+
+}  // namespace
+
+bool extSpef::canReadMapped() const
+{
+  const size_t len = strlen(_inFile);
+  const bool gz = len > 3 && strcmp(_inFile + len - 3, ".gz") == 0;
+  return _threads > 1 && !gz && _maxMapId > 0 && _rRun == 1 && !_diff
+         && !_calib && !_match && !_testParsing && !_statsOnly && !_extracted
+         && !_keep_loaded_corner && !_mMap && !_moreToRead
+         && !_cc_app_print_limit && _capNodeFile == nullptr && _tnetCnt == 0
+         && _readingNodeCoords == C_NONE && _rConn && _rCap && _rRes;
+}
+
+bool extSpef::readDNetsMapped(uint& cnt)
+{
+  const int fd = open(_inFile, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return false;
+  }
+  const size_t size = st.st_size;
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    return false;
+  }
+  const MappedFile mapped(addr, size);
+  madvise(addr, size, MADV_SEQUENTIAL);
+  const std::string_view file(static_cast<const char*>(addr), size);
+
+  // Every thread collects the *D_NET lines starting in its slice.
+  constexpr std::string_view dnet = "\n*D_NET";
+  const size_t first = file.find(dnet);
+  std::vector<std::vector<size_t>> starts(_threads);
+  if (first != std::string_view::npos) {
+    const size_t slice = (size - first) / _threads + 1;
+#pragma omp parallel for num_threads(_threads) schedule(static, 1)
+    for (int ii = 0; ii < _threads; ii++) {
+      const size_t end = std::min(size, first + (ii + 1) * slice);
+      size_t pos = file.find(dnet, first + ii * slice);
+      while (pos < end) {
+        starts[ii].push_back(pos + 1);
+        pos = file.find(dnet, pos + 1);
+      }
+    }
+  }
+  std::vector<size_t> offsets;
+  for (const std::vector<size_t>& thread_starts : starts) {
+    offsets.insert(offsets.end(), thread_starts.begin(), thread_starts.end());
+  }
+  offsets.push_back(size);
+
+  // Resolve the name map once; a name may be both a net and an instance.
+  const uint mapCnt = _maxMapId + 1;
+  std::vector<const char*> names(mapCnt, nullptr);
+  std::vector<dbNet*> nets(mapCnt, nullptr);
+  std::vector<dbInst*> insts(mapCnt, nullptr);
+  const char hierD = _block->getHierarchyDelimiter();
+#pragma omp parallel for num_threads(_threads) schedule(dynamic, 1024)
+  for (int ii = 1; ii < (int) mapCnt; ii++) {
+    names[ii] = _nameMapTable->geti(ii);
+    if (names[ii] == nullptr) {
+      continue;
+    }
+    std::string name = names[ii];
+    if (_divider[0] != hierD) {
+      std::replace(name.begin(), name.end(), _divider[0], hierD);
+    }
+    nets[ii] = _block->findNet(name.c_str());
+    insts[ii] = _block->findInst(name.c_str());
+  }
+
+  const uint netCnt = offsets.size() - 1;
+  logger_->info(
+      RCX, 521, "Reading {} D_NET nets on {} threads.", netCnt, _threads);
+
+  const MappedContext ctx{
+      _block, _delimiter, _cap_unit, _res_unit, &names, &nets, &insts};
+  _mappedNodes.clear();
+
+  // Nets are converted in batches so only one batch of records is held.
+  constexpr uint batchSize = 16384;
+  constexpr uint repChunk = 100000;
+  std::vector<extSpefMappedNet> recs;
+  for (uint begin = 0; begin < netCnt; begin += batchSize) {
+    const int end = std::min(netCnt, begin + batchSize);
+    recs.assign(end - begin, extSpefMappedNet());
+#pragma omp parallel for num_threads(_threads) schedule(dynamic, 64)
+    for (int ii = begin; ii < end; ii++) {
+      const std::string_view text
+          = file.substr(offsets[ii], offsets[ii + 1] - offsets[ii]);
+      parseNet(text, ctx, recs[ii - begin]);
+    }
+    for (const extSpefMappedNet& rec : recs) {
+      readMappedNet(rec);
+      if (_d_net && _doSortRSeg) {
+        sortRSegs();
+        for (dbCapNode* node : _d_corner_net->getCapNodes()) {
+          node->setSortIndex(0);
+        }
+      }
+    }
+    if (end / repChunk != begin / repChunk) {
+      logger_->info(RCX,
+                    522,
+                    "Have read {} D_NET nets, {} resistors, {} gnd caps {} "
+                    "coupling caps",
+                    end / repChunk * repChunk,
+                    _resCnt,
+                    _gndCapCnt,
+                    _ccCapCnt);
+    }
+  }
+  _mappedNodes.clear();
+
+  cnt = netCnt;
+  return true;
+}
+
+void extSpef::readMappedNet(const extSpefMappedNet& rec)
+{
+  uint netId = 0;
+  _d_net = rec.net;
+  if (!_d_net) {
+    _spefName = _nameMapTable->geti(rec.id);
+    getDbNet(&netId, rec.id);  // reports the unmatched net
+    return;
+  }
+  _d_corner_net = _cornerBlock == _block
+                      ? _d_net
+                      : dbNet::getNet(_cornerBlock, _d_net->getId());
+  if (rec.error) {
+    logger_->error(RCX,
+                   523,
+                   "Syntax error in D_NET {} ({})",
+                   _d_net->getConstName(),
+                   rec.error);
+  }
+  if (_d_corner_net->getZeroRSeg()) {
+    logger_->warn(RCX,
+                  524,
+                  "Net {} {} has rseg before reading spef",
+                  _d_net->getId(),
+                  _d_net->getConstName());
+    return;
+  }
+  dbRSeg* zrseg = dbRSeg::create(_d_corner_net, 0, 0, 0, false);
+  if (rec.endedInConn) {
+    return;
+  }
+
+  for (const extSpefMappedElem& elem : rec.caps) {
+    const double* values = &rec.values[elem.value];
+    if (!elem.coupling) {
+      _gndCapCnt++;
+      const uint capId = getMappedCapNode(elem.src, nullptr);
+      if (!capId) {
+        continue;
+      }
+      dbCapNode* cap = dbCapNode::getCapNode(_cornerBlock, capId);
+      if (_readAllCorners) {
+        for (uint ii = 0; ii < elem.valueCnt; ii++) {
+          if (_addRepeatedCapValue) {
+            cap->addCapacitance(values[ii], ii);
+          } else {
+            cap->setCapacitance(values[ii], ii);
+          }
+        }
+      } else if (_addRepeatedCapValue) {
+        cap->addCapacitance(values[_in_spef_corner], _db_ext_corner);
+      } else {
+        cap->setCapacitance(values[_in_spef_corner], _db_ext_corner);
+      }
+      continue;
+    }
+
+    _ccCapCnt++;
+    dbNet* srcNet = nullptr;
+    const uint srcId = getMappedCapNode(elem.src, &srcNet);
+    if (!srcId) {
+      continue;
+    }
+    dbNet* tgtNet = nullptr;
+    const uint tgtId = getMappedCapNode(elem.tgt, &tgtNet);
+    if (!tgtId) {
+      continue;
+    }
+    if (elem.src.type != extSpefMappedNode::INTERNAL
+        && elem.tgt.type != extSpefMappedNode::INTERNAL && srcNet != _d_net
+        && tgtNet != _d_net) {
+      logger_->error(RCX,
+                     525,
+                     "{} and {} are connected to a coupling cap of net {} {} "
+                     "in spef, but connected to net {} {} and net {} {} "
+                     "respectively in db.",
+                     elem.src.word,
+                     elem.tgt.word,
+                     _d_net->getId(),
+                     _d_net->getConstName(),
+                     srcNet->getId(),
+                     srcNet->getConstName(),
+                     tgtNet->getId(),
+                     tgtNet->getConstName());
+    }
+    dbCapNode* srcCap = dbCapNode::getCapNode(_cornerBlock, srcId);
+    if (srcId == tgtId) {
+      logger_->warn(RCX,
+                    526,
+                    "Source capnode {} is the same as target capnode {}. Add "
+                    "the cc capacitance to ground.",
+                    elem.src.word,
+                    elem.tgt.word);
+      if (_readAllCorners) {
+        for (uint ii = 0; ii < elem.valueCnt; ii++) {
+          srcCap->addCapacitance(values[ii], ii);
+        }
+      } else {
+        srcCap->addCapacitance(values[_in_spef_corner], _db_ext_corner);
+      }
+      continue;
+    }
+    dbCapNode* tgtCap = dbCapNode::getCapNode(_cornerBlock, tgtId);
+    dbCCSeg* ccap = dbCCSeg::create(srcCap, tgtCap, true);
+    if (_readAllCorners) {
+      for (uint ii = 0; ii < elem.valueCnt; ii++) {
+        ccap->setCapacitance(values[ii], ii);
+      }
+    } else {
+      ccap->setCapacitance(values[_in_spef_corner], _db_ext_corner);
+    }
+  }
+
+  // As readDNet: an *END closing the *CAP section skips the reversal.
+  if (rec.hasRes) {
+    _d_corner_net->getCapNodes().reverse();
+    _d_corner_net->reverseCCSegs();
+    _d_corner_net->setSpef(true);
+  }
+
+  uint resCnt = 0;
+  for (const extSpefMappedElem& elem : rec.res) {
+    _resCnt++;
+    const uint srcId = getMappedCapNode(elem.src, nullptr);
+    if (!srcId) {
+      return;
+    }
+    const uint tgtId = getMappedCapNode(elem.tgt, nullptr);
+    if (!tgtId) {
+      return;
+    }
+    if (resCnt == 0) {
+      zrseg->setTargetNode(srcId);
+      int x, y;
+      dbCapNode::getCapNode(_cornerBlock, srcId)->getTermCoords(x, y);
+      zrseg->setCoords(x, y);
+    }
+    dbRSeg* rseg = dbRSeg::create(_d_corner_net, 0, 0, 0, false);
+    const double* values = &rec.values[elem.value];
+    if (_readAllCorners) {
+      for (uint ii = 0; ii < elem.valueCnt; ii++) {
+        rseg->setResistance(values[ii], ii);
+      }
+    } else {
+      rseg->setResistance(values[_in_spef_corner], _db_ext_corner);
+    }
+    rseg->setSourceNode(srcId);
+    rseg->setTargetNode(tgtId);
+    resCnt++;
+  }
+  if (rec.ended) {
+    endNet(_d_corner_net, resCnt);
+  }
+}
+
+uint extSpef::getMappedCapNode(const extSpefMappedNode& node, dbNet** ccNet)
+{
+  uint netId = 0;
+  if (node.type == extSpefMappedNode::INTERNAL) {
+    dbNet* net = static_cast<dbNet*>(node.object);
+    if (!net) {
+      _spefName = _nameMapTable->geti(node.id);
+      getDbNet(&netId, node.id);  // reports the unmatched net
+      return 0;
+    }
+    if (ccNet) {
+      *ccNet = net;
+    }
+    const uint64_t key = ((uint64_t) net->getId() << 32) | node.num;
+    auto it = _mappedNodes.find(key);
+    if (it != _mappedNodes.end()) {
+      return it->second;
+    }
+    dbNet* cornerNet = _cornerBlock == _block
+                           ? net
+                           : dbNet::getNet(_cornerBlock, net->getId());
+    dbCapNode* cap = dbCapNode::create(cornerNet, 0, true);
+    cap->setNode(node.num);
+    cap->setInternalFlag();
+    _mappedNodes[key] = cap->getId();
+    return cap->getId();
+  }
+
+  dbNet* net = nullptr;
+  dbITerm* iterm = nullptr;
+  dbBTerm* bterm = nullptr;
+  if (node.type == extSpefMappedNode::ITERM) {
+    iterm = static_cast<dbITerm*>(node.object);
+    if (!iterm) {
+      _spefName = _nameMapTable->geti(node.id);
+      dbInst* inst = getDbInst(node.id);  // reports the unmatched inst
+      if (inst) {
+        logger_->error(RCX, 527, "Can't find iterm {} in db.", node.word);
+      }
+      return 0;
+    }
+    iterm->getInst()->setUserFlag1();
+    net = iterm->getNet();
+  } else {
+    bterm = static_cast<dbBTerm*>(node.object);
+    if (!bterm) {
+      logger_->error(RCX, 528, "Can't find bterm {} in db.", node.word);
+    }
+    net = bterm->getNet();
+  }
+  if (!net || (!ccNet && net != _d_net)) {
+    logger_->error(RCX,
+                   529,
+                   "Terminal {} is connected to net {} {} in spef, but "
+                   "connected to net {} in db.",
+                   node.word,
+                   _d_net->getId(),
+                   _d_net->getConstName(),
+                   net ? net->getConstName() : "none");
+  }
+  if (ccNet) {
+    *ccNet = net;
+  }
+
+  uint capId = iterm ? iterm->getExtId() : bterm->getExtId();
+  if (capId) {
+    return capId;
+  }
+  dbNet* cornerNet = _cornerBlock == _block
+                         ? net
+                         : dbNet::getNet(_cornerBlock, net->getId());
+  dbCapNode* cap = dbCapNode::create(cornerNet, 0, true);
+  capId = cap->getId();
+  if (iterm) {
+    iterm->setExtId(capId);
+    cap->setNode(iterm->getId());
+    cap->setITermFlag();
+  } else {
+    bterm->setExtId(capId);
+    cap->setBTermFlag();
+    cap->setNode(bterm->getId());
+  }
+  return capId;
+}
+
+}  // namespace rcx
@@ -63,6 +63,7 @@ int extMain::getExtCornerIndex(dbBlock* block, const char* cornerName)
 
 void extMain::adjustRC(double resFactor, double ccFactor, double gndcFactor)
 {
+  deleteParasiticStore();
   double res_factor = resFactor / _resFactor;
   _resFactor = resFactor;
   _resModify = resFactor == 1.0 ? false : true;
@@ -110,6 +111,8 @@ extMain::extMain()
 extMain::~extMain()
 {
   delete _modelTable;
+  delete _parasiticStore;
+  deleteNetTracker();
 }
 
 void extMain::initDgContextArray()
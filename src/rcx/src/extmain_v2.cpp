@@ -50,6 +50,8 @@ void extMain::makeBlockRCsegs_v2(const char* netNames, const char* extRules)
   if (!_lefRC && !modelExists(extRules))
     return;
 
+  deleteParasiticStore();
+
   // Selected user set for net names to be extracted
   std::vector<dbNet*> inets;
   markNetsToExtract_v2(netNames, inets);
@@ -93,14 +95,20 @@ void extMain::makeBlockRCsegs_v2(const char* netNames, const char* extRules)
   if (_lefRC) {
     // update dbNet object flags
     update_wireAltered_v2(inets);
+    trackNetChanges();
     return;
   }
   if (_couplingFlag > 1) {
     // Print out stats
     infoBeforeCouplingExt();
 
-    Rect maxRect = _block->getDieArea();
-    couplingFlow_v2(maxRect, _couplingFlag, nullptr);
+    for (Rect maxRect : getExtractionWindows()) {
+      if (_tiles > 1) {
+        couplingFlow_v2_tiles(maxRect, _couplingFlag);
+      } else {
+        couplingFlow_v2(maxRect, _couplingFlag, nullptr);
+      }
+    }
     // Print out stats on db Ojects created during extraction
     couplingExtEnd_v2();
   }
@@ -123,7 +131,7 @@ void extMain::infoBeforeCouplingExt()
 bool extMain::markNetsToExtract_v2(const char* netNames,
                                    std::vector<dbNet*>& inets)
 {
-  _allNet = !findSomeNet(_block, netNames, inets, logger_);
+  _allNet = !findNetsToExtract(netNames, inets);
   for (uint j = 0; j < inets.size(); j++) {
     dbNet* net = inets[j];
     net->setMark(true);
@@ -174,6 +182,7 @@ bool extMain::couplingExtEnd_v2()
 {
   _extracted = true;
   updatePrevControl();
+  trackNetChanges();
   int numOfNet;
   int numOfRSeg;
   int numOfCapNode;
@@ -252,8 +261,15 @@ void extMain::setExtractionOptions_v2(ExtractOptions options)
   _usingMetalPlanes = true;
   _ccUp = options.cc_up;  // Context up
   _ccContextDepth = options.context_depth;
+  _trackNetChanges = options.track_changes || options.incremental;
   _mergeViaRes = !options.no_merge_via_res;
   _mergeResBound = options.max_res;
+  _tiles = options.tiles;
+  _threads = options.threads;
+  if (_tiles > 1 && (_debug_net_id > 0 || _dbgOption > 0)) {
+    logger_->warn(RCX, 515, "Debug output is not supported with tiles.");
+    _tiles = 0;
+  }
   _extRun++;
 }
 
@@ -278,6 +294,15 @@ bool extMain::SetCornersAndReadModels_v2(const char* rulesFileName)
 
     extRCModel* m = createCornerMap(rulesFileName);
 
+    // Compiled rules files only load the models of the corners extracted
+    // and the layers of the technology.
+    std::vector<uint> models = {0};
+    for (uint ii = 0; ii < _modelMap.getCnt(); ii++) {
+      models.push_back(_modelMap.get(ii));
+    }
+    m->setLoadModels(models);
+    m->setLoadLayerCnt(getExtLayerCnt(_tech) + 1);
+
     if (!ReadModels_v2(rulesFileName, m, 0, nullptr))
       return false;
   }
@@ -1804,11 +1804,7 @@ void extMeasure::printNet(dbRSeg* rseg, uint netId)
 bool extMain::updateCoupCap(dbRSeg* rseg1, dbRSeg* rseg2, int jj, double v)
 {
   if (rseg1 != nullptr && rseg2 != nullptr) {
-    dbCCSeg* ccap
-        = dbCCSeg::create(dbCapNode::getCapNode(_block, rseg1->getTargetNode()),
-                          dbCapNode::getCapNode(_block, rseg2->getTargetNode()),
-                          true);
-    ccap->addCapacitance(v, jj);
+    addCouplingCap(rseg1, rseg2, v, jj);
     return true;
   }
   if (rseg1 != nullptr) {
@@ -1837,14 +1833,78 @@ double extMain::calcFringe(extDistRC* rc, double deltaFr, bool includeCoupling)
   return cap;
 }
 
+dbCCSeg* extMain::addCouplingCap(dbRSeg* rseg1,
+                                 dbRSeg* rseg2,
+                                 double v,
+                                 uint model)
+{
+  if (_tileParasitics != nullptr) {
+    _tileParasitics->couplings.push_back(
+        {rseg1->getId(), rseg2->getId(), model, v});
+    return nullptr;
+  }
+  dbCCSeg* ccap
+      = dbCCSeg::create(dbCapNode::getCapNode(_block, rseg1->getTargetNode()),
+                        dbCapNode::getCapNode(_block, rseg2->getTargetNode()),
+                        true);
+  ccap->addCapacitance(v, model);
+  return ccap;
+}
+
+void extMain::addCouplingCaps(dbRSeg* rseg1,
+                              dbRSeg* rseg2,
+                              const double* caps,
+                              const uint modelCnt)
+{
+  if (_tileParasitics != nullptr) {
+    for (uint model = 0; model < modelCnt; model++) {
+      _tileParasitics->couplings.push_back(
+          {rseg1->getId(), rseg2->getId(), model, caps[model]});
+    }
+    return;
+  }
+  // A single search of the capnode couplings serves all the corners
+  dbCCSeg* ccap
+      = dbCCSeg::create(dbCapNode::getCapNode(_block, rseg1->getTargetNode()),
+                        dbCapNode::getCapNode(_block, rseg2->getTargetNode()),
+                        true);
+  for (uint model = 0; model < modelCnt; model++) {
+    ccap->addCapacitance(caps[model], model);
+  }
+}
+
+void extMain::updateTotalCaps(dbRSeg* rseg,
+                              const double* caps,
+                              const uint modelCnt)
+{
+  if (rseg == nullptr) {
+    return;
+  }
+  for (uint model = 0; model < modelCnt; model++) {
+    updateTotalCap(rseg, caps[model], model);
+  }
+}
+
 double extMain::updateTotalCap(dbRSeg* rseg, double cap, uint modelIndex)
 {
   if (rseg == nullptr) {
     return 0;
   }
-
   int extDbIndex, sci, scDbIndex;
   extDbIndex = getProcessCornerDbIndex(modelIndex);
+  if (_tileParasitics != nullptr) {
+    _tileParasitics->caps.push_back({rseg->getId(), modelIndex, cap});
+    // The block is not written while tiles are measured, so the total
+    // is the stored value plus what this tile added so far.
+    const uint64_t key = ((uint64_t) rseg->getId() << 32) | modelIndex;
+    auto [total, inserted] = _tileParasitics->cap_totals.try_emplace(key);
+    if (inserted) {
+      total->second = rseg->getCapacitance(extDbIndex);
+    }
+    total->second += cap;
+    return total->second;
+  }
+
   double tot = rseg->getCapacitance(extDbIndex);
   tot += cap;
 
@@ -1879,6 +1939,11 @@ double extMain::updateRes(dbRSeg* rseg, double res, uint model)
   if (rseg == nullptr) {
     return 0;
   }
+  if (_tileParasitics != nullptr) {
+    // _resFactor is applied when the tile is written.
+    _tileParasitics->res.push_back({rseg->getId(), model, res});
+    return res;
+  }
 
   if (_resModify) {
     res *= _resFactor;
@@ -1909,7 +1974,7 @@ bool extMeasure::isConnectedToBterm(dbRSeg* rseg1)
   return false;
 }
 
-dbCCSeg* extMeasure::makeCcap(dbRSeg* rseg1, dbRSeg* rseg2, double ccCap)
+bool extMeasure::isBigCcap(dbRSeg* rseg1, dbRSeg* rseg2, double ccCap)
 {
   if ((rseg1 != nullptr) && (rseg2 != nullptr)
       && rseg1->getNet() != rseg2->getNet()) {  // signal nets
@@ -1918,22 +1983,12 @@ dbCCSeg* extMeasure::makeCcap(dbRSeg* rseg1, dbRSeg* rseg2, double ccCap)
 
     if (ccCap >= _extMain->_coupleThreshold) {
       _totBigCCcnt++;
-
-      dbCapNode* node1 = rseg1->getTargetCapNode();
-      dbCapNode* node2 = rseg2->getTargetCapNode();
-
-      return dbCCSeg::create(node1, node2, true);
+      return true;
     }
     _totSmallCCcnt++;
-    return nullptr;
+    return false;
   }
-  return nullptr;
-}
-
-void extMeasure::addCCcap(dbCCSeg* ccap, double v, uint model)
-{
-  double coupling = _ccModify ? v * _ccFactor : v;
-  ccap->addCapacitance(coupling, model);
+  return false;
 }
 
 void extMeasure::addFringe(dbRSeg* rseg1,
@@ -1954,6 +2009,27 @@ void extMeasure::addFringe(dbRSeg* rseg1,
   }
 }
 
+void extMeasure::addCCcaps(dbRSeg* rseg1, dbRSeg* rseg2, const double* caps)
+{
+  const uint modelCnt = _metRCTable.getCnt();
+  double coupling[20];
+  for (uint model = 0; model < modelCnt; model++) {
+    coupling[model] = _ccModify ? caps[model] * _ccFactor : caps[model];
+  }
+  _extMain->addCouplingCaps(rseg1, rseg2, coupling, modelCnt);
+}
+
+void extMeasure::addFringes(dbRSeg* rseg1, dbRSeg* rseg2, const double* caps)
+{
+  const uint modelCnt = _metRCTable.getCnt();
+  double frCap[20];
+  for (uint model = 0; model < modelCnt; model++) {
+    frCap[model] = _gndcModify ? caps[model] * _gndcFactor : caps[model];
+  }
+  _extMain->updateTotalCaps(rseg1, frCap, modelCnt);
+  _extMain->updateTotalCaps(rseg2, frCap, modelCnt);
+}
+
 void extMeasure::calcDiagRC(int rsegId1,
                             uint rsegId2,
                             uint len,
@@ -1991,14 +2067,12 @@ void extMeasure::calcDiagRC(int rsegId1,
     rseg2 = dbRSeg::getRSeg(_block, rsegId2);
   }
 
-  dbCCSeg* ccCap = makeCcap(rseg1, rseg2, capTable[_minModelIndex]);
-
+  if (isBigCcap(rseg1, rseg2, capTable[_minModelIndex])) {
+    addCCcaps(rseg1, rseg2, capTable);
+    return;
+  }
   for (uint model = 0; model < modelCnt; model++) {
-    if (ccCap != nullptr) {
-      addCCcap(ccCap, capTable[model], model);
-    } else {
-      addFringe(nullptr, rseg2, capTable[model], model);
-    }
+    addFringe(nullptr, rseg2, capTable[model], model);
   }
 }
 
@@ -2007,19 +2081,18 @@ void extMeasure::createCap(int rsegId1, uint rsegId2, double* capTable)
   dbRSeg* rseg1 = rsegId1 > 0 ? dbRSeg::getRSeg(_block, rsegId1) : nullptr;
   dbRSeg* rseg2 = rsegId2 > 0 ? dbRSeg::getRSeg(_block, rsegId2) : nullptr;
 
-  dbCCSeg* ccCap = makeCcap(rseg1, rseg2, capTable[_minModelIndex]);
+  const bool ccCap = isBigCcap(rseg1, rseg2, capTable[_minModelIndex]);
 
+  if (ccCap) {
+    addCCcaps(rseg1, rseg2, capTable);
+    return;
+  }
   uint modelCnt = _metRCTable.getCnt();
   for (uint model = 0; model < modelCnt; model++) {
-    if (ccCap != nullptr) {
-      addCCcap(ccCap, capTable[model], model);
-    } else {
-      _rc[model]->_diag += capTable[model];
-      addFringe(nullptr, rseg2, capTable[model], model);
-      // FIXME IMPORTANT-TEST-FIRST addFringe(rseg1, rseg2, capTable[model],
-      // model);
-    }
+    _rc[model]->_diag += capTable[model];
   }
+  addFringes(nullptr, rseg2, capTable);
+  // FIXME IMPORTANT-TEST-FIRST addFringes(rseg1, rseg2, capTable);
 }
 
 void extMeasure::areaCap(int rsegId1, uint rsegId2, uint len, uint tgtMet)
@@ -2151,6 +2224,8 @@ void extMeasure::calcRC(dbRSeg* rseg1, dbRSeg* rseg2, uint totLenCovered)
   int lenOverSub = _len - totLenCovered;
 
   uint modelCnt = _metRCTable.getCnt();
+  // Created for the first corner and reused by the others.
+  dbCCSeg* ccap = nullptr;
 
   for (uint model = 0; model < modelCnt; model++) {
     extMetRCTable* rcModel = _metRCTable.get(model);
@@ -2206,18 +2281,12 @@ void extMeasure::calcRC(dbRSeg* rseg1, dbRSeg* rseg2, uint totLenCovered)
         _extMain->updateRes(rseg2, res, model);
       }
 
-      dbCCSeg* ccap = nullptr;
       bool includeCoupling = true;
       if ((rseg1 != nullptr) && (rseg2 != nullptr)) {  // signal nets
 
         _totCCcnt++;
 
         if (_rc[_minModelIndex]->_coupling >= _extMain->_coupleThreshold) {
-          ccap = dbCCSeg::create(
-              dbCapNode::getCapNode(_block, rseg1->getTargetNode()),
-              dbCapNode::getCapNode(_block, rseg2->getTargetNode()),
-              true);
-
           includeCoupling = false;
           _totBigCCcnt++;
         } else {
@@ -2225,10 +2294,14 @@ void extMeasure::calcRC(dbRSeg* rseg1, dbRSeg* rseg2, uint totLenCovered)
         }
       }
       extDistRC* finalRC = _rc[model];
-      if (ccap != nullptr) {
+      if (!includeCoupling) {
         double coupling
             = _ccModify ? finalRC->_coupling * _ccFactor : finalRC->_coupling;
-        ccap->addCapacitance(coupling, model);
+        if (ccap != nullptr) {
+          ccap->addCapacitance(coupling, model);
+        } else {
+          ccap = _extMain->addCouplingCap(rseg1, rseg2, coupling, model);
+        }
       }
 
       double frCap = _extMain->calcFringe(finalRC, deltaFr, includeCoupling);
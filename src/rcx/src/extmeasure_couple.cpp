@@ -516,6 +516,8 @@ int extMeasureRC::CouplingFlow(uint dir,
         counts.wire_count++;
         if (w->isPower() || w->getRsegId() == 0)
           continue;
+        if (_tiled && (w->getBase() < _tileLo || w->getBase() >= _tileHi))
+          continue;
 
         if (config.debug_enabled)
           Print5wires(_segFP, w, w->getLevel());
@@ -524,7 +526,9 @@ int extMeasureRC::CouplingFlow(uint dir,
         totalWiresExtracted++;
         // TODO: use progress object _progressTracker->updateProgress();
 
-        if (counts.wire_count % _extMain->_wire_extracted_progress_count == 0) {
+        if (!_tiled
+            && counts.wire_count % _extMain->_wire_extracted_progress_count
+                   == 0) {
           printProgress(
               totalWiresExtracted, totWireCnt, previous_percent_extracted);
         }
@@ -1385,21 +1389,17 @@ void extMeasureRC::OpenEnded2(extSegment* cc,
   if (rseg1 == nullptr)
     return;
 
-  for (uint ii = 0; ii < _metRCTable.getCnt(); ii++) {
-    extMetRCTable* rcModel = _metRCTable.get(ii);
-    extDistRC* rc = OverUnderRC(rcModel,
-                                -1,
-                                cc->_wire->getWidth(),
-                                -1,
-                                len,
-                                met,
-                                underMet,
-                                overMet,
-                                segFP);
-
-    double inf_cc = 2 * len * (rc->_coupling + rc->_fringe);
-    _extMain->updateTotalCap(rseg1, inf_cc, ii);
-  }
+  extDistRC* rc[20];
+  if (!OverUnderRCs(
+          -1, cc->_wire->getWidth(), -1, met, underMet, overMet, rc))
+    return;
+
+  const uint modelCnt = _metRCTable.getCnt();
+  double inf_cc[20];
+  for (uint ii = 0; ii < modelCnt; ii++)
+    inf_cc[ii] = 2 * len * (rc[ii]->_coupling + rc[ii]->_fringe);
+
+  _extMain->updateTotalCaps(rseg1, inf_cc, modelCnt);
 }
 void extMeasureRC::OpenEnded1(extSegment* cc,
                               uint len,
@@ -1418,40 +1418,30 @@ void extMeasureRC::OpenEnded1(extSegment* cc,
   dbRSeg* rseg2 = cc->_down != nullptr ? GetRSeg(cc->_down->getRsegId())
                                        : GetRSeg(cc->_up->getRsegId());
 
-  dbCCSeg* ccCap = nullptr;
-  for (uint ii = 0; ii < _metRCTable.getCnt(); ii++) {
-    extMetRCTable* rcModel = _metRCTable.get(ii);
-    extDistRC* rc = OverUnderRC(rcModel,
-                                open,
-                                cc->_wire->getWidth(),
-                                dist,
-                                len,
-                                met,
-                                metUnder,
-                                metOver,
-                                segFP);
-
-    if (rc == nullptr)
-      continue;
-    double fr2 = 2 * len * rc->_fringe;
-    double cc = 2 * len * rc->_coupling;
-
-    _extMain->updateTotalCap(rseg, fr2, ii);
+  extDistRC* rc[20];
+  if (!OverUnderRCs(
+          open, cc->_wire->getWidth(), dist, met, metUnder, metOver, rc))
+    return;
 
-    if (CHECK_COUPLING_THRESHOLD) {
-      if (ii == 0) {
-        // check if the cap value is over the couplingThreshold, then create
-        // coupling cap object dbCCSeg
-        ccCap = makeCcap(rseg, rseg2, cc);
-      }
-      if (ccCap != nullptr)
-        addCCcap(ccCap, cc / 2, ii);
-      else
-        addFringe(rseg, rseg2, cc / 2, ii);
+  const uint modelCnt = _metRCTable.getCnt();
+  double fr2[20];
+  double cc2[20];
+  for (uint ii = 0; ii < modelCnt; ii++) {
+    fr2[ii] = 2 * len * rc[ii]->_fringe;
+    cc2[ii] = len * rc[ii]->_coupling;
+  }
+  _extMain->updateTotalCaps(rseg, fr2, modelCnt);
 
-    } else {
-      updateCoupCap(rseg, rseg2, ii, cc);
-    }
+  if (CHECK_COUPLING_THRESHOLD) {
+    // check if the cap value is over the couplingThreshold, then create
+    // coupling cap object dbCCSeg
+    if (isBigCcap(rseg, rseg2, 2 * cc2[0]))
+      addCCcaps(rseg, rseg2, cc2);
+    else
+      addFringes(rseg, rseg2, cc2);
+  } else {
+    for (uint ii = 0; ii < modelCnt; ii++)
+      updateCoupCap(rseg, rseg2, ii, 2 * cc2[ii]);
   }
 }
 void extMeasureRC::OverUnder(extSegment* cc,
@@ -1467,54 +1457,34 @@ void extMeasureRC::OverUnder(extSegment* cc,
   dbRSeg* rseg_down = GetRSeg(cc->_down->getRsegId());
   dbRSeg* rseg_up = GetRSeg(cc->_up->getRsegId());
 
-  dbCCSeg* ccCap_up = nullptr;
-  dbCCSeg* ccCap_down = nullptr;
-  for (uint ii = 0; ii < _metRCTable.getCnt(); ii++) {
-    extMetRCTable* rcModel = _metRCTable.get(ii);
-    extDistRC* rc_up = OverUnderRC(rcModel,
-                                   open,
-                                   cc->_wire->getWidth(),
-                                   cc->_dist,
-                                   len,
-                                   met,
-                                   metUnder,
-                                   metOver,
-                                   segFP);
-    extDistRC* rc_down = OverUnderRC(rcModel,
-                                     open,
-                                     cc->_wire->getWidth(),
-                                     cc->_dist_down,
-                                     len,
-                                     met,
-                                     metUnder,
-                                     metOver,
-                                     segFP);
-
-    double fr2 = len * (rc_up->_fringe + rc_down->_fringe);
-    double cc_up = len * rc_up->_coupling;
-    double cc_down = len * rc_down->_coupling;
-
-    _extMain->updateTotalCap(rseg, fr2, ii);
-
-    if (CHECK_COUPLING_THRESHOLD) {
-      if (ii == 0) {
-        // check if the cap value is over the couplingThreshold, then create
-        // coupling cap object dbCCSeg
-        ccCap_up = makeCcap(rseg, rseg_up, cc_up);
-        ccCap_down = makeCcap(rseg, rseg_down, cc_down);
-      }
-      if (ccCap_up != nullptr)
-        addCCcap(ccCap_up, cc_up / 2, ii);
-      else
-        addFringe(rseg, rseg_up, cc_up / 2, ii);
-
-      if (ccCap_down != nullptr)
-        addCCcap(ccCap_down, cc_down / 2, ii);
-      else
-        addFringe(rseg, rseg_down, cc_down / 2, ii);
-    } else {
-      updateCoupCap(rseg, rseg_up, ii, cc_up);
-      updateCoupCap(rseg, rseg_down, ii, cc_down);
+  const uint width = cc->_wire->getWidth();
+  extDistRC* rc_up[20];
+  extDistRC* rc_down[20];
+  if (!OverUnderRCs(open, width, cc->_dist, met, metUnder, metOver, rc_up)
+      || !OverUnderRCs(
+          open, width, cc->_dist_down, met, metUnder, metOver, rc_down))
+    return;
+
+  const uint modelCnt = _metRCTable.getCnt();
+  double fr2[20];
+  double cc_up[20];
+  double cc_down[20];
+  for (uint ii = 0; ii < modelCnt; ii++) {
+    fr2[ii] = len * (rc_up[ii]->_fringe + rc_down[ii]->_fringe);
+    cc_up[ii] = len * rc_up[ii]->_coupling;
+    cc_down[ii] = len * rc_down[ii]->_coupling;
+  }
+  _extMain->updateTotalCaps(rseg, fr2, modelCnt);
+
+  if (CHECK_COUPLING_THRESHOLD) {
+    // check if the cap value is over the couplingThreshold, then create
+    // coupling cap object dbCCSeg
+    addCoupling(rseg, rseg_up, cc_up);
+    addCoupling(rseg, rseg_down, cc_down);
+  } else {
+    for (uint ii = 0; ii < modelCnt; ii++) {
+      updateCoupCap(rseg, rseg_up, ii, cc_up[ii]);
+      updateCoupCap(rseg, rseg_down, ii, cc_down[ii]);
     }
   }
 }
@@ -1535,68 +1505,51 @@ void extMeasureRC::Model1(extSegment* cc,
   if (dist < cc->_dist_down)
     dist = cc->_dist_down;
 
-  dbCCSeg* ccCap_up = nullptr;
-  dbCCSeg* ccCap_down = nullptr;
-  for (uint ii = 0; ii < _metRCTable.getCnt(); ii++) {
-    extMetRCTable* rcModel = _metRCTable.get(ii);
-    extDistRC* rc_up = OverUnderRC(rcModel,
-                                   -1,
-                                   cc->_wire->getWidth(),
-                                   cc->_dist,
-                                   len,
-                                   met,
-                                   metUnder,
-                                   metOver,
-                                   segFP);
-    double cc_up = len * rc_up->_coupling;
-    // updateCoupCap(rseg1, rseg_up, ii, cc_up);
-
-    extDistRC* rc_down = OverUnderRC(rcModel,
-                                     -1,
-                                     cc->_wire->getWidth(),
-                                     cc->_dist_down,
-                                     len,
-                                     met,
-                                     metUnder,
-                                     metOver,
-                                     segFP);
-    double cc_down = len * rc_down->_coupling;
-    // updateCoupCap(rseg1, rseg_down, ii, cc_down);
-
-    extDistRC* rc_fr = OverUnderRC(rcModel,
-                                   open,
-                                   cc->_wire->getWidth(),
-                                   dist,
-                                   len,
-                                   met,
-                                   metUnder,
-                                   metOver,
-                                   segFP);
-    double fr2 = 2 * len * rc_fr->_fringe;
-    _extMain->updateTotalCap(rseg1, fr2, ii);
-
-    if (CHECK_COUPLING_THRESHOLD) {
-      if (ii == 0) {
-        // check if the cap value is over the couplingThreshold, then create
-        // coupling cap object dbCCSeg
-        ccCap_up = makeCcap(rseg1, rseg_up, cc_up);
-        ccCap_down = makeCcap(rseg1, rseg_down, cc_down);
-      }
-      if (ccCap_up != nullptr)
-        addCCcap(ccCap_up, cc_up / 2, ii);
-      else
-        addFringe(rseg1, rseg_up, cc_up / 2, ii);
-
-      if (ccCap_down != nullptr)
-        addCCcap(ccCap_down, cc_down / 2, ii);
-      else
-        addFringe(rseg1, rseg_down, cc_down / 2, ii);
-    } else {
-      updateCoupCap(rseg1, rseg_up, ii, cc_up);
-      updateCoupCap(rseg1, rseg_down, ii, cc_down);
+  const uint width = cc->_wire->getWidth();
+  extDistRC* rc_up[20];
+  extDistRC* rc_down[20];
+  extDistRC* rc_fr[20];
+  if (!OverUnderRCs(-1, width, cc->_dist, met, metUnder, metOver, rc_up)
+      || !OverUnderRCs(
+          -1, width, cc->_dist_down, met, metUnder, metOver, rc_down)
+      || !OverUnderRCs(open, width, dist, met, metUnder, metOver, rc_fr))
+    return;
+
+  const uint modelCnt = _metRCTable.getCnt();
+  double fr2[20];
+  double cc_up[20];
+  double cc_down[20];
+  for (uint ii = 0; ii < modelCnt; ii++) {
+    cc_up[ii] = len * rc_up[ii]->_coupling;
+    cc_down[ii] = len * rc_down[ii]->_coupling;
+    fr2[ii] = 2 * len * rc_fr[ii]->_fringe;
+  }
+  _extMain->updateTotalCaps(rseg1, fr2, modelCnt);
+
+  if (CHECK_COUPLING_THRESHOLD) {
+    // check if the cap value is over the couplingThreshold, then create
+    // coupling cap object dbCCSeg
+    addCoupling(rseg1, rseg_up, cc_up);
+    addCoupling(rseg1, rseg_down, cc_down);
+  } else {
+    for (uint ii = 0; ii < modelCnt; ii++) {
+      updateCoupCap(rseg1, rseg_up, ii, cc_up[ii]);
+      updateCoupCap(rseg1, rseg_down, ii, cc_down[ii]);
     }
   }
 }
+void extMeasureRC::addCoupling(dbRSeg* rseg1, dbRSeg* rseg2, const double* cc)
+{
+  const uint modelCnt = _metRCTable.getCnt();
+  double half[20];
+  for (uint ii = 0; ii < modelCnt; ii++)
+    half[ii] = cc[ii] / 2;
+
+  if (isBigCcap(rseg1, rseg2, cc[0]))
+    addCCcaps(rseg1, rseg2, half);
+  else
+    addFringes(rseg1, rseg2, half);
+}
 double extMeasureRC::updateCoupCap(dbRSeg* rseg1,
                                    dbRSeg* rseg2,
                                    int jj,
@@ -1606,15 +1559,10 @@ double extMeasureRC::updateCoupCap(dbRSeg* rseg1,
     double tot = _extMain->updateTotalCap(rseg1, v, jj);
     return tot;
   }
-  dbCCSeg* ccap
-      = dbCCSeg::create(dbCapNode::getCapNode(_block, rseg1->getTargetNode()),
-                        dbCapNode::getCapNode(_block, rseg2->getTargetNode()),
-                        true);
-
   v /= 2;
-  ccap->addCapacitance(v, jj);
+  dbCCSeg* ccap = _extMain->addCouplingCap(rseg1, rseg2, v, jj);
 
-  double cc = ccap->getCapacitance(jj);
+  double cc = ccap != nullptr ? ccap->getCapacitance(jj) : v;
 
   _extMain->printUpdateCoup(
       rseg1->getNet()->getId(), rseg2->getNet()->getId(), v, 2 * v, cc);
@@ -1642,5 +1590,67 @@ extDistRC* extMeasureRC::OverUnderRC(extMetRCTable* rcModel,
 
   return rc;
 }
+bool extMeasureRC::OverUnderRCs(int open,
+                                uint width,
+                                int dist,
+                                int met,
+                                int metUnder,
+                                int metOver,
+                                extDistRC** rcs)
+{
+  // The context index is the same in the models of all the corners
+  int mou;
+  if (metOver <= 0) {
+    if (met >= (int) _layerCnt)
+      return false;
+    mou = metUnder;
+  } else if (metUnder <= 0) {
+    mou = metOver - met - 1;
+  } else {
+    uint maxCnt = _currentModel->getMaxCnt(met);
+    mou = extMeasureRC::getMetIndexOverUnder(
+        met, metUnder, metOver, _layerCnt, maxCnt);
+    if (mou < 0)
+      return false;
+  }
+  const bool dist_based = dist >= 0 && open < 0;
+  const bool open_based = dist >= 0 && open >= 0;
+  if (open_based && open >= 2)
+    return false;
+
+  // A corner whose model has no value for the context gets zero values, so
+  // nothing is added to it, and the other corners are still written.
+  static extDistRC noRC{};
+  for (uint ii = 0; ii < _metRCTable.getCnt(); ii++) {
+    extMetRCTable* rcModel = _metRCTable.get(ii);
+    extDistWidthRCTable* rcTable = nullptr;
+    rcs[ii] = &noRC;
+    if (metOver <= 0) {
+      rcTable = open_based ? rcModel->_capOver_open[met][open]
+                           : rcModel->_capOver[met];
+    } else if (metUnder <= 0) {
+      if (rcModel->_capUnder[met] == nullptr)
+        continue;
+      if (!open_based)
+        rcTable = rcModel->_capUnder[met];
+      else if (rcModel->_capUnder_open != nullptr)
+        rcTable = rcModel->_capUnder_open[met][open];
+    } else {
+      if (!open_based)
+        rcTable = rcModel->_capOverUnder[met];
+      else if (rcModel->_capOverUnder_open != nullptr)
+        rcTable = rcModel->_capOverUnder_open[met][open];
+    }
+    if (rcTable == nullptr)
+      continue;
+
+    extDistRC* rc = dist_based || open_based
+                        ? rcTable->getRC(mou, width, dist)
+                        : rcTable->getFringeRC(mou, width);
+    if (rc != nullptr)
+      rcs[ii] = rc;
+  }
+  return true;
+}
 
 }  // namespace rcx
@@ -9,6 +9,7 @@
 
 #include "grids.h"
 #include "parse.h"
+#include "rcx/extParasiticStore.h"
 #include "rcx/extRCap.h"
 #include "rcx/extSpef.h"
 #include "util.h"
@@ -1038,6 +1039,7 @@ uint extMain::getExtBbox(int* x1, int* y1, int* x2, int* y2)
 
 void extMain::removeExt(std::vector<dbNet*>& nets)
 {
+  deleteParasiticStore();
   _block->destroyParasitics(nets);
   _extracted = false;
   if (_spef) {
@@ -1616,6 +1618,7 @@ bool extMain::setCorners(const char* rulesFileName)
 
     extRCModel* m = new extRCModel("MINTYPMAX", logger_);
     _modelTable->add(m);
+    m->setLoadLayerCnt(getExtLayerCnt(_tech) + 1);
 
     uint cornerTable[10];
     uint extDbCnt = 0;
@@ -1788,6 +1791,8 @@ void extMain::makeBlockRCsegs(const char* netNames,
   if (!modelExists(extRules))
     return;
 
+  deleteParasiticStore();
+
   uint debugNetId = 0;
 
   _diagFlow = true;
@@ -1818,7 +1823,7 @@ void extMain::makeBlockRCsegs(const char* netNames,
   _foreign = false;  // extract after read_spef
 
   std::vector<dbNet*> inets;
-  _allNet = !findSomeNet(_block, netNames, inets, logger_);
+  _allNet = !findNetsToExtract(netNames, inets);
   for (uint j = 0; j < inets.size(); j++) {
     dbNet* net = inets[j];
     net->setMark(true);
@@ -1957,11 +1962,12 @@ void extMain::makeBlockRCsegs(const char* netNames,
     }
 
     getPeakMemory("Start CouplingFlow");
-    Rect maxRect = _block->getDieArea();
-    if (_v2)
-      couplingFlow_v2(maxRect, _couplingFlag, &m);
-    else
-      couplingFlow(maxRect, _couplingFlag, &m, extCompute1);
+    for (Rect maxRect : getExtractionWindows()) {
+      if (_v2)
+        couplingFlow_v2(maxRect, _couplingFlag, &m);
+      else
+        couplingFlow(maxRect, _couplingFlag, &m, extCompute1);
+    }
 
     getPeakMemory("End CouplingFlow");
 
@@ -1978,6 +1984,7 @@ void extMain::makeBlockRCsegs(const char* netNames,
   }
   _extracted = true;
   updatePrevControl();
+  trackNetChanges();
   int numOfNet;
   int numOfRSeg;
   int numOfCapNode;
@@ -2209,7 +2216,8 @@ void extMain::writeSPEF(char* filename,
                         int corner,
                         const char* corner_name,
                         const char* spef_version,
-                        bool parallel)
+                        bool parallel,
+                        int threads)
 {
   if (_block == nullptr) {
     logger_->info(
@@ -2227,7 +2235,7 @@ void extMain::writeSPEF(char* filename,
   _spef->setUseIdsFlag(false);
   int cntnet, cntrseg, cntcapn, cntcc;
   _block->getExtCount(cntnet, cntrseg, cntcapn, cntcc);
-  if (cntrseg == 0 || cntcapn == 0) {
+  if ((cntrseg == 0 || cntcapn == 0) && _parasiticStore == nullptr) {
     logger_->info(
         RCX,
         134,
@@ -2258,6 +2266,8 @@ void extMain::writeSPEF(char* filename,
 
     std::vector<dbNet*> inets;
     findSomeNet(_block, netNames, inets, logger_);
+    _spef->setParasiticStore(_parasiticStore);
+    _spef->setThreads(threads);
     _spef->writeBlock(nodeCoord,
                       capUnit,
                       resUnit,
@@ -2280,6 +2290,55 @@ void extMain::writeSPEF(char* filename,
   _spef = nullptr;
 }
 
+void extMain::compactParasitics(const bool half, const bool releaseDb)
+{
+  int cntnet, cntrseg, cntcapn, cntcc;
+  _block->getExtCount(cntnet, cntrseg, cntcapn, cntcc);
+  if (cntcapn == 0) {
+    logger_->warn(RCX, 519, "There's no extraction data to compact.");
+    return;
+  }
+  if (_extRun == 0) {
+    getPrevControl();
+    getExtractedCorners();
+  }
+
+  deleteParasiticStore();
+  _parasiticStore = new extParasiticStore();
+  _parasiticStore->build(
+      _block, _block->getCornerCount(), _foreign, half, logger_);
+  if (!releaseDb) {
+    return;
+  }
+
+  std::vector<dbNet*> nets;
+  nets.reserve(_parasiticStore->getNetCount());
+  for (uint ii = 0; ii < _parasiticStore->getNetCount(); ii++) {
+    nets.push_back(dbNet::getNet(_block, _parasiticStore->getNetId(ii)));
+  }
+  _block->destroyParasitics(nets);
+  _parasiticsReleased = true;
+  logger_->warn(RCX,
+                520,
+                "Released the db parasitics of {} nets. They are only kept "
+                "for write_spef and are not saved by write_db.",
+                nets.size());
+}
+
+void extMain::deleteParasiticStore()
+{
+  if (_parasiticsReleased) {
+    logger_->warn(RCX,
+                  541,
+                  "Dropping the parasitics of {} nets released from the db "
+                  "by compact_parasitics -release_db.",
+                  _parasiticStore->getNetCount());
+    _parasiticsReleased = false;
+  }
+  delete _parasiticStore;
+  _parasiticStore = nullptr;
+}
+
 uint extMain::readSPEF(char* filename,
                        char* netNames,
                        bool force,
@@ -2311,8 +2370,14 @@ uint extMain::readSPEF(char* filename,
                        bool moreToRead,
                        bool diff,
                        bool calib,
-                       int app_print_limit)
+                       int app_print_limit,
+                       int threads)
 {
+  deleteParasiticStore();
+  if (!diff) {
+    // Parasitics read from SPEF are not updated by extract -incremental.
+    deleteNetTracker();
+  }
   if (!_spef || _spef->getBlock() != _block) {
     delete _spef;
     _spef = new extSpef(_tech, _block, logger_, "", this);
@@ -2355,6 +2420,7 @@ uint extMain::readSPEF(char* filename,
     findSomeNet(_block, netNames, inets, logger_);
   }
 
+  _spef->setThreads(threads);
   uint cnt = _spef->readBlock(0,
                               inets,
                               force,
@@ -3,10 +3,12 @@
 
 #include "parse.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 
+#include "extCompiledRules.h"
 #include "odb/odb.h"
 
 namespace rcx {
@@ -88,6 +90,8 @@ void Ath__parser::init()
   for (int ii = 0; ii < _maxWordCnt; ii++) {
     _wordArray[ii] = ATH__allocCharWord(512, _logger);
   }
+  _wordValues.resize(_maxWordCnt);
+  _wordIsNumber.resize(_maxWordCnt);
 
   _wordSeparators = ATH__allocCharWord(24, _logger);
 
@@ -133,6 +137,23 @@ void Ath__parser::addSeparator(const char* s)
 
 void Ath__parser::openFile(const char* name)
 {
+  if (name == nullptr && _compiled) {
+    _recordPos = _compiled->begin();
+    return;
+  }
+  if (name != nullptr && extCompiledRules::isCompiled(name)) {
+    _compiled = std::make_unique<extCompiledRules>();
+    if (!_compiled->open(name, _logger)) {
+      _logger->error(
+          utl::RCX, 536, "Cannot read compiled rules file {}.", name);
+    }
+    strcpy(_inputFile, name);
+    _recordPos = _compiled->begin();
+    return;
+  }
+  if (name != nullptr) {
+    _compiled.reset();
+  }
   if (name != nullptr && strlen(name) > 4
       && !strcmp(name + strlen(name) - 3, ".gz")) {
     char cmd[256];
@@ -216,6 +237,9 @@ int Ath__parser::getInt(int n, int start)
 
 double Ath__parser::getDouble(int ii)
 {
+  if (_compiled && ii >= 0 && ii < _currentWordCnt && _wordIsNumber[ii]) {
+    return _wordValues[ii];
+  }
   return atof(get(ii));
 }
 
@@ -225,11 +249,11 @@ void Ath__parser::getDoubleArray(odb::Ath__array1D<double>* A,
 {
   if (mult == 1.0) {
     for (int ii = start; ii < _currentWordCnt; ii++) {
-      A->add(atof(get(ii)));
+      A->add(getDouble(ii));
     }
   } else {
     for (int ii = start; ii < _currentWordCnt; ii++) {
-      A->add(atof(get(ii)) * mult);
+      A->add(getDouble(ii) * mult);
     }
   }
 }
@@ -351,8 +375,41 @@ void Ath__parser::reportProgress()
   }
 }
 
+int Ath__parser::readRecord(int prevWordCnt)
+{
+  if (_recordPos >= _compiled->end()) {
+    _currentWordCnt = prevWordCnt;
+    return prevWordCnt;
+  }
+  const int first = std::max(prevWordCnt, 0);
+  extCompiledRules::Word words[100];
+  int wordCnt;
+  _recordPos = extCompiledRules::readRecord(
+      _recordPos, words, std::min(_maxWordCnt - first, 100), wordCnt);
+  for (int ii = 0; ii < wordCnt; ii++) {
+    const extCompiledRules::Word& word = words[ii];
+    const uint32_t len = std::min<uint32_t>(word.len, 511);
+    memcpy(_wordArray[first + ii], word.str, len);
+    _wordArray[first + ii][len] = '\0';
+    _wordValues[first + ii] = word.value;
+    _wordIsNumber[first + ii] = word.isNumber;
+  }
+  _lineNum++;
+  reportProgress();
+  _currentWordCnt = first + wordCnt;
+  return _currentWordCnt;
+}
+
+void Ath__parser::seekRecord(const uint64_t offset)
+{
+  _recordPos = _compiled->begin() + offset;
+}
+
 int Ath__parser::readLineAndBreak(int prevWordCnt)
 {
+  if (_compiled) {
+    return readRecord(prevWordCnt);
+  }
   if (fgets(_line, _lineSize, _inFP) == nullptr) {
     _currentWordCnt = prevWordCnt;
     return prevWordCnt;
@@ -3,15 +3,20 @@
 
 #pragma once
 
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
+#include <vector>
 
 #include "odb/array1.h"
 #include "utl/Logger.h"
 
 namespace rcx {
 
+class extCompiledRules;
+
 class Ath__parser
 {
  public:
@@ -46,8 +51,14 @@ class Ath__parser
   int getLineNum();
   bool isDigit(int ii, int jj);
 
+  // Set when openFile found a file written by compile_rules; lines are
+  // then read from its records.
+  const extCompiledRules* getCompiledRules() const { return _compiled.get(); }
+  void seekRecord(uint64_t offset);
+
  private:
   void init();
+  int readRecord(int prevWordCnt);
   void reportProgress();
   int mkWords(int jj);
   bool isSeparator(char a);
@@ -67,6 +78,11 @@ class Ath__parser
 
   int _progressLineChunk;
   utl::Logger* _logger;
+
+  std::unique_ptr<extCompiledRules> _compiled;
+  const char* _recordPos = nullptr;
+  std::vector<double> _wordValues;
+  std::vector<char> _wordIsNumber;
 };
 
 }  // namespace rcx
@@ -0,0 +1,31 @@
+# write_spef after compact_parasitics -release_db
+source helpers.tcl
+
+set test_nets ""
+
+read_lef sky130hs/sky130hs.tlef
+read_lef sky130hs/sky130hs_std_cell.lef
+read_liberty sky130hs/sky130hs_tt.lib
+
+read_def gcd.def
+
+# Load via resistance info
+source sky130hs/sky130hs.rc
+
+define_process_corner -ext_model_index 0 X
+extract_parasitics -ext_model_file ext_pattern.rules -max_res 0 -coupling_threshold 0.1
+
+tee -quiet -variable log { compact_parasitics -release_db }
+puts "released: [regexp {RCX-0520} $log]"
+
+set spef_file [make_result_file compact_parasitics.spef]
+write_spef $spef_file -nets $test_nets
+
+diff_files gcd.spefok $spef_file "^\\*(DATE|VERSION)"
+
+# The released parasitics cannot be updated.
+catch { extract_parasitics -ext_model_file ext_pattern.rules -incremental }
+
+# Dropping them warns.
+tee -quiet -variable log { adjust_rc -res_factor 1.0 }
+puts "dropped: [regexp {RCX-0541} $log]"
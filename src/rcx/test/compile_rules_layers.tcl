@@ -0,0 +1,33 @@
+# Compiled rules extract like the text rules, skipping the layers above
+# the technology
+source helpers.tcl
+
+read_lef sky130hs/sky130hs.tlef
+read_lef sky130hs/sky130hs_std_cell.lef
+read_liberty sky130hs/sky130hs_tt.lib
+
+read_def gcd.def
+
+# Load via resistance info
+source sky130hs/sky130hs.rc
+
+define_process_corner -ext_model_index 0 X
+
+# The rules have 10 metal layers, the technology 6.
+set rules 45_patterns.rules
+set compiled [make_result_file compile_rules_layers.bin]
+tee -quiet -variable log "compile_rules -ext_model_file $rules -file $compiled"
+puts "compiled: [regexp {RCX-0534} $log]"
+
+set ext_args "-max_res 0 -coupling_threshold 0.1"
+foreach {name model} [list text $rules compiled $compiled] {
+  foreach net [[ord::get_db_block] getNets] {
+    $net destroyParasitics
+  }
+  tee -quiet -variable log \
+    "extract_parasitics -ext_model_file $model $ext_args"
+  set spef($name) [make_result_file compile_rules_layers_$name.spef]
+  tee -quiet -variable log "write_spef $spef($name)"
+}
+
+diff_files $spef(text) $spef(compiled) "^\\*(DATE|VERSION)"
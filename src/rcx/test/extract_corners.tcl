@@ -0,0 +1,74 @@
+# A corner missing a rules table does not change the other corners
+source helpers.tcl
+
+# Copies the rules without the table of model.
+proc drop_rules_table { in_file out_file model table } {
+  set in [open $in_file r]
+  set out [open $out_file w]
+  set current -1
+  set skip 0
+  while { [gets $in line] >= 0 } {
+    regexp {^DensityModel (\d+)} $line -> current
+    if { $current == $model && $line eq $table } {
+      set skip 1
+    } elseif { $skip && [regexp {^Metal \d+ [A-Z]+$} $line] } {
+      set skip 0
+    }
+    if { !$skip } {
+      puts $out $line
+    }
+  }
+  close $in
+  close $out
+}
+
+# Total capacitance of each *D_NET of a SPEF file in corner.
+proc spef_corner_caps { spef_file corner } {
+  set caps [dict create]
+  set stream [open $spef_file r]
+  while { [gets $stream line] >= 0 } {
+    if { [regexp {^\*D_NET (\S+) (\S+)} $line -> net cap] } {
+      dict set caps $net [lindex [split $cap ":"] $corner]
+    }
+  }
+  close $stream
+  return $caps
+}
+
+read_lef sky130hs/sky130hs.tlef
+read_lef sky130hs/sky130hs_std_cell.lef
+read_liberty sky130hs/sky130hs_tt.lib
+
+read_def gcd.def
+
+# Load via resistance info
+source sky130hs/sky130hs.rc
+
+tee -quiet -variable log { define_rcx_corners -corner_list "min typ max" }
+
+set rules rcx_v2/flow/corners/data/ext_pattern.rules.3corners
+set dropped [make_result_file extract_corners.rules]
+drop_rules_table $rules $dropped 1 "Metal 3 UNDER"
+
+set ext_args "-max_res 0 -coupling_threshold 0.1 -version 2.0 -skip_over_cell"
+foreach {name model} [list full $rules dropped $dropped] {
+  foreach net [[ord::get_db_block] getNets] {
+    $net destroyParasitics
+  }
+  tee -quiet -variable log \
+    "extract_parasitics -ext_model_file $model $ext_args"
+  set spef($name) [make_result_file extract_corners_$name.spef]
+  tee -quiet -variable log "write_spef $spef($name)"
+}
+
+foreach corner { 0 1 2 } {
+  set full [spef_corner_caps $spef(full) $corner]
+  set dropped [spef_corner_caps $spef(dropped) $corner]
+  set diffs 0
+  dict for {net cap} $full {
+    if { ![dict exists $dropped $net] || [dict get $dropped $net] != $cap } {
+      incr diffs
+    }
+  }
+  puts "corner $corner nets: [dict size $full] changed: [expr { $diffs > 0 }]"
+}
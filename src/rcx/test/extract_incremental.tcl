@@ -0,0 +1,38 @@
+# extract_parasitics -incremental after an ECO matches a full extraction
+source helpers.tcl
+
+read_lef sky130hs/sky130hs.tlef
+read_lef sky130hs/sky130hs_std_cell.lef
+read_liberty sky130hs/sky130hs_tt.lib
+
+read_def gcd.def
+
+# Load via resistance info
+source sky130hs/sky130hs.rc
+
+define_process_corner -ext_model_index 0 X
+
+set ext_args "-ext_model_file ext_pattern.rules -max_res 0\
+  -coupling_threshold 0.1"
+extract_parasitics {*}$ext_args -track_changes
+
+# ECO: unroute two nets on opposite sides of the die.
+set block [ord::get_db_block]
+foreach name { _008_ _017_ } {
+  odb::dbWire_destroy [[$block findNet $name] getWire]
+}
+
+tee -quiet -variable log "extract_parasitics $ext_args -incremental"
+puts "incremental: [regexp {RCX-0532} $log]"
+set incr_spef [make_result_file extract_incremental_incr.spef]
+tee -quiet -variable log "write_spef $incr_spef"
+
+foreach net [$block getNets] {
+  $net destroyParasitics
+}
+
+tee -quiet -variable log "extract_parasitics $ext_args"
+set full_spef [make_result_file extract_incremental_full.spef]
+tee -quiet -variable log "write_spef $full_spef"
+
+diff_spef_caps $full_spef $incr_spef
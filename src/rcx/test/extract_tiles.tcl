@@ -0,0 +1,35 @@
+# extract_parasitics -tiles matches the single band v2 flow
+source helpers.tcl
+
+read_lef sky130hs/sky130hs.tlef
+read_lef sky130hs/sky130hs_std_cell.lef
+read_liberty sky130hs/sky130hs_tt.lib
+
+read_def gcd.def
+
+# Load via resistance info
+source sky130hs/sky130hs.rc
+
+define_process_corner -ext_model_index 0 X
+set_thread_count 4
+
+set ext_args "-ext_model_file ext_pattern.rules -max_res 0\
+  -coupling_threshold 0.1 -version 2.0 -skip_over_cell"
+
+# The progress messages depend on the flow.
+tee -quiet -file [make_result_file extract_tiles_single.log] \
+  "extract_parasitics $ext_args"
+set single_spef [make_result_file extract_tiles_single.spef]
+write_spef $single_spef
+
+foreach net [[ord::get_db_block] getNets] {
+  $net destroyParasitics
+}
+
+tee -quiet -file [make_result_file extract_tiles_4.log] \
+  "extract_parasitics $ext_args -tiles 4"
+set tiles_spef [make_result_file extract_tiles_4.spef]
+write_spef $tiles_spef
+
+diff_spef_caps $single_spef $tiles_spef
+diff_spef_coupling_caps $single_spef $tiles_spef
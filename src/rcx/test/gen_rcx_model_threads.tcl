@@ -0,0 +1,30 @@
+# gen_rcx_model on 1 and 4 threads
+source helpers.tcl
+
+read_lef sky130hs/sky130hs.tlef
+
+tee -quiet -variable log { bench_wires -len 100 -all -v1 }
+
+# The extracted patterns stand in for the field solver results.
+define_process_corner -ext_model_index 0 X
+set ext_args "-ext_model_file ext_pattern.rules -cc_model 12 -max_res 0\
+  -context_depth 10 -coupling_threshold 0.1"
+tee -quiet -variable log "extract_parasitics $ext_args"
+set spef_file [make_result_file gen_rcx_model_threads.spef]
+tee -quiet -variable log "write_spef $spef_file"
+
+foreach threads { 1 4 } {
+  set_thread_count $threads
+  set rules($threads) [make_result_file gen_rcx_model_threads$threads.rules]
+  set gen_args [list -spef_file_list "$spef_file $spef_file" \
+    -corner_list "MIN MAX" -out_file $rules($threads)]
+  tee -quiet -variable log "gen_rcx_model $gen_args"
+  puts "threads $threads generated: [regexp {RCX-0540} $log]"
+  file delete MIN.0.log MIN.0.debug.log MAX.1.log MAX.1.debug.log
+}
+
+set stream [open $rules(4) r]
+puts "models: [regexp -all -line {^DensityModel} [read $stream]]"
+close $stream
+
+diff_files $rules(1) $rules(4)
@@ -25,7 +25,8 @@ def extract_parasitics(
     lef_rc=False,
     skip_over_cell=False,
     version=1.0,
-    dbg=0
+    dbg=0,
+    incremental=False
 ):
 
     opts = rcx.ExtractOptions()
@@ -49,17 +50,21 @@ def extract_parasitics(
     opts._version = version
 
     opts._dbg = dbg
+    opts.incremental = incremental
 
     design.getOpenRCX().extract(opts)
 
 
-def write_spef(design, *, filename="", nets="", net_id=0, coordinates=False):
+def write_spef(
+    design, *, filename="", nets="", net_id=0, coordinates=False, gzip=False
+):
     opts = rcx.SpefOptions()
     opts.file = filename
     opts.nets = nets
     opts.net_id = net_id
     if coordinates:
         opts.N = "Y"
+    opts.gz = gzip
 
     design.getOpenRCX().write_spef(opts)
 
@@ -106,6 +111,10 @@ def adjust_rc(design, *, res_factor=1.0, cc_factor=1.0, gndc_factor=1.0):
     design.getOpenRCX().adjust_rc(res_factor, cc_factor, gndc_factor)
 
 
+def compact_parasitics(design, *, half_precision=False, release_db=False):
+    design.getOpenRCX().compact_parasitics(half_precision, release_db)
+
+
 def diff_spef(
     design, *, filename="", r_conn=False, r_res=False, r_cap=False, r_cc_cap=False
 ):
@@ -122,6 +131,10 @@ def write_rules(design, *, filename="extRules", dir="./", name="TYP", pattern=0)
     design.getOpenRCX().write_rules(filename, dir, name, pattern)
 
 
+def compile_rules(design, *, ext_model_file="", filename=""):
+    design.getOpenRCX().compile_rules(ext_model_file, filename)
+
+
 def read_spef(design, *, filename):
     opts = rcx.DiffOptions()
     opts.file = filename
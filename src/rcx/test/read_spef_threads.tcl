@@ -0,0 +1,29 @@
+# Read SPEF on 1 and 4 threads
+source helpers.tcl
+
+read_lef sky130hs/sky130hs.tlef
+read_lef sky130hs/sky130hs_std_cell.lef
+read_liberty sky130hs/sky130hs_tt.lib
+
+read_def gcd.def
+
+# Load via resistance info
+source sky130hs/sky130hs.rc
+
+define_process_corner -ext_model_index 0 X
+extract_parasitics -ext_model_file ext_pattern.rules -max_res 0 -coupling_threshold 0.1
+
+foreach threads { 1 4 } {
+  set_thread_count $threads
+  foreach net [[ord::get_db_block] getNets] {
+    $net destroyParasitics
+  }
+  tee -quiet -variable log { bench_read_spef gcd.spefok }
+  puts "threads $threads mapped: [regexp {RCX-0521} $log]"
+
+  set spef_file [make_result_file read_spef_threads$threads.spef]
+  tee -quiet -variable log "write_spef $spef_file"
+}
+
+diff_files [make_result_file read_spef_threads1.spef] \
+  [make_result_file read_spef_threads4.spef] "^\\*(DATE|VERSION)"
@@ -103,6 +103,8 @@ using BufferedNetPtr = std::shared_ptr<BufferedNet>;
 using PinPtr = const sta::Pin*;
 using PinVector = std::vector<PinPtr>;
 
+class LagrangianSizer;
+class LibraryCache;
 class RecoverPower;
 class RepairDesign;
 class RepairSetup;
@@ -234,6 +236,9 @@ class Resizer : public dbStaState, public dbNetworkObserver
   void resetDontUse();
   bool dontUse(const LibertyCell* cell);
   void reportDontUse() const;
+  // Persist the buffer target slews, cell target loads and fast buffer
+  // selection in filename across sessions. Empty filename disables it.
+  void setLibraryCacheFile(const std::string& filename);
   void setDontTouch(const Instance* inst, bool dont_touch);
   bool dontTouch(const Instance* inst);
   void setDontTouch(const Net* net, bool dont_touch);
@@ -292,6 +297,8 @@ class Resizer : public dbStaState, public dbNetworkObserver
                   float max_buffer_percent,
                   int max_passes,
                   bool match_cell_footprint,
+                  // Insert the buffers of a pass together.
+                  bool batch,
                   bool verbose);
   void repairHold(const Pin* end_pin,
                   double setup_margin,
@@ -304,8 +311,18 @@ class Resizer : public dbStaState, public dbNetworkObserver
   ////////////////////////////////////////////////////////////////
   bool recoverPower(float recover_power_percent,
                     bool match_cell_footprint,
+                    // Rank and commit downsizes in batches on num_threads.
+                    bool sweep,
+                    int num_threads,
                     bool verbose);
 
+  ////////////////////////////////////////////////////////////////
+  // Size all gates together by Lagrangian relaxation.
+  bool sizeGates(int max_passes,
+                 bool match_cell_footprint,
+                 int num_threads,
+                 bool verbose);
+
   ////////////////////////////////////////////////////////////////
   // Area of the design in meter^2.
   double designArea();
@@ -336,6 +353,7 @@ class Resizer : public dbStaState, public dbNetworkObserver
       double cap_margin,       // 0.0-1.0
       double buffer_gain,
       bool match_cell_footprint,
+      bool pre_screen,  // screen drivers for violations before repairing
       bool verbose);
   int repairDesignBufferCount() const;
   // for debugging
@@ -695,6 +713,8 @@ class Resizer : public dbStaState, public dbNetworkObserver
   ////////////////////////////////////////////////////////////////
 
   // Components
+  LagrangianSizer* lagrangian_sizer_;
+  LibraryCache* library_cache_;
   RecoverPower* recover_power_;
   RepairDesign* repair_design_;
   RepairSetup* repair_setup_;
@@ -816,6 +836,8 @@ class Resizer : public dbStaState, public dbNetworkObserver
 
   friend class BufferedNet;
   friend class GateCloner;
+  friend class LagrangianSizer;
+  friend class LibraryCache;
   friend class PreChecks;
   friend class RecoverPower;
   friend class RepairDesign;
@@ -0,0 +1,546 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#include "LagrangianSizer.hh"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "db_sta/dbNetwork.hh"
+#include "rsz/Resizer.hh"
+#include "sta/Corner.hh"
+#include "sta/DcalcAnalysisPt.hh"
+#include "sta/Fuzzy.hh"
+#include "sta/Graph.hh"
+#include "sta/GraphDelayCalc.hh"
+#include "sta/Liberty.hh"
+#include "sta/Network.hh"
+#include "sta/PortDirection.hh"
+#include "sta/Units.hh"
+#include "utl/Logger.h"
+
+namespace rsz {
+
+using std::string;
+using std::vector;
+
+using utl::RSZ;
+
+using sta::fuzzyGreater;
+using sta::fuzzyInf;
+using sta::fuzzyLess;
+using sta::InstancePinIterator;
+using sta::LibertyPort;
+using sta::Net;
+using sta::NetConnectedPinIterator;
+
+LagrangianSizer::LagrangianSizer(Resizer* resizer) : resizer_(resizer)
+{
+}
+
+void LagrangianSizer::init()
+{
+  logger_ = resizer_->logger_;
+  dbStaState::init(resizer_->sta_);
+  dcalc_ap_ = resizer_->tgt_slew_dcalc_ap_;
+  gates_.clear();
+  gate_index_.clear();
+  level_starts_.clear();
+  step_ = 1.0;
+  resize_count_ = 0;
+}
+
+bool LagrangianSizer::sizeGates(const int max_passes,
+                                const int num_threads,
+                                const bool verbose)
+{
+  init();
+  if (!findDelayNorm()) {
+    logger_->warn(RSZ, 157, "No constrained endpoints found to size gates.");
+    return false;
+  }
+  makeGates();
+  if (gates_.empty()) {
+    return false;
+  }
+
+  Vertex* worst_vertex;
+  sta_->worstSlack(max_, best_wns_, worst_vertex);
+  best_tns_ = sta_->totalNegativeSlack(max_);
+  initMultipliers();
+
+  logger_->info(RSZ, 158, "Sizing {} gates.", gates_.size());
+  printProgress(0, 0, true);
+  int pass = 1;
+  for (; pass <= max_passes && step_ >= step_min_; pass++) {
+    sweep(num_threads);
+    const int resized = commitSizes();
+    if (resized == 0) {
+      break;
+    }
+    resizer_->updateParasitics();
+    sta_->findRequireds();
+    Slack wns;
+    sta_->worstSlack(max_, wns, worst_vertex);
+    const Slack tns = sta_->totalNegativeSlack(max_);
+    const bool accepted = acceptable(wns, tns);
+    if (accepted) {
+      resizer_->journalEnd();
+      for (Gate& gate : gates_) {
+        gate.committed = gate.size;
+      }
+      resize_count_ += resized;
+      best_wns_ = wns;
+      best_tns_ = tns;
+    } else {
+      restoreSizes();
+      step_ /= 2;
+    }
+    if (verbose || !accepted) {
+      printProgress(pass, resized, accepted);
+    }
+    updateMultipliers();
+  }
+  printProgress(-1, 0, true);
+
+  if (resize_count_ > 0) {
+    logger_->info(RSZ, 159, "Resized {} instances.", resize_count_);
+  }
+  return resize_count_ > 0;
+}
+
+// Delays and slacks are measured against the largest finite required
+// time so the multipliers do not depend on the time unit or clock period.
+bool LagrangianSizer::findDelayNorm()
+{
+  delay_norm_ = 0.0;
+  for (Vertex* end : *sta_->endpoints()) {
+    const float required = sta_->vertexRequired(end, max_);
+    // Unconstrained endpoints have an infinite required time.
+    if (!fuzzyInf(required)) {
+      delay_norm_ = std::max(delay_norm_, required);
+    }
+  }
+  return delay_norm_ > 0.0;
+}
+
+////////////////////////////////////////////////////////////////
+
+void LagrangianSizer::makeGates()
+{
+  // level_drvr_vertices_ is sorted by level, so the gates are too.
+  int level = -1;
+  for (Vertex* drvr_vertex : resizer_->level_drvr_vertices_) {
+    const Pin* drvr_pin = drvr_vertex->pin();
+    Instance* inst = network_->instance(drvr_pin);
+    if (network_->isTopLevelPort(drvr_pin)
+        || gate_index_.find(inst) != gate_index_.end()
+        || resizer_->dontTouch(inst) || !resizer_->isLogicStdCell(inst)) {
+      continue;
+    }
+    const int gate_index = gates_.size();
+    if (makeGate(inst, drvr_vertex)) {
+      gate_index_[inst] = gate_index;
+      if (drvr_vertex->level() != level) {
+        level = drvr_vertex->level();
+        level_starts_.push_back(gate_index);
+      }
+    }
+  }
+  level_starts_.push_back(gates_.size());
+  connectGates();
+  debugPrint(logger_,
+             RSZ,
+             "lr_sizer",
+             1,
+             "gates {} levels {}",
+             gates_.size(),
+             level_starts_.size() - 1);
+}
+
+// Gather the Liberty data of the swappable cells of inst so the sweeps
+// only read flat arrays.
+bool LagrangianSizer::makeGate(Instance* inst, Vertex* drvr_vertex)
+{
+  LibertyCell* cell = network_->libertyCell(inst);
+  if (cell == nullptr) {
+    return false;
+  }
+  const Slack slack = sta_->vertexSlack(drvr_vertex, max_);
+  if (slack > slack_max_margin_) {
+    return false;
+  }
+  LibertyCellSeq swappable_cells = resizer_->getSwappableCells(cell);
+  if (std::find(swappable_cells.begin(), swappable_cells.end(), cell)
+      == swappable_cells.end()) {
+    swappable_cells.push_back(cell);
+  }
+  if (swappable_cells.size() < 2) {
+    return false;
+  }
+
+  Gate gate;
+  gate.inst = inst;
+  const int lib_ap = dcalc_ap_->libertyIndex();
+  vector<const LibertyPort*> output_ports;
+  vector<const LibertyPort*> input_ports;
+  InstancePinIterator* pin_iter = network_->pinIterator(inst);
+  while (pin_iter->hasNext()) {
+    const Pin* pin = pin_iter->next();
+    const LibertyPort* port = network_->libertyPort(pin);
+    if (port == nullptr) {
+      continue;
+    }
+    if (network_->isDriver(pin)) {
+      Vertex* vertex = graph_->pinDrvrVertex(pin);
+      if (vertex == nullptr) {
+        continue;
+      }
+      Output output;
+      output.vertex = vertex;
+      output.fixed_load = graph_delay_calc_->loadCap(pin, dcalc_ap_);
+      gate.outputs.push_back(output);
+      output_ports.push_back(port);
+    } else if (network_->isLoad(pin)) {
+      Input input;
+      Net* net = network_->net(pin);
+      if (net) {
+        NetConnectedPinIterator* net_pin_iter
+            = network_->connectedPinIterator(net);
+        while (net_pin_iter->hasNext()) {
+          const Pin* net_pin = net_pin_iter->next();
+          const LibertyPort* drvr_port = network_->libertyPort(net_pin);
+          if (network_->isDriver(net_pin) && drvr_port) {
+            input.fixed_drive
+                = drvr_port->cornerPort(lib_ap)->driveResistance();
+            break;
+          }
+        }
+        delete net_pin_iter;
+      }
+      gate.inputs.push_back(input);
+      input_ports.push_back(port);
+    }
+  }
+  delete pin_iter;
+  if (gate.outputs.empty()) {
+    return false;
+  }
+
+  const float cell_area = std::max(cell->area(), 1e-12f);
+  for (LibertyCell* swappable : swappable_cells) {
+    const LibertyCell* corner_cell = swappable->cornerCell(lib_ap);
+    vector<const LibertyPort*> outputs;
+    vector<const LibertyPort*> inputs;
+    for (const LibertyPort* port : output_ports) {
+      outputs.push_back(corner_cell->findLibertyPort(port->name()));
+    }
+    for (const LibertyPort* port : input_ports) {
+      inputs.push_back(corner_cell->findLibertyPort(port->name()));
+    }
+    if (std::find(outputs.begin(), outputs.end(), nullptr) != outputs.end()
+        || std::find(inputs.begin(), inputs.end(), nullptr) != inputs.end()) {
+      continue;
+    }
+    if (swappable == cell) {
+      gate.size = gate.committed = gate.cells.size();
+    }
+    gate.cells.push_back(swappable);
+    gate.area.push_back(swappable->area() / cell_area);
+    for (const LibertyPort* port : outputs) {
+      gate.drive_res.push_back(port->driveResistance());
+      gate.intrinsic.push_back(port->intrinsicDelay(this));
+      float limit;
+      bool exists;
+      port->capacitanceLimit(max_, limit, exists);
+      gate.cap_limit.push_back(exists ? limit
+                                      : std::numeric_limits<float>::max());
+    }
+    for (const LibertyPort* port : inputs) {
+      gate.input_cap.push_back(port->capacitance());
+    }
+  }
+  if (gate.cells.size() < 2) {
+    return false;
+  }
+  gates_.push_back(std::move(gate));
+  return true;
+}
+
+// Link the outputs of sizable gates to the inputs they drive and take
+// the committed input capacitance of sizable loads out of the fixed load.
+void LagrangianSizer::connectGates()
+{
+  const int gate_count = gates_.size();
+  std::unordered_map<const Pin*, std::pair<int, int>> input_index;
+  for (int gate_index = 0; gate_index < gate_count; gate_index++) {
+    Gate& gate = gates_[gate_index];
+    int input = 0;
+    InstancePinIterator* pin_iter = network_->pinIterator(gate.inst);
+    while (pin_iter->hasNext()) {
+      const Pin* pin = pin_iter->next();
+      if (network_->libertyPort(pin) && !network_->isDriver(pin)
+          && network_->isLoad(pin)) {
+        input_index[pin] = {gate_index, input++};
+      }
+    }
+    delete pin_iter;
+  }
+
+  for (int gate_index = 0; gate_index < gate_count; gate_index++) {
+    Gate& gate = gates_[gate_index];
+    const int output_count = gate.outputs.size();
+    for (int output = 0; output < output_count; output++) {
+      Output& out = gate.outputs[output];
+      Net* net = network_->net(out.vertex->pin());
+      if (net == nullptr) {
+        continue;
+      }
+      NetConnectedPinIterator* pin_iter = network_->connectedPinIterator(net);
+      while (pin_iter->hasNext()) {
+        const Pin* pin = pin_iter->next();
+        auto load = input_index.find(pin);
+        if (load == input_index.end()) {
+          continue;
+        }
+        const auto [load_gate_index, load_input] = load->second;
+        Gate& load_gate = gates_[load_gate_index];
+        load_gate.inputs[load_input].drvr_gate = gate_index;
+        load_gate.inputs[load_input].drvr_output = output;
+        out.fixed_load
+            -= load_gate.input_cap[load_gate.committed * load_gate.inputs.size()
+                                   + load_input];
+        out.loads.emplace_back(load_gate_index, load_input);
+      }
+      delete pin_iter;
+      out.fixed_load = std::max(out.fixed_load, 0.0f);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
+Slack LagrangianSizer::gateSlack(const Gate& gate) const
+{
+  Slack slack = std::numeric_limits<float>::max();
+  for (const Output& output : gate.outputs) {
+    slack = std::min(slack, sta_->vertexSlack(output.vertex, max_));
+  }
+  return slack;
+}
+
+// Critical gates start with large multipliers and gates with a lot of
+// slack with small ones, so the first pass already trades area for delay
+// where it matters.
+void LagrangianSizer::initMultipliers()
+{
+  for (Gate& gate : gates_) {
+    const float criticality
+        = std::max(1.0f - gateSlack(gate) / delay_norm_, 0.0f);
+    gate.lambda = std::clamp(lambda_init_ * criticality * criticality,
+                             lambda_min_,
+                             lambda_max_);
+  }
+}
+
+// Subgradient style update: scale each multiplier up on negative slack
+// and down on positive slack, proportionally to the slack.
+void LagrangianSizer::updateMultipliers()
+{
+  for (Gate& gate : gates_) {
+    const float scale = 1.0 - step_ * gateSlack(gate) / delay_norm_;
+    gate.lambda = std::clamp(
+        gate.lambda
+            * std::clamp(scale, 1 / lambda_max_scale_, lambda_max_scale_),
+        lambda_min_,
+        lambda_max_);
+  }
+}
+
+// Size the gates level by level. Gates of a level only read the sizes
+// of other levels (fanins are lower, fanouts higher), so they are sized
+// in parallel and the new sizes are applied once the level is done.
+void LagrangianSizer::sweep(const int num_threads)
+{
+  vector<int> sizes(gates_.size());
+  const int level_count = level_starts_.size() - 1;
+  for (int level = 0; level < level_count; level++) {
+    const int begin = level_starts_[level];
+    const int end = level_starts_[level + 1];
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic, 16)
+    for (int i = begin; i < end; i++) {
+      sizes[i] = bestSize(gates_[i]);
+    }
+    for (int i = begin; i < end; i++) {
+      gates_[i].size = sizes[i];
+    }
+  }
+}
+
+// Lagrangian subproblem of one gate with its neighbours fixed.
+int LagrangianSizer::bestSize(const Gate& gate) const
+{
+  const int output_count = gate.outputs.size();
+  const int input_count = gate.inputs.size();
+  vector<float> loads(output_count);
+  for (int output = 0; output < output_count; output++) {
+    loads[output] = outputLoad(gate, output);
+  }
+
+  int best_size = gate.size;
+  float best_cost = std::numeric_limits<float>::max();
+  const int size_count = gate.cells.size();
+  for (int size = 0; size < size_count; size++) {
+    float delay = 0.0;
+    bool fits = true;
+    for (int output = 0; output < output_count; output++) {
+      const int index = size * output_count + output;
+      if (loads[output] > gate.cap_limit[index] && size != gate.committed) {
+        fits = false;
+        break;
+      }
+      delay += gate.intrinsic[index] + gate.drive_res[index] * loads[output];
+    }
+    if (!fits) {
+      continue;
+    }
+    float cost = area_weight_ * gate.area[size]
+                 + gate.lambda * delay / delay_norm_;
+    for (int input = 0; input < input_count; input++) {
+      const Input& in = gate.inputs[input];
+      float drive = in.fixed_drive;
+      float lambda = gate.lambda;
+      if (in.drvr_gate >= 0) {
+        const Gate& drvr = gates_[in.drvr_gate];
+        drive = drvr.drive_res[drvr.size * drvr.outputs.size()
+                               + in.drvr_output];
+        lambda = drvr.lambda;
+      }
+      cost += lambda * drive * gate.input_cap[size * input_count + input]
+              / delay_norm_;
+    }
+    if (cost < best_cost) {
+      best_cost = cost;
+      best_size = size;
+    }
+  }
+  return best_size;
+}
+
+float LagrangianSizer::outputLoad(const Gate& gate, const int output) const
+{
+  const Output& out = gate.outputs[output];
+  float load = out.fixed_load;
+  for (const auto& [load_gate_index, load_input] : out.loads) {
+    const Gate& load_gate = gates_[load_gate_index];
+    load += load_gate.input_cap[load_gate.size * load_gate.inputs.size()
+                                + load_input];
+  }
+  return load;
+}
+
+////////////////////////////////////////////////////////////////
+
+// Swap the cells of the gates whose size changed in a journal so the
+// whole pass can be undone.
+int LagrangianSizer::commitSizes()
+{
+  resizer_->journalBegin();
+  int resized = 0;
+  for (Gate& gate : gates_) {
+    if (gate.size != gate.committed) {
+      debugPrint(logger_,
+                 RSZ,
+                 "lr_sizer",
+                 3,
+                 "resize {} {} -> {}",
+                 network_->pathName(gate.inst),
+                 gate.cells[gate.committed]->name(),
+                 gate.cells[gate.size]->name());
+      if (resizer_->replaceCell(gate.inst, gate.cells[gate.size], true)) {
+        resized++;
+      } else {
+        gate.size = gate.committed;
+      }
+    }
+  }
+  if (resized == 0) {
+    resizer_->journalEnd();
+  }
+  return resized;
+}
+
+void LagrangianSizer::restoreSizes()
+{
+  int resize_count = 100;
+  int inserted_buffer_count = 100;
+  int cloned_gate_count = 100;
+  int swap_pin_count = 100;
+  int removed_buffer_count = 100;
+  resizer_->journalRestore(resize_count,
+                           inserted_buffer_count,
+                           cloned_gate_count,
+                           swap_pin_count,
+                           removed_buffer_count);
+  for (Gate& gate : gates_) {
+    gate.size = gate.committed;
+  }
+  resizer_->updateParasitics();
+  sta_->findRequireds();
+}
+
+// A pass is kept if it does not make the total negative slack worse and
+// either improves the worst slack or keeps it (area recovery).
+bool LagrangianSizer::acceptable(const Slack wns, const Slack tns) const
+{
+  if (resizer_->overMaxArea()) {
+    return false;
+  }
+  if (fuzzyLess(tns, best_tns_)) {
+    debugPrint(logger_,
+               RSZ,
+               "lr_sizer",
+               1,
+               "reject pass tns {} worse than {}",
+               delayAsString(tns, sta_, 3),
+               delayAsString(best_tns_, sta_, 3));
+    return false;
+  }
+  return fuzzyGreater(wns, best_wns_)
+         || !fuzzyLess(wns, std::min(best_wns_, Slack(0.0)));
+}
+
+void LagrangianSizer::printProgress(const int pass,
+                                    const int resized,
+                                    const bool accepted) const
+{
+  if (pass == 0) {
+    logger_->report("   Pass   |  Resized |   Area    |   WNS    |    TNS");
+    logger_->report("---------------------------------------------------");
+  }
+  Slack wns;
+  Vertex* worst_vertex;
+  sta_->worstSlack(max_, wns, worst_vertex);
+  const Slack tns = sta_->totalNegativeSlack(max_);
+  string pass_field = fmt::format("{}", pass);
+  if (pass < 0) {
+    pass_field = "final";
+  } else if (!accepted) {
+    pass_field += " undo";
+  }
+  logger_->report("{: >9s} | {: >8d} | {: >9s} | {: >8s} | {: >8s}",
+                  pass_field,
+                  pass < 0 ? resize_count_ : resized,
+                  fmt::format("{:.3g}", resizer_->computeDesignArea()),
+                  delayAsString(wns, sta_, 3),
+                  delayAsString(tns, sta_, 3));
+  if (pass < 0) {
+    logger_->report("---------------------------------------------------");
+  }
+}
+
+}  // namespace rsz
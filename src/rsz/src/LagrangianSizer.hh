@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#pragma once
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "db_sta/dbSta.hh"
+#include "sta/Graph.hh"
+#include "sta/MinMax.hh"
+#include "sta/StaState.hh"
+#include "utl/Logger.h"
+
+namespace rsz {
+
+class Resizer;
+
+using utl::Logger;
+
+using sta::DcalcAnalysisPt;
+using sta::Instance;
+using sta::LibertyCell;
+using sta::LibertyCellSeq;
+using sta::MinMax;
+using sta::Pin;
+using sta::Slack;
+using sta::Vertex;
+
+// Global gate sizing by Lagrangian relaxation.
+// Every sizable gate gets a multiplier that weights its delay against
+// its area. A pass sweeps the gates in topological order and picks for
+// each one the swappable cell minimizing
+//   area + lambda * (its delay + the delay it adds to its fanin drivers)
+// using a linear drive resistance model, with the gates of a level sized
+// in parallel. The pass is committed as one batch and checked with the
+// real timing; the multipliers are then rescaled by the gate slacks.
+class LagrangianSizer : public sta::dbStaState
+{
+ public:
+  LagrangianSizer(Resizer* resizer);
+  bool sizeGates(int max_passes, int num_threads, bool verbose);
+
+ private:
+  struct Output
+  {
+    Vertex* vertex;
+    // Wire and non-sizable pin capacitance on the net.
+    float fixed_load;
+    // Sizable loads as (gate index, input index).
+    std::vector<std::pair<int, int>> loads;
+  };
+
+  struct Input
+  {
+    // Sizable driver as (gate index, output index), or -1.
+    int drvr_gate = -1;
+    int drvr_output = 0;
+    // Drive resistance of a non-sizable driver.
+    float fixed_drive = 0.0;
+  };
+
+  struct Gate
+  {
+    Instance* inst;
+    LibertyCellSeq cells;
+    // Index into cells of the cell being evaluated and of the cell in
+    // the netlist.
+    int size = 0;
+    int committed = 0;
+    float lambda = 1.0;
+    std::vector<Output> outputs;
+    std::vector<Input> inputs;
+    // Cell data indexed by [cell * outputs.size() + output] and
+    // [cell * inputs.size() + input].
+    std::vector<float> drive_res;
+    std::vector<float> intrinsic;
+    std::vector<float> cap_limit;
+    std::vector<float> input_cap;
+    // Area of each cell relative to the original cell.
+    std::vector<float> area;
+  };
+
+  void init();
+  bool findDelayNorm();
+  void makeGates();
+  bool makeGate(Instance* inst, Vertex* drvr_vertex);
+  void connectGates();
+  Slack gateSlack(const Gate& gate) const;
+  void initMultipliers();
+  void updateMultipliers();
+  void sweep(int num_threads);
+  int bestSize(const Gate& gate) const;
+  float outputLoad(const Gate& gate, int output) const;
+  int commitSizes();
+  void restoreSizes();
+  bool acceptable(Slack wns, Slack tns) const;
+  void printProgress(int pass, int resized, bool accepted) const;
+
+  Logger* logger_ = nullptr;
+  Resizer* resizer_;
+  const DcalcAnalysisPt* dcalc_ap_ = nullptr;
+  const MinMax* max_ = MinMax::max();
+
+  std::vector<Gate> gates_;
+  std::map<const Instance*, int> gate_index_;
+  // Gates are ordered by level; level_starts_[i] is the first gate of
+  // the i'th level and the last entry is gates_.size().
+  std::vector<int> level_starts_;
+  // Largest required time, used to normalize delays and slacks.
+  float delay_norm_ = 0.0;
+  float step_ = 1.0;
+  int resize_count_ = 0;
+  Slack best_wns_ = 0.0;
+  Slack best_tns_ = 0.0;
+
+  // Weight of the relative cell area against the delay terms.
+  static constexpr float area_weight_ = 1.0;
+  // Multiplier for a gate with zero slack.
+  static constexpr float lambda_init_ = 20.0;
+  static constexpr float lambda_min_ = 1e-3;
+  static constexpr float lambda_max_ = 1e4;
+  // Multiplier change per pass is limited to this factor.
+  static constexpr float lambda_max_scale_ = 2.0;
+  // Step of the multiplier update is halved on each rejected pass and
+  // sizing stops when it falls below this.
+  static constexpr float step_min_ = 0.05;
+  // Gates with more slack than this are unconstrained and left alone.
+  static constexpr float slack_max_margin_ = 1e-4;
+};
+
+}  // namespace rsz
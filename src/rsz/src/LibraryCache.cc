@@ -0,0 +1,362 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#include "LibraryCache.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "db_sta/dbSta.hh"
+#include "rsz/Resizer.hh"
+#include "sta/Corner.hh"
+#include "sta/DcalcAnalysisPt.hh"
+#include "sta/Liberty.hh"
+#include "sta/MinMax.hh"
+#include "sta/Network.hh"
+#include "utl/Logger.h"
+
+namespace rsz {
+
+using std::string;
+using std::vector;
+
+using utl::RSZ;
+
+using sta::Corner;
+using sta::DcalcAnalysisPt;
+using sta::LibertyCell;
+using sta::LibertyLibrary;
+using sta::LibertyLibraryIterator;
+using sta::MinMax;
+using sta::MinMaxAll;
+using sta::Pvt;
+
+namespace {
+
+// 64 bit FNV-1a. The key has to be stable across sessions and builds,
+// which std::hash does not promise.
+constexpr uint64_t fnv_offset = 14695981039346656037ULL;
+constexpr uint64_t fnv_prime = 1099511628211ULL;
+
+void hashBytes(uint64_t& hash, const char* bytes, size_t size)
+{
+  for (size_t i = 0; i < size; i++) {
+    hash ^= static_cast<unsigned char>(bytes[i]);
+    hash *= fnv_prime;
+  }
+}
+
+void hashString(uint64_t& hash, const string& str)
+{
+  // Include the terminator so "ab" "c" and "a" "bc" differ.
+  hashBytes(hash, str.c_str(), str.size() + 1);
+}
+
+}  // namespace
+
+LibraryCache::LibraryCache(Resizer* resizer) : resizer_(resizer)
+{
+}
+
+void LibraryCache::setFilename(const std::string& filename)
+{
+  filename_ = filename;
+}
+
+uint64_t LibraryCache::fileHash(const char* filename)
+{
+  std::error_code error;
+  const std::filesystem::path path(filename);
+  FileHash stamp;
+  stamp.size = std::filesystem::file_size(path, error);
+  if (!error) {
+    stamp.mtime = std::filesystem::last_write_time(path, error)
+                      .time_since_epoch()
+                      .count();
+  }
+  if (error) {
+    // Missing files hash as empty, they cannot match a cache entry that
+    // was written with the file present.
+    return fnv_offset;
+  }
+
+  auto itr = file_hashes_.find(filename);
+  if (itr != file_hashes_.end() && itr->second.size == stamp.size
+      && itr->second.mtime == stamp.mtime) {
+    return itr->second.hash;
+  }
+  stamp.hash = fnv_offset;
+  std::ifstream stream(filename, std::ios::binary);
+  vector<char> buffer(1 << 20);
+  while (stream) {
+    stream.read(buffer.data(), buffer.size());
+    hashBytes(stamp.hash, buffer.data(), stream.gcount());
+  }
+  file_hashes_[filename] = stamp;
+  return stamp.hash;
+}
+
+uint64_t LibraryCache::findKey()
+{
+  sta::dbSta* sta = resizer_->sta_;
+  uint64_t key = fnv_offset;
+  hashString(key, std::to_string(version_));
+
+  std::map<const LibertyLibrary*, size_t> lib_indices;
+  for (LibertyLibrary* lib : libraries()) {
+    lib_indices.emplace(lib, lib_indices.size());
+    hashString(key, lib->name());
+    const char* lib_filename = lib->filename();
+    if (lib_filename) {
+      const uint64_t file_hash = fileHash(lib_filename);
+      hashBytes(
+          key, reinterpret_cast<const char*>(&file_hash), sizeof(file_hash));
+    }
+  }
+
+  // The libraries each corner uses and the operating conditions the
+  // target slews and loads are found at.
+  for (Corner* corner : *sta->corners()) {
+    hashString(key, corner->name());
+    for (const MinMax* min_max : MinMaxAll::all()->range()) {
+      for (const LibertyLibrary* lib : corner->libertyLibraries(min_max)) {
+        hashString(key, std::to_string(lib_indices.at(lib)));
+      }
+      const DcalcAnalysisPt* dcalc_ap = corner->findDcalcAnalysisPt(min_max);
+      const Pvt* pvt = dcalc_ap->operatingConditions();
+      hashString(key,
+                 pvt ? fmt::format("{:.9g} {:.9g} {:.9g}",
+                                   pvt->process(),
+                                   pvt->voltage(),
+                                   pvt->temperature())
+                     : "default");
+    }
+  }
+  for (LibertyCell* buffer : resizer_->buffer_cells_) {
+    hashString(key,
+               fmt::format("{}/{}",
+                           lib_indices.at(buffer->libertyLibrary()),
+                           buffer->name()));
+  }
+  std::set<string> dont_use;
+  for (LibertyCell* cell : resizer_->dont_use_) {
+    dont_use.insert(fmt::format(
+        "{}/{}", lib_indices.at(cell->libertyLibrary()), cell->name()));
+  }
+  for (const string& name : dont_use) {
+    hashString(key, name);
+  }
+  hashString(key, std::to_string(Resizer::tgt_slew_load_cap_factor));
+  return key;
+}
+
+vector<LibertyLibrary*> LibraryCache::libraries() const
+{
+  vector<LibertyLibrary*> libs;
+  LibertyLibraryIterator* lib_iter
+      = resizer_->network_->libertyLibraryIterator();
+  while (lib_iter->hasNext()) {
+    libs.push_back(lib_iter->next());
+  }
+  delete lib_iter;
+  return libs;
+}
+
+LibertyCell* LibraryCache::findCell(const vector<LibertyLibrary*>& libs,
+                                    const size_t lib_index,
+                                    const string& cell_name) const
+{
+  if (lib_index >= libs.size()) {
+    return nullptr;
+  }
+  return libs[lib_index]->findLibertyCell(cell_name.c_str());
+}
+
+// File format:
+//   rsz_library_cache <version>
+//   liberty_files <count>
+//   <size> <mtime> <hash> <filename> (count lines)
+//   key <key>
+//   target_slews <corner> <rise> <fall>
+//   fast_buffers <count>
+//   <lib index> <cell>               (count lines)
+//   target_loads <count>
+//   <lib index> <cell> <load>        (count lines)
+bool LibraryCache::read()
+{
+  logger_ = resizer_->logger_;
+  std::ifstream stream(filename_);
+  if (!stream) {
+    return false;
+  }
+
+  string tag;
+  int version;
+  stream >> tag >> version;
+  if (!stream || tag != "rsz_library_cache" || version != version_) {
+    debugPrint(logger_, RSZ, "library_cache", 1, "stale {}", filename_);
+    return false;
+  }
+
+  size_t count;
+  stream >> tag >> count;
+  if (!stream || tag != "liberty_files") {
+    return false;
+  }
+  for (size_t i = 0; i < count; i++) {
+    FileHash stamp;
+    string lib_filename;
+    stream >> stamp.size >> stamp.mtime >> std::hex >> stamp.hash >> std::dec;
+    stream.get();
+    std::getline(stream, lib_filename);
+    if (!stream) {
+      return false;
+    }
+    // fileHash only uses the stored hash if the file is unchanged.
+    file_hashes_.try_emplace(lib_filename, stamp);
+  }
+
+  uint64_t key;
+  stream >> tag >> std::hex >> key >> std::dec;
+  if (!stream || tag != "key" || key != findKey()) {
+    debugPrint(logger_, RSZ, "library_cache", 1, "stale {}", filename_);
+    return false;
+  }
+
+  string corner_name;
+  float slew_rise, slew_fall;
+  stream >> tag >> corner_name >> slew_rise >> slew_fall;
+  Corner* corner = resizer_->sta_->findCorner(corner_name.c_str());
+  if (!stream || tag != "target_slews" || corner == nullptr) {
+    return false;
+  }
+
+  const vector<LibertyLibrary*> libs = libraries();
+  stream >> tag >> count;
+  if (!stream || tag != "fast_buffers") {
+    return false;
+  }
+  std::set<LibertyCell*> fast_buffers;
+  for (size_t i = 0; i < count; i++) {
+    size_t lib_index;
+    string cell_name;
+    stream >> lib_index >> cell_name;
+    LibertyCell* buffer = findCell(libs, lib_index, cell_name);
+    if (!stream || buffer == nullptr) {
+      return false;
+    }
+    fast_buffers.insert(buffer);
+  }
+
+  stream >> tag >> count;
+  if (!stream || tag != "target_loads") {
+    return false;
+  }
+  auto target_load_map = std::make_unique<CellTargetLoadMap>();
+  for (size_t i = 0; i < count; i++) {
+    size_t lib_index;
+    string cell_name;
+    float target_load;
+    stream >> lib_index >> cell_name >> target_load;
+    LibertyCell* cell = findCell(libs, lib_index, cell_name);
+    if (!stream || cell == nullptr) {
+      return false;
+    }
+    (*target_load_map)[cell] = target_load;
+  }
+
+  resizer_->tgt_slews_[RiseFall::riseIndex()] = slew_rise;
+  resizer_->tgt_slews_[RiseFall::fallIndex()] = slew_fall;
+  resizer_->tgt_slew_corner_ = corner;
+  resizer_->tgt_slew_dcalc_ap_
+      = corner->findDcalcAnalysisPt(sta::MinMax::max());
+  delete resizer_->target_load_map_;
+  resizer_->target_load_map_ = target_load_map.release();
+  resizer_->buffer_fast_sizes_ = std::move(fast_buffers);
+
+  logger_->info(RSZ,
+                154,
+                "Read target loads for {} cells from {}.",
+                count,
+                filename_);
+  return true;
+}
+
+void LibraryCache::write()
+{
+  logger_ = resizer_->logger_;
+  std::ofstream stream(filename_);
+  if (!stream) {
+    logger_->warn(RSZ, 155, "Cannot write library cache {}.", filename_);
+    return;
+  }
+
+  const vector<LibertyLibrary*> libs = libraries();
+  std::map<const LibertyLibrary*, size_t> lib_indices;
+  for (const LibertyLibrary* lib : libs) {
+    lib_indices.emplace(lib, lib_indices.size());
+  }
+  auto cellName = [&lib_indices](const LibertyCell* cell) {
+    return fmt::format(
+        "{} {}", lib_indices.at(cell->libertyLibrary()), cell->name());
+  };
+
+  const uint64_t key = findKey();
+  stream << fmt::format("rsz_library_cache {}\n", version_);
+  std::set<string> lib_filenames;
+  for (const LibertyLibrary* lib : libs) {
+    if (lib->filename() && file_hashes_.count(lib->filename())) {
+      lib_filenames.insert(lib->filename());
+    }
+  }
+  stream << fmt::format("liberty_files {}\n", lib_filenames.size());
+  for (const string& lib_filename : lib_filenames) {
+    const FileHash& stamp = file_hashes_.at(lib_filename);
+    stream << fmt::format("{} {} {:x} {}\n",
+                          stamp.size,
+                          stamp.mtime,
+                          stamp.hash,
+                          lib_filename);
+  }
+  stream << fmt::format("key {:x}\n", key);
+  stream << fmt::format("target_slews {} {:.9g} {:.9g}\n",
+                        resizer_->tgt_slew_corner_->name(),
+                        resizer_->tgt_slews_[RiseFall::riseIndex()],
+                        resizer_->tgt_slews_[RiseFall::fallIndex()]);
+
+  // Sort by name so the file does not depend on pointer order.
+  vector<string> fast_buffers;
+  for (const LibertyCell* buffer : resizer_->buffer_fast_sizes_) {
+    fast_buffers.push_back(cellName(buffer));
+  }
+  std::sort(fast_buffers.begin(), fast_buffers.end());
+  stream << fmt::format("fast_buffers {}\n", fast_buffers.size());
+  for (const string& name : fast_buffers) {
+    stream << name << '\n';
+  }
+
+  vector<string> target_loads;
+  for (const auto& [cell, target_load] : *resizer_->target_load_map_) {
+    target_loads.push_back(
+        fmt::format("{} {:.9g}", cellName(cell), target_load));
+  }
+  std::sort(target_loads.begin(), target_loads.end());
+  stream << fmt::format("target_loads {}\n", target_loads.size());
+  for (const string& line : target_loads) {
+    stream << line << '\n';
+  }
+
+  if (!stream) {
+    logger_->warn(RSZ, 156, "Error writing library cache {}.", filename_);
+  }
+}
+
+}  // namespace rsz
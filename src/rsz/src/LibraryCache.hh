@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025, The OpenROAD Authors
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "sta/LibertyClass.hh"
+#include "utl/Logger.h"
+
+namespace rsz {
+
+class Resizer;
+
+using utl::Logger;
+
+// Persistent cache for the library tables the resizer builds before
+// every repair command: the buffer target slews, the cell target loads
+// and the gain buffering buffer sizes. The cache file holds one entry
+// keyed by a hash of the Liberty file contents, the corners with their
+// libraries and operating conditions, the buffer list and the dont-use
+// cells, so any library or setup change misses. Cells are stored by the
+// index of their library in read order, because libraries of different
+// corners may share a name. The Liberty file hashes are stored with the
+// file size and modification time so unchanged files are not hashed
+// again.
+class LibraryCache
+{
+ public:
+  explicit LibraryCache(Resizer* resizer);
+  // Empty filename disables the cache.
+  void setFilename(const std::string& filename);
+  bool enabled() const { return !filename_.empty(); }
+  // Fill the resizer tables from the cache file.
+  // Returns false if the file is missing, stale or unreadable.
+  bool read();
+  void write();
+
+ private:
+  // Liberty file content hash with the file state it was computed for.
+  struct FileHash
+  {
+    uintmax_t size = 0;
+    int64_t mtime = 0;
+    uint64_t hash = 0;
+  };
+
+  uint64_t findKey();
+  uint64_t fileHash(const char* filename);
+  std::vector<sta::LibertyLibrary*> libraries() const;
+  sta::LibertyCell* findCell(const std::vector<sta::LibertyLibrary*>& libs,
+                             size_t lib_index,
+                             const std::string& cell_name) const;
+
+  Resizer* resizer_;
+  Logger* logger_ = nullptr;
+  std::string filename_;
+  // Liberty file hashes from this session and from the cache file.
+  std::map<std::string, FileHash> file_hashes_;
+
+  static constexpr int version_ = 3;
+};
+
+}  // namespace rsz
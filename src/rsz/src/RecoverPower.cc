@@ -4,7 +4,10 @@
 #include "RecoverPower.hh"
 
 #include <algorithm>
+#include <optional>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "db_sta/dbNetwork.hh"
 #include "rsz/Resizer.hh"
@@ -21,6 +24,7 @@
 #include "sta/PathVertex.hh"
 #include "sta/PortDirection.hh"
 #include "sta/Sdc.hh"
+#include "sta/Search.hh"
 #include "sta/TimingArc.hh"
 #include "sta/Units.hh"
 #include "utl/Logger.h"
@@ -35,6 +39,7 @@ using utl::RSZ;
 
 using sta::Edge;
 using sta::PathExpanded;
+using sta::VertexInEdgeIterator;
 using sta::VertexOutEdgeIterator;
 
 RecoverPower::RecoverPower(Resizer* resizer)
@@ -58,29 +63,7 @@ bool RecoverPower::recoverPower(const float recover_power_percent, bool verbose)
   resize_count_ = 0;
   resizer_->buffer_moved_into_core_ = false;
 
-  // Sort failing endpoints by slack.
-  VertexSet* endpoints = sta_->endpoints();
-  VertexSeq ends_with_slack;
-  for (Vertex* end : *endpoints) {
-    const Slack end_slack = sta_->vertexSlack(end, max_);
-    if (end_slack > setup_slack_margin_
-        && end_slack < setup_slack_max_margin_) {
-      ends_with_slack.push_back(end);
-    }
-  }
-
-  sort(ends_with_slack, [=](Vertex* end1, Vertex* end2) {
-    return sta_->vertexSlack(end1, max_) > sta_->vertexSlack(end2, max_);
-  });
-
-  debugPrint(logger_,
-             RSZ,
-             "recover_power",
-             1,
-             "Candidate paths {}/{} {}%",
-             ends_with_slack.size(),
-             endpoints->size(),
-             int(ends_with_slack.size() / double(endpoints->size()) * 100));
+  VertexSeq ends_with_slack = findEndsWithSlack();
 
   int max_end_count = ends_with_slack.size() * recover_power_percent;
   // As long as we are here fix at least one path
@@ -132,12 +115,8 @@ bool RecoverPower::recoverPower(const float recover_power_percent, bool verbose)
 
       sta_->worstSlack(max_, worst_slack_after, worst_vertex);
 
-      const float worst_slack_percent = fabs(
-          (worst_slack_before - worst_slack_after) / worst_slack_before * 100);
       const bool better
-          = (worst_slack_percent < 0.0001
-             || (worst_slack_before > 0
-                 && worst_slack_after / worst_slack_before > 0.5));
+          = slackAcceptable(worst_slack_before, worst_slack_after);
 
       debugPrint(logger_,
                  RSZ,
@@ -220,6 +199,403 @@ bool RecoverPower::recoverPower(const float recover_power_percent, bool verbose)
   return recovered;
 }
 
+// Endpoints with positive slack sorted by decreasing slack.
+VertexSeq RecoverPower::findEndsWithSlack()
+{
+  VertexSet* endpoints = sta_->endpoints();
+  VertexSeq ends_with_slack;
+  for (Vertex* end : *endpoints) {
+    const Slack end_slack = sta_->vertexSlack(end, max_);
+    if (end_slack > setup_slack_margin_
+        && end_slack < setup_slack_max_margin_) {
+      ends_with_slack.push_back(end);
+    }
+  }
+
+  sort(ends_with_slack, [=](Vertex* end1, Vertex* end2) {
+    return sta_->vertexSlack(end1, max_) > sta_->vertexSlack(end2, max_);
+  });
+
+  debugPrint(logger_,
+             RSZ,
+             "recover_power",
+             1,
+             "Candidate paths {}/{} {}%",
+             ends_with_slack.size(),
+             endpoints->size(),
+             int(ends_with_slack.size() / double(endpoints->size()) * 100));
+  return ends_with_slack;
+}
+
+bool RecoverPower::slackAcceptable(const Slack worst_slack_before,
+                                   const Slack worst_slack_after)
+{
+  const float worst_slack_percent = fabs(
+      (worst_slack_before - worst_slack_after) / worst_slack_before * 100);
+  return worst_slack_percent < 0.0001
+         || (worst_slack_before > 0
+             && worst_slack_after / worst_slack_before > 0.5);
+}
+
+////////////////////////////////////////////////////////////////
+
+// Power recovery sweep.
+// Collect the drivers on the worst paths of the candidate endpoints,
+// evaluate the downsizes of all of them in parallel against the current
+// (frozen) timing, rank them by power saved per delay added and commit
+// the ones that do not change the delays of the same stages in batches.
+bool RecoverPower::recoverPowerSweep(const float recover_power_percent,
+                                     const int num_threads,
+                                     const bool verbose)
+{
+  init();
+  resize_count_ = 0;
+  resizer_->buffer_moved_into_core_ = false;
+
+  Slack worst_slack_before;
+  Vertex* worst_vertex;
+  sta_->worstSlack(max_, worst_slack_before, worst_vertex);
+
+  print_interval_ = 1;
+  printProgress(0, false, false);
+
+  int pass = 1;
+  for (; pass <= sweep_max_passes_; pass++) {
+    const VertexSeq ends_with_slack = findEndsWithSlack();
+    int max_end_count = ends_with_slack.size() * recover_power_percent;
+    max_end_count = std::max(max_end_count, 1);
+
+    std::vector<DownsizeCandidate> candidates;
+    findDownsizeCandidates(ends_with_slack, max_end_count, candidates);
+
+    const int candidate_count = candidates.size();
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+    for (int i = 0; i < candidate_count; i++) {
+      evaluateDownsize(candidates[i]);
+    }
+
+    std::vector<DownsizeCandidate*> ranked;
+    for (DownsizeCandidate& candidate : candidates) {
+      if (candidate.downsize) {
+        ranked.push_back(&candidate);
+      }
+    }
+    std::stable_sort(
+        ranked.begin(),
+        ranked.end(),
+        [](const DownsizeCandidate* cand1, const DownsizeCandidate* cand2) {
+          return cand1->score > cand2->score;
+        });
+
+    // Downsizes in a pass do not change the delays of the same stages, so
+    // the delay estimates of a batch do not stack up. Slack used by
+    // downsizes further apart on a path is checked by commitDownsizes.
+    sta::VertexSet region_used(graph_);
+    std::vector<DownsizeCandidate*> downsizes;
+    for (DownsizeCandidate* candidate : ranked) {
+      VertexSeq region;
+      if (findConflictRegion(candidate->drvr_vertex, region_used, region)) {
+        region_used.insert(region.begin(), region.end());
+        downsizes.push_back(candidate);
+      }
+    }
+
+    const int committed = commitDownsizes(downsizes, worst_slack_before);
+    debugPrint(logger_,
+               RSZ,
+               "recover_power",
+               1,
+               "sweep pass {} candidates {} downsizes {} committed {}",
+               pass,
+               candidates.size(),
+               downsizes.size(),
+               committed);
+    if (verbose || pass == 1) {
+      printProgress(pass, false, false);
+    }
+    if (committed == 0 || resizer_->overMaxArea()) {
+      break;
+    }
+  }
+
+  printProgress(pass, true, true);
+  bad_vertices_.clear();
+
+  if (resize_count_ > 0) {
+    logger_->info(RSZ, 152, "Resized {} instances.", resize_count_);
+  }
+  if (resizer_->overMaxArea()) {
+    logger_->error(RSZ, 153, "max utilization reached.");
+  }
+  return resize_count_ > 0;
+}
+
+void RecoverPower::findDownsizeCandidates(
+    const VertexSeq& ends,
+    const int max_end_count,
+    std::vector<DownsizeCandidate>& candidates)
+{
+  std::set<Instance*> candidate_insts;
+  for (int end_index = 0; end_index < max_end_count; end_index++) {
+    const PathRef end_path = sta_->vertexWorstSlackPath(ends[end_index], max_);
+    if (end_path.isNull()) {
+      continue;
+    }
+    PathExpanded expanded(&end_path, sta_);
+    const int path_length = expanded.size();
+    const DcalcAnalysisPt* dcalc_ap = end_path.dcalcAnalysisPt(sta_);
+    for (int i = std::max(expanded.startIndex(), 1); i < path_length; i++) {
+      const PathRef* drvr_path = expanded.path(i);
+      Vertex* drvr_vertex = drvr_path->vertex(sta_);
+      const Pin* drvr_pin = drvr_path->pin(sta_);
+      if (!network_->isDriver(drvr_pin) || network_->isTopLevelPort(drvr_pin)
+          || bad_vertices_.find(drvr_vertex) != bad_vertices_.end()) {
+        continue;
+      }
+      Instance* inst = network_->instance(drvr_pin);
+      if (candidate_insts.find(inst) != candidate_insts.end()) {
+        continue;
+      }
+      const LibertyPort* drvr_port = network_->libertyPort(drvr_pin);
+      const LibertyPort* in_port
+          = network_->libertyPort(expanded.path(i - 1)->pin(sta_));
+      if (!drvr_port || !in_port || resizer_->dontTouch(inst)) {
+        continue;
+      }
+      LibertyCell* cell = drvr_port->libertyCell();
+      LibertyCellSeq swappable_cells = resizer_->getSwappableCells(cell);
+      if (swappable_cells.empty()) {
+        continue;
+      }
+      float prev_drive = 0.0;
+      if (i >= 2) {
+        const LibertyPort* prev_drvr_port
+            = network_->libertyPort(expanded.path(i - 2)->pin(sta_));
+        if (prev_drvr_port) {
+          prev_drive = prev_drvr_port->driveResistance();
+        }
+      }
+
+      DownsizeCandidate candidate;
+      candidate.inst = inst;
+      candidate.drvr_vertex = drvr_vertex;
+      candidate.in_port = in_port;
+      candidate.drvr_port = drvr_port;
+      candidate.lib_ap = dcalc_ap->libertyIndex();
+      candidate.load_cap = graph_delay_calc_->loadCap(drvr_pin, dcalc_ap);
+      candidate.prev_drive = prev_drive;
+      candidate.slack = sta_->vertexSlack(drvr_vertex, max_);
+      // Leakage lookups fill a cache so they are done before going parallel.
+      const std::optional<float> leakage = resizer_->cellLeakage(cell);
+      candidate.cost = leakage ? *leakage : cell->area();
+      for (LibertyCell* swappable : swappable_cells) {
+        const std::optional<float> swappable_leakage
+            = resizer_->cellLeakage(swappable);
+        if (leakage.has_value() != swappable_leakage.has_value()) {
+          // Costs are not comparable.
+          candidate.swappable_costs.push_back(candidate.cost);
+        } else {
+          candidate.swappable_costs.push_back(
+              swappable_leakage ? *swappable_leakage : swappable->area());
+        }
+      }
+      candidate.swappable_cells = std::move(swappable_cells);
+      candidate_insts.insert(inst);
+      candidates.push_back(std::move(candidate));
+    }
+  }
+}
+
+// Collect the vertices within sweep_conflict_fanout_edges_ after drvr and
+// sweep_conflict_fanin_edges_ before it. A downsize changes the delay of
+// its own stage, the input slew of the stages it drives and the load of
+// the stage driving it. Returns false if the region reaches a vertex in
+// used.
+bool RecoverPower::findConflictRegion(Vertex* drvr,
+                                      const sta::VertexSet& used,
+                                      // Return value.
+                                      VertexSeq& region)
+{
+  sta::SearchPredNonLatch2 pred(sta_);
+  sta::VertexSet visited(graph_);
+  // Vertices and their edge distance from drvr.
+  std::vector<std::pair<Vertex*, int>> stack;
+  visited.insert(drvr);
+  region.push_back(drvr);
+  if (used.find(drvr) != used.end()) {
+    return false;
+  }
+
+  stack.emplace_back(drvr, 0);
+  while (!stack.empty()) {
+    const auto [vertex, dist] = stack.back();
+    stack.pop_back();
+    if (dist == sweep_conflict_fanout_edges_) {
+      continue;
+    }
+    VertexOutEdgeIterator edge_iter(vertex, graph_);
+    while (edge_iter.hasNext()) {
+      Edge* edge = edge_iter.next();
+      Vertex* fanout = edge->to(graph_);
+      if (pred.searchThru(edge) && pred.searchTo(fanout)
+          && visited.find(fanout) == visited.end()) {
+        if (used.find(fanout) != used.end()) {
+          return false;
+        }
+        visited.insert(fanout);
+        region.push_back(fanout);
+        stack.emplace_back(fanout, dist + 1);
+      }
+    }
+  }
+
+  stack.emplace_back(drvr, 0);
+  while (!stack.empty()) {
+    const auto [vertex, dist] = stack.back();
+    stack.pop_back();
+    if (dist == sweep_conflict_fanin_edges_) {
+      continue;
+    }
+    VertexInEdgeIterator edge_iter(vertex, graph_);
+    while (edge_iter.hasNext()) {
+      Edge* edge = edge_iter.next();
+      Vertex* fanin = edge->from(graph_);
+      if (pred.searchThru(edge) && pred.searchFrom(fanin)
+          && visited.find(fanin) == visited.end()) {
+        if (used.find(fanin) != used.end()) {
+          return false;
+        }
+        visited.insert(fanin);
+        region.push_back(fanin);
+        stack.emplace_back(fanin, dist + 1);
+      }
+    }
+  }
+  return true;
+}
+
+// Pick the swappable cell that saves the most power per delay added
+// within the slack of the driver. Only reads Liberty data so it is safe
+// to call from multiple threads.
+void RecoverPower::evaluateDownsize(DownsizeCandidate& candidate)
+{
+  constexpr double delay_margin = 1.5;  // Prevent overly aggressive downsizing
+  const LibertyCell* cell = candidate.drvr_port->libertyCell();
+  const LibertyPort* drvr_port
+      = candidate.drvr_port->cornerPort(candidate.lib_ap);
+  const LibertyPort* in_port = candidate.in_port->cornerPort(candidate.lib_ap);
+  const float drive = drvr_port->driveResistance();
+  const float delay = estimateDelay(
+      drvr_port, in_port, candidate.load_cap, candidate.prev_drive);
+
+  for (size_t i = 0; i < candidate.swappable_cells.size(); i++) {
+    LibertyCell* swappable = candidate.swappable_cells[i];
+    const float saving = candidate.cost - candidate.swappable_costs[i];
+    if (swappable == cell || saving <= 0.0
+        || !meetsSizeCriteria(cell, swappable, true)) {
+      continue;
+    }
+    const LibertyCell* swappable_corner
+        = swappable->cornerCell(candidate.lib_ap);
+    const LibertyPort* swappable_drvr
+        = swappable_corner->findLibertyPort(candidate.drvr_port->name());
+    const LibertyPort* swappable_input
+        = swappable_corner->findLibertyPort(candidate.in_port->name());
+    if (!swappable_drvr || !swappable_input
+        || swappable_drvr->driveResistance() <= drive) {
+      continue;
+    }
+    const float delay_increase = estimateDelay(swappable_drvr,
+                                               swappable_input,
+                                               candidate.load_cap,
+                                               candidate.prev_drive)
+                                 - delay;
+    if (delay_increase * delay_margin >= candidate.slack) {
+      continue;
+    }
+    const float score
+        = saving / std::max(delay_increase, sweep_min_delay_increase_);
+    if (score > candidate.score) {
+      candidate.downsize = swappable;
+      candidate.score = score;
+    }
+  }
+}
+
+// Linear delay model of the driver and of the load its input puts on the
+// previous stage.
+float RecoverPower::estimateDelay(const LibertyPort* drvr_port,
+                                  const LibertyPort* in_port,
+                                  const float load_cap,
+                                  const float prev_drive)
+{
+  return drvr_port->intrinsicDelay(this)
+         + drvr_port->driveResistance() * load_cap
+         + prev_drive * in_port->capacitance();
+}
+
+// Commit downsizes in batches with one timing update per batch. A batch
+// that degrades the worst slack too much is undone and split in half;
+// single downsizes that fail are remembered and not tried again.
+int RecoverPower::commitDownsizes(std::vector<DownsizeCandidate*>& downsizes,
+                                  const Slack worst_slack_before)
+{
+  int committed = 0;
+  size_t batch_size = downsizes.size();
+  size_t next = 0;
+  while (next < downsizes.size()) {
+    const size_t batch_end = std::min(next + batch_size, downsizes.size());
+    resizer_->journalBegin();
+    const int resize_count_before = resize_count_;
+    for (size_t i = next; i < batch_end; i++) {
+      DownsizeCandidate* candidate = downsizes[i];
+      debugPrint(logger_,
+                 RSZ,
+                 "recover_power",
+                 3,
+                 "resize {} {} -> {}",
+                 network_->pathName(candidate->inst),
+                 candidate->drvr_port->libertyCell()->name(),
+                 candidate->downsize->name());
+      if (resizer_->replaceCell(candidate->inst, candidate->downsize, true)) {
+        resize_count_++;
+      }
+    }
+    resizer_->updateParasitics(true);
+    sta_->findRequireds();
+    Slack worst_slack_after;
+    Vertex* worst_vertex;
+    sta_->worstSlack(max_, worst_slack_after, worst_vertex);
+
+    if (slackAcceptable(worst_slack_before, worst_slack_after)) {
+      resizer_->journalEnd();
+      committed += resize_count_ - resize_count_before;
+      next = batch_end;
+    } else {
+      // The sweep only resizes.
+      int inserted_buffer_count = 0;
+      int cloned_gate_count = 0;
+      int swap_pin_count = 0;
+      int removed_buffer_count = 0;
+      resizer_->journalRestore(resize_count_,
+                               inserted_buffer_count,
+                               cloned_gate_count,
+                               swap_pin_count,
+                               removed_buffer_count);
+      if (batch_size == 1) {
+        bad_vertices_.insert(downsizes[next]->drvr_vertex);
+        next++;
+      } else {
+        batch_size = (batch_size + 1) / 2;
+      }
+    }
+    if (resizer_->overMaxArea()) {
+      break;
+    }
+  }
+  return committed;
+}
+
 // For testing.
 Vertex* RecoverPower::recoverPower(const Pin* end_pin)
 {
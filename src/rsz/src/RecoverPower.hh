@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "db_sta/dbSta.hh"
 #include "sta/FuncExpr.hh"
 #include "sta/Graph.hh"
@@ -24,7 +26,9 @@ using sta::Corner;
 using sta::dbNetwork;
 using sta::dbSta;
 using sta::DcalcAnalysisPt;
+using sta::Instance;
 using sta::LibertyCell;
+using sta::LibertyCellSeq;
 using sta::LibertyPort;
 using sta::MinMax;
 using sta::Net;
@@ -35,6 +39,7 @@ using sta::Slack;
 using sta::StaState;
 using sta::TimingArc;
 using sta::Vertex;
+using sta::VertexSeq;
 
 class BufferedNet;
 enum class BufferedNetType;
@@ -46,11 +51,51 @@ class RecoverPower : public sta::dbStaState
  public:
   RecoverPower(Resizer* resizer);
   bool recoverPower(float recover_power_percent, bool verbose);
+  // Rank the downsizes for all candidate paths and commit them in batches.
+  bool recoverPowerSweep(float recover_power_percent,
+                         int num_threads,
+                         bool verbose);
   // For testing.
   Vertex* recoverPower(const Pin* end_pin);
 
  private:
+  // Driver on a path with slack that may be downsized by the sweep.
+  struct DownsizeCandidate
+  {
+    Instance* inst;
+    Vertex* drvr_vertex;
+    const LibertyPort* in_port;
+    const LibertyPort* drvr_port;
+    int lib_ap;
+    float load_cap;
+    float prev_drive;
+    Slack slack;
+    LibertyCellSeq swappable_cells;
+    // Leakage or area of the cell and of each swappable cell.
+    float cost;
+    std::vector<float> swappable_costs;
+    // Result of the evaluation.
+    LibertyCell* downsize = nullptr;
+    float score = 0.0;
+  };
+
   void init();
+  VertexSeq findEndsWithSlack();
+  void findDownsizeCandidates(const VertexSeq& ends,
+                              int max_end_count,
+                              std::vector<DownsizeCandidate>& candidates);
+  bool findConflictRegion(Vertex* drvr,
+                          const sta::VertexSet& used,
+                          // Return value.
+                          VertexSeq& region);
+  void evaluateDownsize(DownsizeCandidate& candidate);
+  float estimateDelay(const LibertyPort* drvr_port,
+                      const LibertyPort* in_port,
+                      float load_cap,
+                      float prev_drive);
+  int commitDownsizes(std::vector<DownsizeCandidate*>& downsizes,
+                      Slack worst_slack_before);
+  bool slackAcceptable(Slack worst_slack_before, Slack worst_slack_after);
   Vertex* recoverPower(const PathRef& path, Slack path_slack);
   bool meetsSizeCriteria(const LibertyCell* cell,
                          const LibertyCell* candidate,
@@ -103,6 +148,15 @@ class RecoverPower : public sta::dbStaState
   double initial_design_area_ = 0;
   int print_interval_ = 0;
 
+  // Rounds of ranking and committing downsizes in the sweep.
+  static constexpr int sweep_max_passes_ = 10;
+  // Graph edges around a downsized driver whose delays it changes, up to
+  // the drivers of the next and previous stages.
+  static constexpr int sweep_conflict_fanout_edges_ = 2;
+  static constexpr int sweep_conflict_fanin_edges_ = 2;
+  // Delay increases below this are treated as free when ranking downsizes.
+  static constexpr float sweep_min_delay_increase_ = 1e-13;
+
   static constexpr int decreasing_slack_max_passes_ = 50;
   static constexpr int rebuffer_max_fanout_ = 20;
   static constexpr int split_load_min_fanout_ = 8;
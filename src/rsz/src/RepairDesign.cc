@@ -6,11 +6,13 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <optional>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -23,6 +25,7 @@
 #include "sta/Graph.hh"
 #include "sta/GraphDelayCalc.hh"
 #include "sta/Liberty.hh"
+#include "sta/Parasitics.hh"
 #include "sta/PathExpanded.hh"
 #include "sta/PathRef.hh"
 #include "sta/PathVertex.hh"
@@ -77,9 +80,11 @@ void RepairDesign::repairDesign(double max_wire_length,
                                 double slew_margin,
                                 double cap_margin,
                                 double buffer_gain,
+                                bool pre_screen,
                                 bool verbose)
 {
   init();
+  utl::SetAndRestore set_pre_screen(pre_screen_, pre_screen);
   int repaired_net_count, slew_violations, cap_violations;
   int fanout_violations, length_violations;
   repairDesign(max_wire_length,
@@ -223,6 +228,13 @@ void RepairDesign::repairDesign(
   }
   printProgress(print_iteration, false, false, repaired_net_count);
   int max_length = resizer_->metersToDbu(max_wire_length);
+  std::vector<char> needs_repair;
+  std::unordered_set<const Net*> dirty_nets;
+  // Gain buffering edits clean nets too, so there is nothing to skip.
+  const bool pre_screen = pre_screen_ && buffer_gain_ == 0.0;
+  if (pre_screen) {
+    findRepairCandidates(max_length, verbose, needs_repair);
+  }
   for (int i = resizer_->level_drvr_vertices_.size() - 1; i >= 0; i--) {
     print_iteration++;
     if (verbose || (print_iteration == 1)) {
@@ -249,19 +261,29 @@ void RepairDesign::repairDesign(
         && !sta_->isClock(drvr_pin)
         // Exclude tie hi/low cells and supply nets.
         && !drvr->isConstant()) {
-      repairNet(net,
-                drvr_pin,
-                drvr,
-                true,
-                true,
-                true,
-                max_length,
-                true,
-                repaired_net_count,
-                slew_violations,
-                cap_violations,
-                fanout_violations,
-                length_violations);
+      const int edit_count = resize_count_ + inserted_buffer_count_;
+      // Nets that passed the screen are clean unless a repair downstream
+      // resized one of their loads.
+      const bool screened_clean
+          = pre_screen && !needs_repair[i] && !dirty_nets.count(net);
+      if (!screened_clean || resizeScreenedDriver(drvr_pin, net)) {
+        repairNet(net,
+                  drvr_pin,
+                  drvr,
+                  true,
+                  true,
+                  true,
+                  max_length,
+                  true,
+                  repaired_net_count,
+                  slew_violations,
+                  cap_violations,
+                  fanout_violations,
+                  length_violations);
+      }
+      if (pre_screen && resize_count_ + inserted_buffer_count_ != edit_count) {
+        markFaninNetsDirty(drvr_pin, dirty_nets);
+      }
     }
     if (debug) {
       logger_->setDebugLevel(RSZ, "repair_net", 0);
@@ -1036,6 +1058,141 @@ bool RepairDesign::needRepairWire(const int max_length,
   return false;
 }
 
+// Screen all driver vertices for max slew/cap/fanout/wire length
+// violations before the repair loop.
+void RepairDesign::findRepairCandidates(int max_length,
+                                        bool verbose,
+                                        std::vector<char>& needs_repair)
+{
+  const VertexSeq& drvrs = resizer_->level_drvr_vertices_;
+  const int drvr_count = drvrs.size();
+  needs_repair.assign(drvr_count, 1);
+  const Corner* corner = sta_->corners()->findCorner(0);
+  const ParasiticAnalysisPt* parasitic_ap
+      = corner->findParasiticAnalysisPt(max_);
+
+  for (int i = 0; i < drvr_count; i++) {
+    bool check_length = false;
+    needs_repair[i] = needsRepair(drvrs[i], parasitic_ap, check_length);
+    if (!needs_repair[i] && check_length && max_length) {
+      const Pin* drvr_pin = drvrs[i]->pin();
+      const Point drvr_loc = db_network_->location(drvr_pin);
+      int64_t length = 0;
+      for (const Pin* load_pin : findLoads(drvr_pin)) {
+        length += Point::manhattanDistance(db_network_->location(load_pin),
+                                           drvr_loc);
+      }
+      // The Steiner tree is never longer than the star from the driver
+      // to every load, and neither is any driver to load path on it.
+      if (length > max_length) {
+        needs_repair[i] = 1;
+      }
+    }
+  }
+
+  if (verbose) {
+    const int candidate_count
+        = std::count(needs_repair.begin(), needs_repair.end(), 1);
+    logger_->info(RSZ,
+                  151,
+                  "Pre-screened {} drivers, {} need repair.",
+                  drvr_count,
+                  candidate_count);
+  }
+}
+
+// Conservative check used by the pre-screen. Returning true only means
+// the repair loop has to look at the net. check_length is set when the
+// caller still has to bound the wire length.
+bool RepairDesign::needsRepair(Vertex* drvr,
+                               const ParasiticAnalysisPt* parasitic_ap,
+                               // Return value.
+                               bool& check_length)
+{
+  check_length = false;
+  const Pin* drvr_pin = drvr->pin();
+  // clang-format off
+  const Net* net = network_->isTopLevelPort(drvr_pin)
+                       ? db_network_->dbToSta(
+                           db_network_->flatNet(network_->term(drvr_pin)))
+                       : db_network_->dbToSta(db_network_->flatNet(drvr_pin));
+  // clang-format on
+  if (!net) {
+    return false;
+  }
+
+  // Estimated parasitics are made lazily by the repair loop.
+  if ((parasitics_src_ == ParasiticsSrc::placement
+       || parasitics_src_ == ParasiticsSrc::global_routing)
+      && (resizer_->parasitics_invalid_.hasKey(net)
+          || parasitics_->findPiElmore(drvr_pin, RiseFall::rise(), parasitic_ap)
+                 == nullptr)) {
+    return true;
+  }
+
+  float fanout, max_fanout, fanout_slack;
+  sta_->checkFanout(drvr_pin, max_, fanout, max_fanout, fanout_slack);
+  if (max_fanout > 0.0 && fanout_slack < 0.0) {
+    return true;
+  }
+
+  Slew slew;
+  float limit, slack;
+  const Corner* corner;
+  checkSlew(drvr_pin, slew, limit, slack, corner);
+  if (slack < 0.0f) {
+    return true;
+  }
+
+  if (!resizer_->isTristateDriver(drvr_pin)) {
+    resizer_->checkLoadSlews(
+        drvr_pin, slew_margin_, slew, limit, slack, corner);
+    if (slack < 0.0f) {
+      return true;
+    }
+    int cap_violations = 0;
+    float max_cap = INF;
+    if (needRepairCap(drvr_pin, cap_violations, max_cap, corner)) {
+      return true;
+    }
+    check_length = true;
+  }
+  return false;
+}
+
+// A net that passed the screen still gets the resize repairNet starts
+// with to normalize slews. Returns true if that changed the driver, in
+// which case the net has to be repaired as usual.
+bool RepairDesign::resizeScreenedDriver(const Pin* drvr_pin, Net* net)
+{
+  if (db_network_->isSpecial(net)
+      || parasitics_src_ != ParasiticsSrc::placement) {
+    return false;
+  }
+  const int resized = resizer_->resizeToCapRatio(drvr_pin, false);
+  resize_count_ += resized;
+  return resized > 0;
+}
+
+// Resizing the driver changes the load on the nets driving its inputs.
+void RepairDesign::markFaninNetsDirty(
+    const Pin* drvr_pin,
+    std::unordered_set<const Net*>& dirty_nets)
+{
+  const Instance* inst = network_->instance(drvr_pin);
+  InstancePinIterator* pin_iter = network_->pinIterator(inst);
+  while (pin_iter->hasNext()) {
+    const Pin* pin = pin_iter->next();
+    if (network_->direction(pin)->isAnyInput()) {
+      dbNet* db_net = db_network_->flatNet(pin);
+      if (db_net) {
+        dirty_nets.insert(db_network_->dbToSta(db_net));
+      }
+    }
+  }
+  delete pin_iter;
+}
+
 void RepairDesign::checkSlew(const Pin* drvr_pin,
                              // Return values.
                              Slew& slew,
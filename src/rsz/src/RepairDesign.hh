@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <unordered_set>
+#include <vector>
+
 #include "BufferedNet.hh"
 #include "PreChecks.hh"
 #include "db_sta/dbSta.hh"
@@ -55,6 +58,7 @@ class RepairDesign : dbStaState
                     double slew_margin,
                     double cap_margin,
                     double buffer_gain,
+                    bool pre_screen,
                     bool verbose);
   void repairDesign(double max_wire_length,  // zero for none (meters)
                     double slew_margin,
@@ -118,6 +122,16 @@ class RepairDesign : dbStaState
                      float& max_cap,
                      const Corner*& corner);
   bool needRepairWire(int max_length, int wire_length, int& length_violations);
+  void findRepairCandidates(int max_length,
+                            bool verbose,
+                            std::vector<char>& needs_repair);
+  bool needsRepair(Vertex* drvr,
+                   const ParasiticAnalysisPt* parasitic_ap,
+                   // Return value.
+                   bool& check_length);
+  bool resizeScreenedDriver(const Pin* drvr_pin, Net* net);
+  void markFaninNetsDirty(const Pin* drvr_pin,
+                          std::unordered_set<const Net*>& dirty_nets);
   void checkSlew(const Pin* drvr_pin,
                  // Return values.
                  Slew& slew,
@@ -237,6 +251,10 @@ class RepairDesign : dbStaState
   double buffer_gain_ = 0;
   const Corner* corner_ = nullptr;
 
+  // Screen drivers for violations and only repair the nets that fail
+  // the screen.
+  bool pre_screen_ = false;
+
   int resize_count_ = 0;
   int inserted_buffer_count_ = 0;
   const MinMax* min_ = MinMax::min();
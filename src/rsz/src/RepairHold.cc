@@ -4,6 +4,7 @@
 #include "RepairHold.hh"
 
 #include <algorithm>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -27,6 +28,7 @@
 #include "sta/TimingArc.hh"
 #include "sta/Units.hh"
 #include "utl/Logger.h"
+#include "utl/scope.h"
 
 namespace rsz {
 
@@ -40,7 +42,6 @@ using utl::RSZ;
 using sta::Edge;
 using sta::fuzzyLess;
 using sta::INF;
-using sta::PathExpanded;
 using sta::Port;
 using sta::VertexOutEdgeIterator;
 
@@ -63,10 +64,12 @@ bool RepairHold::repairHold(
     // Max buffer count as percent of design instance count.
     const float max_buffer_percent,
     const int max_passes,
+    const bool batch,
     const bool verbose)
 {
   bool repaired = false;
   init();
+  utl::SetAndRestore set_batch(batch_, batch);
   sta_->checkSlewLimitPreamble();
   sta_->checkCapacitanceLimitPreamble();
   LibertyCell* buffer_cell = findHoldBuffer();
@@ -250,14 +253,24 @@ bool RepairHold::repairHold(VertexSeq& ends,
                  delayAsString(worst_slack, sta_, 3),
                  delayAsString(sta_->worstSlack(max_), sta_, 3));
       int hold_buffer_count_before = inserted_buffer_count_;
-      repairHoldPass(hold_failures,
-                     buffer_cell,
-                     setup_margin,
-                     hold_margin,
-                     allow_setup_violations,
-                     max_buffer_count,
-                     verbose,
-                     pass);
+      if (batch_
+          && repairHoldBatch(hold_failures,
+                             buffer_cell,
+                             setup_margin,
+                             hold_margin,
+                             allow_setup_violations,
+                             max_buffer_count)) {
+        pass++;
+      } else {
+        repairHoldPass(hold_failures,
+                       buffer_cell,
+                       setup_margin,
+                       hold_margin,
+                       allow_setup_violations,
+                       max_buffer_count,
+                       verbose,
+                       pass);
+      }
       debugPrint(logger_,
                  RSZ,
                  "repair_hold",
@@ -356,6 +369,180 @@ void RepairHold::repairHoldPass(VertexSeq& hold_failures,
   }
 }
 
+// Insert hold buffers for all failing endpoints against the same timing
+// state. Endpoints whose worst hold paths go through the same driver share
+// one buffer that drives the union of the failing loads. The buffers are
+// inserted by insertHoldSites, which keeps the parts of the batch that fit.
+bool RepairHold::repairHoldBatch(VertexSeq& hold_failures,
+                                 LibertyCell* buffer_cell,
+                                 const double setup_margin,
+                                 const double hold_margin,
+                                 const bool allow_setup_violations,
+                                 const int max_buffer_count)
+{
+  std::vector<HoldBufferSite> sites;
+  std::map<Vertex*, size_t> drvr_sites;
+
+  resizer_->updateParasitics();
+  sort(hold_failures, [=](Vertex* end1, Vertex* end2) {
+    return sta_->vertexSlack(end1, min_) < sta_->vertexSlack(end2, min_);
+  });
+  const int max_site_count = max_buffer_count - inserted_buffer_count_;
+  for (Vertex* end_vertex : hold_failures) {
+    if (static_cast<int>(sites.size()) >= max_site_count) {
+      break;
+    }
+    PathRef end_path = sta_->vertexWorstSlackPath(end_vertex, min_);
+    if (end_path.isNull()) {
+      continue;
+    }
+    PathExpanded expanded(&end_path, sta_);
+    const int path_length = expanded.size();
+    for (int i = expanded.startIndex(); i < path_length - 1; i++) {
+      Vertex* path_vertex = expanded.path(i)->vertex(sta_);
+      PinSeq load_pins;
+      Slacks slacks;
+      float excluded_cap;
+      bool loads_have_out_port;
+      if (!findHoldLoads(path_vertex,
+                         hold_margin,
+                         load_pins,
+                         slacks,
+                         excluded_cap,
+                         loads_have_out_port)
+          || !holdBufferFits(end_vertex,
+                             buffer_cell,
+                             slacks,
+                             excluded_cap,
+                             setup_margin,
+                             hold_margin,
+                             allow_setup_violations)) {
+        continue;
+      }
+      auto drvr_site = drvr_sites.find(path_vertex);
+      if (drvr_site == drvr_sites.end()) {
+        drvr_sites[path_vertex] = sites.size();
+        sites.push_back({path_vertex,
+                         load_pins,
+                         loads_have_out_port,
+                         holdBufferLoc(expanded, i)});
+      } else {
+        // Share the buffer already planned for this driver.
+        HoldBufferSite& site = sites[drvr_site->second];
+        for (const Pin* load_pin : load_pins) {
+          if (std::find(site.load_pins.begin(), site.load_pins.end(), load_pin)
+              == site.load_pins.end()) {
+            site.load_pins.push_back(load_pin);
+          }
+        }
+        site.loads_have_out_port |= loads_have_out_port;
+      }
+      // One buffer per endpoint and batch.
+      break;
+    }
+  }
+  if (sites.empty()) {
+    return false;
+  }
+
+  const int committed = insertHoldSites(sites,
+                                        0,
+                                        sites.size(),
+                                        buffer_cell,
+                                        setup_margin,
+                                        allow_setup_violations);
+  debugPrint(logger_,
+             RSZ,
+             "repair_hold",
+             1,
+             "batch of {} hold buffers, {} committed",
+             sites.size(),
+             committed);
+  return committed > 0;
+}
+
+// Insert the hold buffers of sites[begin, end) in one journal and update
+// timing once. If they cost more setup slack than allowed or slow down a
+// driver slew by more than 20%, they are backed out and each half is tried
+// on its own, so one bad site does not cost the rest of the batch.
+// Returns the number of sites kept.
+int RepairHold::insertHoldSites(std::vector<HoldBufferSite>& sites,
+                                const size_t begin,
+                                const size_t end,
+                                LibertyCell* buffer_cell,
+                                const double setup_margin,
+                                const bool allow_setup_violations)
+{
+  resizer_->incrementalParasiticsEnd();
+  resizer_->journalBegin();
+  const Slack setup_slack_before = sta_->worstSlack(max_);
+  std::vector<Slew> slews_before;
+  slews_before.reserve(end - begin);
+  for (size_t i = begin; i < end; i++) {
+    slews_before.push_back(sta_->vertexSlew(sites[i].drvr, max_));
+  }
+  for (size_t i = begin; i < end; i++) {
+    HoldBufferSite& site = sites[i];
+    makeHoldDelay(site.drvr,
+                  site.load_pins,
+                  site.loads_have_out_port,
+                  buffer_cell,
+                  site.loc);
+  }
+  const Slack setup_slack_after = sta_->worstSlack(max_);
+  // Same driver slew limit as repairEndHold, for every buffered driver.
+  bool slew_ok = true;
+  for (size_t i = begin; i < end && slew_ok; i++) {
+    const Slew slew_after = sta_->vertexSlew(sites[i].drvr, max_);
+    const Slew slew_before = slews_before[i - begin];
+    const float slew_factor
+        = (slew_before > 0) ? slew_after / slew_before : 1.0;
+    slew_ok = slew_factor <= 1.20;
+  }
+  const bool committed
+      = slew_ok
+        && (allow_setup_violations
+            || !(fuzzyLess(setup_slack_after, setup_slack_before)
+                 && setup_slack_after < setup_margin));
+  if (committed) {
+    resizer_->journalEnd();
+  } else {
+    resizer_->journalRestore(resize_count_,
+                             inserted_buffer_count_,
+                             cloned_gate_count_,
+                             swap_pin_count_,
+                             removed_buffer_count_);
+  }
+  resizer_->incrementalParasiticsBegin();
+  debugPrint(logger_,
+             RSZ,
+             "repair_hold",
+             2,
+             "hold buffers {}-{} {}",
+             begin,
+             end,
+             committed ? "committed" : "restored");
+  if (committed) {
+    return end - begin;
+  }
+  if (end - begin == 1) {
+    return 0;
+  }
+  const size_t mid = begin + (end - begin) / 2;
+  return insertHoldSites(sites,
+                         begin,
+                         mid,
+                         buffer_cell,
+                         setup_margin,
+                         allow_setup_violations)
+         + insertHoldSites(sites,
+                           mid,
+                           end,
+                           buffer_cell,
+                           setup_margin,
+                           allow_setup_violations);
+}
+
 void RepairHold::repairEndHold(Vertex* end_vertex,
                                LibertyCell* buffer_cell,
                                const double setup_margin,
@@ -373,126 +560,174 @@ void RepairHold::repairEndHold(Vertex* end_vertex,
                delayAsString(end_path.slack(sta_), sta_),
                delayAsString(sta_->vertexSlack(end_vertex, max_), sta_));
     PathExpanded expanded(&end_path, sta_);
-    sta::SearchPredNonLatch2 pred(sta_);
     const int path_length = expanded.size();
     if (path_length > 1) {
       for (int i = expanded.startIndex(); i < path_length; i++) {
         const PathRef* path = expanded.path(i);
         Vertex* path_vertex = path->vertex(sta_);
-        Pin* path_pin = path_vertex->pin();
-        // explicitly force getting the flat net.
-        odb::dbNet* db_path_net
-            = network_->isTopLevelPort(path_pin)
-                  ? db_network_->flatNet(network_->term(path_pin))
-                  : db_network_->flatNet(const_cast<Pin*>(path_pin));
-
-        if (path_vertex->isDriver(network_) && !resizer_->dontTouch(path_pin)
-            && !db_path_net->isConnectedByAbutment()) {
-          PinSeq load_pins;
-          Slacks slacks;
-          mergeInit(slacks);
-          float excluded_cap = 0.0;
-          bool loads_have_out_port = false;
-          VertexOutEdgeIterator edge_iter(path_vertex, graph_);
-          while (edge_iter.hasNext()) {
-            Edge* edge = edge_iter.next();
-            Vertex* fanout = edge->to(graph_);
-            if (pred.searchTo(fanout) && pred.searchThru(edge)) {
-              Slack fanout_hold_slack = sta_->vertexSlack(fanout, min_);
-              Pin* load_pin = fanout->pin();
-              if (fanout_hold_slack < hold_margin) {
-                load_pins.push_back(load_pin);
-                Slacks fanout_slacks;
-                sta_->vertexSlacks(fanout, fanout_slacks);
-                mergeInto(fanout_slacks, slacks);
-                if (network_->direction(load_pin)->isAnyOutput()
-                    && network_->isTopLevelPort(load_pin)) {
-                  loads_have_out_port = true;
-                }
-              } else {
-                LibertyPort* load_port = network_->libertyPort(load_pin);
-                if (load_port) {
-                  excluded_cap += load_port->capacitance();
-                }
-              }
-            }
-          }
-          if (!load_pins.empty()) {
-            debugPrint(logger_,
-                       RSZ,
-                       "repair_hold",
-                       3,
-                       " {} hold_slack={}/{} setup_slack={}/{} fanouts={}",
-                       path_vertex->name(network_),
-                       delayAsString(slacks[rise_index_][min_index_], sta_),
-                       delayAsString(slacks[fall_index_][min_index_], sta_),
-                       delayAsString(slacks[rise_index_][max_index_], sta_),
-                       delayAsString(slacks[fall_index_][max_index_], sta_),
-                       load_pins.size());
-            const DcalcAnalysisPt* dcalc_ap
-                = sta_->cmdCorner()->findDcalcAnalysisPt(max_);
-            float load_cap
-                = graph_delay_calc_->loadCap(end_vertex->pin(), dcalc_ap)
-                  - excluded_cap;
-            ArcDelay buffer_delays[RiseFall::index_count];
-            Slew buffer_slews[RiseFall::index_count];
-            resizer_->bufferDelays(
-                buffer_cell, load_cap, dcalc_ap, buffer_delays, buffer_slews);
-            // setup_slack > -hold_slack
-            if (allow_setup_violations
-                || (slacks[rise_index_][max_index_] - setup_margin
-                        > -(slacks[rise_index_][min_index_] - hold_margin)
-                    && slacks[fall_index_][max_index_] - setup_margin
-                           > -(slacks[fall_index_][min_index_] - hold_margin)
-                    // enough slack to insert the buffer
-                    // setup_slack > buffer_delay
-                    && (slacks[rise_index_][max_index_] - setup_margin)
-                           > buffer_delays[rise_index_]
-                    && (slacks[fall_index_][max_index_] - setup_margin)
-                           > buffer_delays[fall_index_])) {
-              Vertex* path_load = expanded.path(i + 1)->vertex(sta_);
-              Point path_load_loc = db_network_->location(path_load->pin());
-              Point drvr_loc = db_network_->location(path_vertex->pin());
-              Point buffer_loc((drvr_loc.x() + path_load_loc.x()) / 2,
-                               (drvr_loc.y() + path_load_loc.y()) / 2);
-              // Despite checking for setup slack to insert the bufffer,
-              // increased slews downstream can increase delays and
-              // reduce setup slack in ways that are too expensive to
-              // predict. Use the journal to back out the change if
-              // the hold buffer blows through the setup margin.
-              resizer_->incrementalParasiticsEnd();
-              resizer_->journalBegin();
-              Slack setup_slack_before = sta_->worstSlack(max_);
-              Slew slew_before = sta_->vertexSlew(path_vertex, max_);
-              makeHoldDelay(path_vertex,
-                            load_pins,
-                            loads_have_out_port,
-                            buffer_cell,
-                            buffer_loc);
-              Slew slew_after = sta_->vertexSlew(path_vertex, max_);
-              Slack setup_slack_after = sta_->worstSlack(max_);
-              float slew_factor
-                  = (slew_before > 0) ? slew_after / slew_before : 1.0;
-
-              if (slew_factor > 1.20
-                  || (!allow_setup_violations
-                      && fuzzyLess(setup_slack_after, setup_slack_before)
-                      && setup_slack_after < setup_margin)) {
-                resizer_->journalRestore(resize_count_,
-                                         inserted_buffer_count_,
-                                         cloned_gate_count_,
-                                         swap_pin_count_,
-                                         removed_buffer_count_);
-              } else {
-                resizer_->journalEnd();
-              }
-              resizer_->incrementalParasiticsBegin();
-            }
+        PinSeq load_pins;
+        Slacks slacks;
+        float excluded_cap;
+        bool loads_have_out_port;
+        if (findHoldLoads(path_vertex,
+                          hold_margin,
+                          load_pins,
+                          slacks,
+                          excluded_cap,
+                          loads_have_out_port)
+            && holdBufferFits(end_vertex,
+                              buffer_cell,
+                              slacks,
+                              excluded_cap,
+                              setup_margin,
+                              hold_margin,
+                              allow_setup_violations)) {
+          Point buffer_loc = holdBufferLoc(expanded, i);
+          // Despite checking for setup slack to insert the bufffer,
+          // increased slews downstream can increase delays and
+          // reduce setup slack in ways that are too expensive to
+          // predict. Use the journal to back out the change if
+          // the hold buffer blows through the setup margin.
+          resizer_->incrementalParasiticsEnd();
+          resizer_->journalBegin();
+          Slack setup_slack_before = sta_->worstSlack(max_);
+          Slew slew_before = sta_->vertexSlew(path_vertex, max_);
+          makeHoldDelay(path_vertex,
+                        load_pins,
+                        loads_have_out_port,
+                        buffer_cell,
+                        buffer_loc);
+          Slew slew_after = sta_->vertexSlew(path_vertex, max_);
+          Slack setup_slack_after = sta_->worstSlack(max_);
+          float slew_factor
+              = (slew_before > 0) ? slew_after / slew_before : 1.0;
+
+          if (slew_factor > 1.20
+              || (!allow_setup_violations
+                  && fuzzyLess(setup_slack_after, setup_slack_before)
+                  && setup_slack_after < setup_margin)) {
+            resizer_->journalRestore(resize_count_,
+                                     inserted_buffer_count_,
+                                     cloned_gate_count_,
+                                     swap_pin_count_,
+                                     removed_buffer_count_);
+          } else {
+            resizer_->journalEnd();
           }
+          resizer_->incrementalParasiticsBegin();
+        }
+      }
+    }
+  }
+}
+
+// Find the fanouts of drvr that fail hold and can be moved behind a hold
+// buffer. Returns false if drvr cannot be buffered.
+bool RepairHold::findHoldLoads(Vertex* drvr,
+                               const double hold_margin,
+                               // Return values.
+                               PinSeq& load_pins,
+                               Slacks& slacks,
+                               float& excluded_cap,
+                               bool& loads_have_out_port)
+{
+  mergeInit(slacks);
+  excluded_cap = 0.0;
+  loads_have_out_port = false;
+
+  Pin* drvr_pin = drvr->pin();
+  // explicitly force getting the flat net.
+  odb::dbNet* db_drvr_net
+      = network_->isTopLevelPort(drvr_pin)
+            ? db_network_->flatNet(network_->term(drvr_pin))
+            : db_network_->flatNet(const_cast<Pin*>(drvr_pin));
+  if (!drvr->isDriver(network_) || resizer_->dontTouch(drvr_pin)
+      || db_drvr_net->isConnectedByAbutment()) {
+    return false;
+  }
+
+  sta::SearchPredNonLatch2 pred(sta_);
+  VertexOutEdgeIterator edge_iter(drvr, graph_);
+  while (edge_iter.hasNext()) {
+    Edge* edge = edge_iter.next();
+    Vertex* fanout = edge->to(graph_);
+    if (pred.searchTo(fanout) && pred.searchThru(edge)) {
+      Slack fanout_hold_slack = sta_->vertexSlack(fanout, min_);
+      Pin* load_pin = fanout->pin();
+      if (fanout_hold_slack < hold_margin) {
+        load_pins.push_back(load_pin);
+        Slacks fanout_slacks;
+        sta_->vertexSlacks(fanout, fanout_slacks);
+        mergeInto(fanout_slacks, slacks);
+        if (network_->direction(load_pin)->isAnyOutput()
+            && network_->isTopLevelPort(load_pin)) {
+          loads_have_out_port = true;
+        }
+      } else {
+        LibertyPort* load_port = network_->libertyPort(load_pin);
+        if (load_port) {
+          excluded_cap += load_port->capacitance();
         }
       }
     }
   }
+  if (!load_pins.empty()) {
+    debugPrint(logger_,
+               RSZ,
+               "repair_hold",
+               3,
+               " {} hold_slack={}/{} setup_slack={}/{} fanouts={}",
+               drvr->name(network_),
+               delayAsString(slacks[rise_index_][min_index_], sta_),
+               delayAsString(slacks[fall_index_][min_index_], sta_),
+               delayAsString(slacks[rise_index_][max_index_], sta_),
+               delayAsString(slacks[fall_index_][max_index_], sta_),
+               load_pins.size());
+  }
+  return !load_pins.empty();
+}
+
+// Check that the loads have enough setup slack to absorb a hold buffer.
+bool RepairHold::holdBufferFits(Vertex* end_vertex,
+                                LibertyCell* buffer_cell,
+                                const Slacks& slacks,
+                                const float excluded_cap,
+                                const double setup_margin,
+                                const double hold_margin,
+                                const bool allow_setup_violations)
+{
+  const DcalcAnalysisPt* dcalc_ap
+      = sta_->cmdCorner()->findDcalcAnalysisPt(max_);
+  float load_cap
+      = graph_delay_calc_->loadCap(end_vertex->pin(), dcalc_ap) - excluded_cap;
+  ArcDelay buffer_delays[RiseFall::index_count];
+  Slew buffer_slews[RiseFall::index_count];
+  resizer_->bufferDelays(
+      buffer_cell, load_cap, dcalc_ap, buffer_delays, buffer_slews);
+  // setup_slack > -hold_slack
+  return allow_setup_violations
+         || (slacks[rise_index_][max_index_] - setup_margin
+                 > -(slacks[rise_index_][min_index_] - hold_margin)
+             && slacks[fall_index_][max_index_] - setup_margin
+                    > -(slacks[fall_index_][min_index_] - hold_margin)
+             // enough slack to insert the buffer
+             // setup_slack > buffer_delay
+             && (slacks[rise_index_][max_index_] - setup_margin)
+                    > buffer_delays[rise_index_]
+             && (slacks[fall_index_][max_index_] - setup_margin)
+                    > buffer_delays[fall_index_]);
+}
+
+// Midway between the driver and the next pin on the path.
+Point RepairHold::holdBufferLoc(const PathExpanded& expanded,
+                                const int path_index)
+{
+  Vertex* path_vertex = expanded.path(path_index)->vertex(sta_);
+  Vertex* path_load = expanded.path(path_index + 1)->vertex(sta_);
+  Point path_load_loc = db_network_->location(path_load->pin());
+  Point drvr_loc = db_network_->location(path_vertex->pin());
+  return Point((drvr_loc.x() + path_load_loc.x()) / 2,
+               (drvr_loc.y() + path_load_loc.y()) / 2);
 }
 
 void RepairHold::mergeInit(Slacks& slacks)
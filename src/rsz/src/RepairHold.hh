@@ -5,6 +5,7 @@
 
 #include "db_sta/dbSta.hh"
 #include "sta/MinMax.hh"
+#include "sta/PathExpanded.hh"
 #include "sta/StaState.hh"
 #include "utl/Logger.h"
 
@@ -21,6 +22,7 @@ using sta::dbSta;
 using sta::Delay;
 using sta::LibertyCell;
 using sta::MinMax;
+using sta::PathExpanded;
 using sta::Pin;
 using sta::PinSeq;
 using sta::RiseFall;
@@ -41,6 +43,7 @@ class RepairHold : public sta::dbStaState
                   // Max buffer count as percent of design instance count.
                   float max_buffer_percent,
                   int max_passes,
+                  bool batch,
                   bool verbose);
   void repairHold(const Pin* end_pin,
                   double setup_margin,
@@ -78,11 +81,46 @@ class RepairHold : public sta::dbStaState
                       int max_buffer_count,
                       bool verbose,
                       int& pass);
+  // Hold buffer planned by the batched repair.
+  struct HoldBufferSite
+  {
+    Vertex* drvr;
+    PinSeq load_pins;
+    bool loads_have_out_port;
+    Point loc;
+  };
+  bool repairHoldBatch(VertexSeq& hold_failures,
+                       LibertyCell* buffer_cell,
+                       double setup_margin,
+                       double hold_margin,
+                       bool allow_setup_violations,
+                       int max_buffer_count);
+  int insertHoldSites(std::vector<HoldBufferSite>& sites,
+                      size_t begin,
+                      size_t end,
+                      LibertyCell* buffer_cell,
+                      double setup_margin,
+                      bool allow_setup_violations);
   void repairEndHold(Vertex* end_vertex,
                      LibertyCell* buffer_cell,
                      double setup_margin,
                      double hold_margin,
                      bool allow_setup_violations);
+  bool findHoldLoads(Vertex* drvr,
+                     double hold_margin,
+                     // Return values.
+                     PinSeq& load_pins,
+                     Slacks& slacks,
+                     float& excluded_cap,
+                     bool& loads_have_out_port);
+  bool holdBufferFits(Vertex* end_vertex,
+                      LibertyCell* buffer_cell,
+                      const Slacks& slacks,
+                      float excluded_cap,
+                      double setup_margin,
+                      double hold_margin,
+                      bool allow_setup_violations);
+  Point holdBufferLoc(const PathExpanded& expanded, int path_index);
   void makeHoldDelay(Vertex* drvr,
                      PinSeq& load_pins,
                      bool loads_have_out_port,
@@ -104,6 +142,8 @@ class RepairHold : public sta::dbStaState
   int swap_pin_count_ = 0;
   int removed_buffer_count_ = 0;
   double initial_design_area_ = 0;
+  // Insert the hold buffers for all failing endpoints of a pass together.
+  bool batch_ = false;
   const MinMax* min_ = MinMax::min();
   const MinMax* max_ = MinMax::max();
   const int min_index_ = MinMax::minIndex();
@@ -18,6 +18,8 @@
 
 #include "AbstractSteinerRenderer.h"
 #include "BufferedNet.hh"
+#include "LagrangianSizer.hh"
+#include "LibraryCache.hh"
 #include "RecoverPower.hh"
 #include "RepairDesign.hh"
 #include "RepairHold.hh"
@@ -113,7 +115,9 @@ using sta::LeakagePower;
 using sta::LeakagePowerSeq;
 
 Resizer::Resizer()
-    : recover_power_(new RecoverPower(this)),
+    : lagrangian_sizer_(new LagrangianSizer(this)),
+      library_cache_(new LibraryCache(this)),
+      recover_power_(new RecoverPower(this)),
       repair_design_(new RepairDesign(this)),
       repair_setup_(new RepairSetup(this)),
       repair_hold_(new RepairHold(this)),
@@ -127,6 +131,8 @@ Resizer::Resizer()
 
 Resizer::~Resizer()
 {
+  delete lagrangian_sizer_;
+  delete library_cache_;
   delete recover_power_;
   delete repair_design_;
   delete repair_setup_;
@@ -1539,8 +1545,16 @@ void Resizer::resizePreamble()
   makeEquivCells();
   checkLibertyForAllCorners();
   findBuffers();
-  findTargetLoads();
-  findFastBuffers();
+  if (target_load_map_ == nullptr && library_cache_->enabled()) {
+    if (!library_cache_->read()) {
+      findTargetLoads();
+      findFastBuffers();
+      library_cache_->write();
+    }
+  } else {
+    findTargetLoads();
+    findFastBuffers();
+  }
 }
 
 // Convert static cell leakage to std::optional.
@@ -2642,6 +2656,16 @@ void Resizer::reportDontUse() const
   }
 }
 
+void Resizer::setLibraryCacheFile(const std::string& filename)
+{
+  library_cache_->setFilename(filename);
+  // The next repair command reads the tables from the cache or rebuilds
+  // and saves them.
+  delete target_load_map_;
+  target_load_map_ = nullptr;
+  buffer_fast_sizes_.clear();
+}
+
 void Resizer::setDontTouch(const Instance* inst, bool dont_touch)
 {
   dbInst* db_inst = db_network_->staToDb(inst);
@@ -3911,6 +3935,7 @@ void Resizer::repairDesign(double max_wire_length,
                            double cap_margin,
                            double buffer_gain,
                            bool match_cell_footprint,
+                           bool pre_screen,
                            bool verbose)
 {
   utl::SetAndRestore set_match_footprint(match_cell_footprint_,
@@ -3920,8 +3945,12 @@ void Resizer::repairDesign(double max_wire_length,
       || parasitics_src_ == ParasiticsSrc::detailed_routing) {
     opendp_->initMacrosAndGrid();
   }
-  repair_design_->repairDesign(
-      max_wire_length, slew_margin, cap_margin, buffer_gain, verbose);
+  repair_design_->repairDesign(max_wire_length,
+                               slew_margin,
+                               cap_margin,
+                               buffer_gain,
+                               pre_screen,
+                               verbose);
 }
 
 int Resizer::repairDesignBufferCount() const
@@ -4115,6 +4144,7 @@ bool Resizer::repairHold(
     float max_buffer_percent,
     int max_passes,
     bool match_cell_footprint,
+    bool batch,
     bool verbose)
 {
   utl::SetAndRestore set_match_footprint(match_cell_footprint_,
@@ -4138,6 +4168,7 @@ bool Resizer::repairHold(
                                   allow_setup_violations,
                                   max_buffer_percent,
                                   max_passes,
+                                  batch,
                                   verbose);
 }
 
@@ -4169,6 +4200,8 @@ int Resizer::holdBufferCount() const
 ////////////////////////////////////////////////////////////////
 bool Resizer::recoverPower(float recover_power_percent,
                            bool match_cell_footprint,
+                           bool sweep,
+                           int num_threads,
                            bool verbose)
 {
   utl::SetAndRestore set_match_footprint(match_cell_footprint_,
@@ -4178,8 +4211,29 @@ bool Resizer::recoverPower(float recover_power_percent,
       || parasitics_src_ == ParasiticsSrc::detailed_routing) {
     opendp_->initMacrosAndGrid();
   }
+  if (sweep) {
+    return recover_power_->recoverPowerSweep(
+        recover_power_percent, num_threads, verbose);
+  }
   return recover_power_->recoverPower(recover_power_percent, verbose);
 }
+
+////////////////////////////////////////////////////////////////
+
+bool Resizer::sizeGates(int max_passes,
+                        bool match_cell_footprint,
+                        int num_threads,
+                        bool verbose)
+{
+  utl::SetAndRestore set_match_footprint(match_cell_footprint_,
+                                         match_cell_footprint);
+  resizePreamble();
+  if (parasitics_src_ == ParasiticsSrc::global_routing
+      || parasitics_src_ == ParasiticsSrc::detailed_routing) {
+    opendp_->initMacrosAndGrid();
+  }
+  return lagrangian_sizer_->sizeGates(max_passes, num_threads, verbose);
+}
 ////////////////////////////////////////////////////////////////
 // Journal to roll back changes
 void Resizer::journalBegin()
@@ -352,6 +352,13 @@ report_dont_use()
   resizer->reportDontUse();
 }
 
+void
+set_library_cache_file_cmd(const char *filename)
+{
+  Resizer *resizer = getResizer();
+  resizer->setLibraryCacheFile(filename);
+}
+
 void
 report_dont_touch()
 {
@@ -457,6 +464,7 @@ repair_design_cmd(double max_length,
                   double cap_margin,
                   double buffer_gain,
                   bool match_cell_footprint,
+                  bool pre_screen,
                   bool verbose)
 {
   ensureLinked();
@@ -466,6 +474,7 @@ repair_design_cmd(double max_length,
                         cap_margin,
                         buffer_gain,
                         match_cell_footprint,
+                        pre_screen,
                         verbose);
 }
 
@@ -549,6 +558,7 @@ repair_hold(double setup_margin,
             float max_buffer_percent,
             int max_passes,
             bool match_cell_footprint,
+            bool batch,
             bool verbose)
 {
   ensureLinked();
@@ -556,7 +566,7 @@ repair_hold(double setup_margin,
   return resizer->repairHold(setup_margin, hold_margin,
                       allow_setup_violations,
                       max_buffer_percent, max_passes,
-                      match_cell_footprint, verbose);
+                      match_cell_footprint, batch, verbose);
 }
 
 void
@@ -583,11 +593,25 @@ hold_buffer_count()
 
 ////////////////////////////////////////////////////////////////
 bool
-recover_power(float recover_power_percent, bool match_cell_footprint, bool verbose)
+recover_power(float recover_power_percent, bool match_cell_footprint,
+              bool sweep, bool verbose)
+{
+  ensureLinked();
+  Resizer *resizer = getResizer();
+  const int num_threads = ord::OpenRoad::openRoad()->getThreadCount();
+  return resizer->recoverPower(recover_power_percent, match_cell_footprint,
+                               sweep, num_threads, verbose);
+}
+
+////////////////////////////////////////////////////////////////
+bool
+size_gates(int max_passes, bool match_cell_footprint, bool verbose)
 {
   ensureLinked();
   Resizer *resizer = getResizer();
-  return resizer->recoverPower(recover_power_percent, match_cell_footprint, verbose);
+  const int num_threads = ord::OpenRoad::openRoad()->getThreadCount();
+  return resizer->sizeGates(max_passes, match_cell_footprint,
+                            num_threads, verbose);
 }
 
 ////////////////////////////////////////////////////////////////
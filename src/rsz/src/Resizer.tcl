@@ -370,6 +370,15 @@ proc report_dont_use { args } {
   rsz::report_dont_use
 }
 
+sta::define_cmd_args "set_library_cache_file" {filename}
+
+proc set_library_cache_file { args } {
+  sta::parse_key_args "set_library_cache_file" args keys {} flags {}
+  sta::check_argc_eq1 "set_library_cache_file" $args
+
+  rsz::set_library_cache_file_cmd [file normalize [lindex $args 0]]
+}
+
 sta::define_cmd_args "report_dont_touch" {}
 
 proc report_dont_touch { args } {
@@ -426,12 +435,13 @@ sta::define_cmd_args "repair_design" {[-max_wire_length max_wire_length] \
                                       [-cap_margin cap_margin] \
                                       [-buffer_gain gain] \
                                       [-match_cell_footprint] \
+                                      [-pre_screen] \
                                       [-verbose]}
 
 proc repair_design { args } {
   sta::parse_key_args "repair_design" args \
     keys {-max_wire_length -max_utilization -slew_margin -cap_margin -buffer_gain} \
-    flags {-match_cell_footprint -verbose}
+    flags {-match_cell_footprint -pre_screen -verbose}
 
   set max_wire_length [rsz::parse_max_wire_length keys]
   set slew_margin [rsz::parse_percent_margin_arg "-slew_margin" keys]
@@ -447,9 +457,10 @@ proc repair_design { args } {
   rsz::check_parasitics
   set max_wire_length [rsz::check_max_wire_length $max_wire_length]
   set match_cell_footprint [info exists flags(-match_cell_footprint)]
+  set pre_screen [info exists flags(-pre_screen)]
   set verbose [info exists flags(-verbose)]
   rsz::repair_design_cmd $max_wire_length $slew_margin $cap_margin \
-    $buffer_gain $match_cell_footprint $verbose
+    $buffer_gain $match_cell_footprint $pre_screen $verbose
 }
 
 sta::define_cmd_args "repair_clock_nets" {[-max_wire_length max_wire_length]}
@@ -512,11 +523,13 @@ proc repair_tie_fanout { args } {
 # in define_cmd_args
 sta::define_cmd_args "repair_timing" {[-setup] [-hold]\
                                         [-recover_power percent_of_paths_with_slack]\
+                                        [-power_sweep]\
                                         [-setup_margin setup_margin]\
                                         [-hold_margin hold_margin]\
                                         [-slack_margin slack_margin]\
                                         [-libraries libs]\
                                         [-allow_setup_violations]\
+                                        [-batch_hold]\
                                         [-skip_pin_swap]\
                                         [-skip_gate_cloning]\
                                         [-skip_buffering]\
@@ -535,9 +548,9 @@ proc repair_timing { args } {
     keys {-setup_margin -hold_margin -slack_margin \
             -libraries -max_utilization -max_buffer_percent \
             -recover_power -repair_tns -max_passes -max_repairs_per_pass} \
-    flags {-setup -hold -allow_setup_violations -skip_pin_swap -skip_gate_cloning \
-           -skip_buffering -skip_buffer_removal -skip_last_gasp -match_cell_footprint \
-           -verbose}
+    flags {-setup -hold -allow_setup_violations -batch_hold -power_sweep -skip_pin_swap \
+           -skip_gate_cloning -skip_buffering -skip_buffer_removal -skip_last_gasp \
+           -match_cell_footprint -verbose}
 
   set setup [info exists flags(-setup)]
   set hold [info exists flags(-hold)]
@@ -562,6 +575,7 @@ proc repair_timing { args } {
   }
 
   set allow_setup_violations [info exists flags(-allow_setup_violations)]
+  set batch_hold [info exists flags(-batch_hold)]
   set skip_pin_swap [info exists flags(-skip_pin_swap)]
   set skip_gate_cloning [info exists flags(-skip_gate_cloning)]
   set skip_buffering [info exists flags(-skip_buffering)]
@@ -589,6 +603,7 @@ proc repair_timing { args } {
     sta::check_percent "-recover_power" $recover_power_percent
     set recover_power_percent [expr $recover_power_percent / 100.0]
   }
+  set power_sweep [info exists flags(-power_sweep)]
 
   set verbose 0
   if { [info exists flags(-verbose)] } {
@@ -617,7 +632,8 @@ proc repair_timing { args } {
   set repaired_setup 0
   set repaired_hold 0
   if { $recover_power_percent >= 0 } {
-    set recovered_power [rsz::recover_power $recover_power_percent $match_cell_footprint $verbose]
+    set recovered_power [rsz::recover_power $recover_power_percent $match_cell_footprint \
+      $power_sweep $verbose]
   } else {
     if { $setup } {
       set repaired_setup [rsz::repair_setup $setup_margin $repair_tns_end_percent $max_passes \
@@ -628,7 +644,7 @@ proc repair_timing { args } {
     if { $hold } {
       set repaired_hold [rsz::repair_hold $setup_margin $hold_margin \
         $allow_setup_violations $max_buffer_percent $max_passes \
-        $match_cell_footprint $verbose]
+        $match_cell_footprint $batch_hold $verbose]
     }
   }
 
@@ -637,6 +653,31 @@ proc repair_timing { args } {
 
 ################################################################
 
+sta::define_cmd_args "size_gates" {[-max_passes passes]\
+                                     [-match_cell_footprint]\
+                                     [-verbose]}
+
+proc size_gates { args } {
+  sta::parse_key_args "size_gates" args \
+    keys {-max_passes} \
+    flags {-match_cell_footprint -verbose}
+
+  set max_passes 20
+  if { [info exists keys(-max_passes)] } {
+    set max_passes $keys(-max_passes)
+    sta::check_positive_integer "-max_passes" $max_passes
+  }
+  set match_cell_footprint [info exists flags(-match_cell_footprint)]
+  set verbose [info exists flags(-verbose)]
+
+  sta::check_argc_eq0 "size_gates" $args
+  rsz::check_parasitics
+
+  return [rsz::size_gates $max_passes $match_cell_footprint $verbose]
+}
+
+################################################################
+
 sta::define_cmd_args "report_design_area" {}
 
 proc report_design_area { args } {
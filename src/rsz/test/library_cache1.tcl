@@ -0,0 +1,35 @@
+# set_library_cache_file hit and invalidation
+source "helpers.tcl"
+source "hi_fanout.tcl"
+
+set def_filename [make_result_file "library_cache1.def"]
+write_hi_fanout_def $def_filename 35
+
+read_liberty Nangate45/Nangate45_typ.lib
+read_lef Nangate45/Nangate45.lef
+read_def $def_filename
+create_clock -period 10 clk1
+
+source Nangate45/Nangate45.rc
+set_wire_rc -layer metal1
+estimate_parasitics -placement
+
+set cache_file [make_result_file "library_cache1.cache"]
+file delete -force $cache_file
+
+# Setting the cache file makes the next repair command use it.
+proc repair_with_cache { } {
+  global cache_file
+  set_library_cache_file $cache_file
+  tee -quiet -variable log { repair_design }
+  puts "cache hit: [regexp {RSZ-0154} $log]"
+}
+
+# No cache file yet.
+repair_with_cache
+puts "cache written: [file exists $cache_file]"
+repair_with_cache
+# The dont use cells are part of the key.
+set_dont_use BUF_X1
+repair_with_cache
+repair_with_cache
@@ -0,0 +1,36 @@
+# set_library_cache_file with corner libraries that share a name
+source "helpers.tcl"
+source "hi_fanout.tcl"
+
+set def_filename [make_result_file "library_cache2.def"]
+write_hi_fanout_def $def_filename 35
+
+define_corners fast slow
+read_liberty -corner fast Nangate45/Nangate45_fast.lib
+read_liberty -corner slow Nangate45/Nangate45_slow.lib
+read_lef Nangate45/Nangate45.lef
+read_def $def_filename
+create_clock -period 10 clk1
+
+source Nangate45/Nangate45.rc
+set_wire_rc -layer metal1
+estimate_parasitics -placement
+
+set cache_file [make_result_file "library_cache2.cache"]
+file delete -force $cache_file
+
+proc repair_with_cache { } {
+  global cache_file
+  set_library_cache_file $cache_file
+  tee -quiet -variable log { repair_design }
+  puts "cache hit: [regexp {RSZ-0154} $log]"
+}
+
+repair_with_cache
+# The target loads are found at the slow corner, whose cells are stored
+# with the index of their library.
+set stream [open $cache_file r]
+set cache [read $stream]
+close $stream
+puts "slow corner cells: [regexp -line {^1 \S+ \S+$} $cache]"
+repair_with_cache
@@ -0,0 +1,23 @@
+# repair_timing -recover_power 100 -power_sweep
+source "helpers.tcl"
+define_corners fast slow
+read_liberty -corner slow Nangate45/Nangate45_slow.lib
+read_liberty -corner fast Nangate45/Nangate45_fast.lib
+read_lef Nangate45/Nangate45.lef
+read_def recover_power1.def
+create_clock -period 2.0 clk
+
+source Nangate45/Nangate45.rc
+set_wire_rc -layer metal3
+estimate_parasitics -placement
+
+set_thread_count 4
+set area_before [rsz::design_area]
+write_verilog_for_eqy recover_power_sweep before "None"
+# The progress log depends on the commit order of the batches.
+set log_file [make_result_file recover_power_sweep.log]
+tee -quiet -file $log_file {repair_timing -recover_power 100 -power_sweep}
+run_equivalence_test recover_power_sweep ./Nangate45/work_around_yosys/ "None"
+
+puts "area recovered: [expr { [rsz::design_area] < $area_before }]"
+puts "setup met: [expr { [sta::worst_slack -max] >= 0 }]"
@@ -0,0 +1,25 @@
+# repair_timing -recover_power 100 -power_sweep commits several downsizes
+# in one pass
+source "helpers.tcl"
+define_corners fast slow
+read_liberty -corner slow Nangate45/Nangate45_slow.lib
+read_liberty -corner fast Nangate45/Nangate45_fast.lib
+read_lef Nangate45/Nangate45.lef
+read_def recover_power_sweep2.def
+create_clock -period 2.0 clk
+
+source Nangate45/Nangate45.rc
+set_wire_rc -layer metal3
+estimate_parasitics -placement
+
+set_debug_level RSZ recover_power 1
+tee -quiet -variable log {repair_timing -recover_power 100 -power_sweep}
+set_debug_level RSZ recover_power 0
+
+set max_committed 0
+foreach { match committed } \
+  [regexp -all -inline {sweep pass \d+ [^\n]* committed (\d+)} $log] {
+  set max_committed [expr { max($max_committed, $committed) }]
+}
+puts "several commits per pass: [expr { $max_committed > 1 }]"
+puts "setup met: [expr { [sta::worst_slack -max] >= 0 }]"
@@ -0,0 +1,19 @@
+# repair_design -pre_screen skips the nets that pass the screen
+source "helpers.tcl"
+read_liberty Nangate45/Nangate45_typ.lib
+read_lef Nangate45/Nangate45.lef
+read_def gcd_nangate45_placed.def
+read_sdc gcd_nangate45.sdc
+
+source Nangate45/Nangate45.rc
+set_wire_rc -layer metal3
+estimate_parasitics -placement
+
+tee -quiet -variable log {repair_design -pre_screen -verbose}
+regexp {Pre-screened (\d+) drivers, (\d+) need repair} $log \
+  -> drvr_count candidate_count
+puts "skipped nets: [expr { $candidate_count < $drvr_count }]"
+
+puts "Found [sta::max_slew_violation_count] slew violations"
+puts "Found [sta::max_capacitance_violation_count] cap violations"
+puts "Found [sta::max_fanout_violation_count] fanout violations"
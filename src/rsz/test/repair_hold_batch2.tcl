@@ -0,0 +1,21 @@
+# repair_timing -hold -batch_hold keeps the batched hold buffers
+source helpers.tcl
+read_liberty sky130hs/sky130hs_tt.lib
+read_lef sky130hs/sky130hs.tlef
+read_lef sky130hs/sky130hs_std_cell.lef
+read_def repair_hold4.def
+
+create_clock -period 2 clk
+set_propagated_clock clk
+
+source sky130hs/sky130hs.rc
+set_wire_rc -layer met2
+estimate_parasitics -placement
+
+set_debug_level RSZ repair_hold 1
+tee -quiet -variable log {repair_timing -hold -batch_hold}
+set_debug_level RSZ repair_hold 0
+
+puts "batch committed: [regexp {hold buffers, [1-9][0-9]* committed} $log]"
+puts "hold met: [expr { [sta::worst_slack -min] >= 0 }]"
+puts "setup met: [expr { [sta::worst_slack -max] >= 0 }]"
@@ -0,0 +1,32 @@
+# size_gates resizes gates without worsening worst or total negative slack
+source "helpers.tcl"
+read_liberty Nangate45/Nangate45_typ.lib
+read_lef Nangate45/Nangate45.lef
+read_def gcd_nangate45_placed.def
+create_clock -period 0.3 clk
+
+source Nangate45/Nangate45.rc
+set_wire_rc -layer metal3
+estimate_parasitics -placement
+
+set_thread_count 4
+set wns_before [sta::worst_slack -max]
+set tns_before [sta::total_negative_slack -max]
+write_verilog_for_eqy size_gates1 before "None"
+# The pass log depends on the multiplier steps.
+set_debug_level RSZ lr_sizer 1
+tee -quiet -variable log { size_gates -max_passes 30 }
+set_debug_level RSZ lr_sizer 0
+run_equivalence_test size_gates1 ./Nangate45/work_around_yosys/ "None"
+
+set resized 0
+regexp {RSZ-0159\] Resized (\d+) instances} $log -> resized
+puts "gates resized: [expr { $resized > 0 }]"
+# A pass that improved the worst slack at the cost of total negative
+# slack was undone.
+puts "tns rejected: [regexp {reject pass tns} $log]"
+
+set wns_after [sta::worst_slack -max]
+set tns_after [sta::total_negative_slack -max]
+puts "wns not worse: [expr { $wns_after >= $wns_before - 1e-6 }]"
+puts "tns not worse: [expr { $tns_after >= $tns_before - 1e-6 }]"
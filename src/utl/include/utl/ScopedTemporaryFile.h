@@ -59,11 +59,15 @@ class FileHandler
   FileHandler(const char* filename, bool binary = false);
   ~FileHandler();
   FILE* getFile();
+  // Close and remove the temporary file so a failed write does not
+  // replace filename.
+  void discard();
 
  private:
   std::string filename_;
   std::string tmp_filename_;
   FILE* file_;
+  bool discarded_ = false;
 };
 
 }  // namespace utl
@@ -96,6 +96,9 @@ FileHandler::FileHandler(const char* filename, bool binary)
 
 FileHandler::~FileHandler()
 {
+  if (discarded_) {
+    return;
+  }
   if (file_) {
     // Any unwritten buffered data are flushed to the OS.
     std::fclose(file_);
@@ -109,4 +112,15 @@ FILE* FileHandler::getFile()
   return file_;
 }
 
+void FileHandler::discard()
+{
+  if (file_) {
+    std::fclose(file_);
+    file_ = nullptr;
+  }
+  std::error_code ec;
+  fs::remove(tmp_filename_, ec);
+  discarded_ = true;
+}
+
 }  // namespace utl
@@ -231,6 +231,30 @@ TEST(Utl, file_handler_temp_file_handling)
   std::filesystem::remove(filename);
 }
 
+TEST(Utl, file_handler_discard)
+{
+  const char* filename = "test_discard_file.txt";
+  std::string tmp_filename = std::string(filename) + ".1";
+  {
+    std::ofstream os(filename);
+    os << "original";
+  }
+
+  {
+    FileHandler fh(filename, true);  // binary mode
+    fputs("truncated", fh.getFile());
+    fh.discard();
+    EXPECT_TRUE(!std::filesystem::exists(tmp_filename));
+  }
+
+  // The original file is left untouched
+  std::ifstream is(filename);
+  std::string contents((std::istreambuf_iterator<char>(is)),
+                       std::istreambuf_iterator<char>());
+  EXPECT_EQ(contents, "original");
+  std::filesystem::remove(filename);
+}
+
 TEST(Utl, file_handler_exception_handling)
 {
   const char* filename = "test_exception_handling_file.txt";
@@ -117,6 +117,82 @@ proc diff_files { file1 file2 {ignore ""}} {
   }
 }
 
+# Total capacitance of each *D_NET of a SPEF file.
+proc spef_net_caps { spef_file } {
+  set caps [dict create]
+  set stream [open $spef_file r]
+  while { [gets $stream line] >= 0 } {
+    if { [regexp {^\*D_NET (\S+) (\S+)} $line -> net cap] } {
+      dict set caps $net $cap
+    }
+  }
+  close $stream
+  return $caps
+}
+
+# Sum of the coupling capacitances in the *CAP section of each *D_NET of
+# a SPEF file. Internal node numbers depend on the extraction order, so
+# the couplings are summed per net rather than matched per node.
+proc spef_net_coupling_caps { spef_file } {
+  set caps [dict create]
+  set stream [open $spef_file r]
+  set net ""
+  set in_cap 0
+  while { [gets $stream line] >= 0 } {
+    if { [regexp {^\*D_NET (\S+)} $line -> net] } {
+      dict set caps $net 0.0
+    } elseif { [regexp {^\*CAP} $line] } {
+      set in_cap 1
+    } elseif { [regexp {^\*(RES|END)} $line] } {
+      set in_cap 0
+    } elseif { $in_cap && [llength $line] == 4 } {
+      dict set caps $net [expr { [dict get $caps $net] + [lindex $line 3] }]
+    }
+  }
+  close $stream
+  return $caps
+}
+
+# Compares two net capacitance dicts, allowing for a relative difference
+# of tolerance.
+proc diff_net_caps { caps1 caps2 tolerance } {
+  if { [dict size $caps1] == 0 } {
+    puts "No nets found."
+    return 1
+  }
+  set diffs [expr { abs([dict size $caps1] - [dict size $caps2]) }]
+  dict for {net cap1} $caps1 {
+    if { ![dict exists $caps2 $net] } {
+      incr diffs
+      continue
+    }
+    set cap2 [dict get $caps2 $net]
+    if { abs($cap1 - $cap2) > $tolerance * max(abs($cap1), abs($cap2)) } {
+      incr diffs
+    }
+  }
+  if { $diffs > 0 } {
+    puts "Differences found in $diffs nets."
+    return 1
+  }
+  puts "No differences found."
+  return 0
+}
+
+# Compares the net capacitances of two SPEF files written from the same
+# block, allowing for a relative difference of tolerance.
+proc diff_spef_caps { file1 file2 { tolerance 1e-4 } } {
+  return [diff_net_caps [spef_net_caps $file1] [spef_net_caps $file2] \
+    $tolerance]
+}
+
+# Compares the per net coupling capacitances of two SPEF files written
+# from the same block.
+proc diff_spef_coupling_caps { file1 file2 { tolerance 1e-4 } } {
+  return [diff_net_caps [spef_net_coupling_caps $file1] \
+    [spef_net_coupling_caps $file2] $tolerance]
+}
+
 proc run_unit_test_and_exit { relative_path } {
   set test_dir [pwd]
   set openroad_dir [file dirname [file dirname [file dirname $test_dir]]]